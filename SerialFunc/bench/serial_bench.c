@@ -0,0 +1,323 @@
+/*
+ *  serial_bench.c
+ *
+ *  SerialFunc の疑似端末ベンチマーク / 回帰テスト
+ *
+ *  Serial_PortOpen_Pty で作成した疑似端末のスレーブ側を Serial_PortOpen_Func で
+ *  オープンし、マスタ側を対向機器スレッドが駆動します。対向機器は受信した
+ *  フレームを、指定の遅延・バースト分割・バイト誤りを加えてそのまま返します。
+ *  SerialFunc の各送信APIについて、以下を表示します。
+ *    bytes/sec, frames/sec, フレーム毎のシステムコール数, トランザクション遅延 p50/p99
+ *
+ *  実機なしで動作するため、リリース間の比較に使用できます。
+ *  誤り注入なしで応答の不一致やタイムアウトがあった場合は終了コード1を返します。
+ *
+ *  usage : serial_bench [-n frames] [-s size] [-l latency_usec] [-j jitter_usec]
+ *                       [-b burst_bytes] [-g burst_gap_usec] [-e error_ppm]
+ *                       [-c coalesce_usec] [-m put|putv|queue|all]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include "serialfunc.h"
+
+#define BENCH_FRAME_MAX		1024	//!< フレームサイズの上限
+#define BENCH_WAIT_MSEC		1000	//!< 応答待ち時間 (msec)
+
+/// ベンチマークの設定
+typedef struct __bench_config__{
+	int iFrames;		//!< 送信フレーム数
+	int iSize;		//!< フレームサイズ (byte)
+	long lLatencyUsec;	//!< 対向機器の応答遅延 (usec)
+	long lJitterUsec;	//!< 応答遅延のゆらぎ (usec)
+	int iBurst;		//!< 応答のバースト長 (byte) 0で分割しない
+	long lGapUsec;		//!< バースト間の間隔 (usec)
+	long lErrorPpm;		//!< バイト誤りの発生率 (ppm)
+	long lCoalesceUsec;	//!< queue時の送信結合の時間窓 (usec)
+}BENCH_CONFIG;
+
+/// 対向機器スレッドの情報
+typedef struct __bench_peer__{
+	int iMaster;		//!< 疑似端末マスタ側の記述子
+	volatile int iStop;	//!< 終了要求
+	unsigned int uiSeed;	//!< 乱数の種
+	unsigned long ulErrors;	//!< 注入したバイト誤りの数
+	BENCH_CONFIG *pConf;
+}BENCH_PEER;
+
+static BENCH_CONFIG g_conf = { 2000, 32, 0, 0, 0, 0, 0, 1000 };
+
+static long _bench_diff_usec( struct timespec *AtStart, struct timespec *AtEnd )
+{
+	return ( AtEnd->tv_sec - AtStart->tv_sec ) * 1000000L +
+		( AtEnd->tv_nsec - AtStart->tv_nsec ) / 1000L;
+}
+
+static void _bench_sleep_usec( long AlUsec )
+{
+	struct timespec ts;
+
+	if( AlUsec <= 0 ) return;
+	ts.tv_sec = AlUsec / 1000000L;
+	ts.tv_nsec = ( AlUsec % 1000000L ) * 1000L;
+	while( nanosleep( &ts, &ts ) < 0 && errno == EINTR );
+}
+
+static int _bench_write_all( int AiFd, unsigned char *AsBuffer, int AiLen )
+{
+	int iPos = 0, iRet;
+
+	while( iPos < AiLen ){
+		iRet = write( AiFd, AsBuffer + iPos, AiLen - iPos );
+		if( iRet < 0 ){
+			if( errno == EINTR || errno == EAGAIN ) continue;
+			return -1;
+		}
+		iPos += iRet;
+	}
+	return iPos;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   対向機器スレッド
+///
+/// \param   *arg  BENCH_PEER
+/// \note    フレームサイズ分受信する毎に、遅延・誤り・バースト分割を加えて返送します。
+//////////////////////////////////////////////////////////////////////////////
+static void *_bench_peer_thread( void *arg )
+{
+	BENCH_PEER *pPeer = (BENCH_PEER *)arg;
+	BENCH_CONFIG *pConf = pPeer->pConf;
+	unsigned char cBuf[BENCH_FRAME_MAX];
+	struct pollfd pfd;
+	int iLen = 0, iRet, iPos, iChunk, i;
+	long lDelay;
+
+	pfd.fd = pPeer->iMaster;
+	pfd.events = POLLIN;
+
+	while( !pPeer->iStop ){
+		if( poll( &pfd, 1, 100 ) <= 0 ) continue;
+		iRet = read( pPeer->iMaster, cBuf + iLen, pConf->iSize - iLen );
+		if( iRet <= 0 ) continue;
+		iLen += iRet;
+		if( iLen < pConf->iSize ) continue;
+		iLen = 0;
+
+		lDelay = pConf->lLatencyUsec;
+		if( pConf->lJitterUsec > 0 ){
+			lDelay += rand_r( &pPeer->uiSeed ) % ( pConf->lJitterUsec + 1 );
+		}
+		_bench_sleep_usec( lDelay );
+
+		if( pConf->lErrorPpm > 0 ){
+			for( i = 0; i < pConf->iSize; i++ ){
+				if( ( rand_r( &pPeer->uiSeed ) % 1000000L ) < pConf->lErrorPpm ){
+					cBuf[i] ^= 0x55;
+					pPeer->ulErrors++;
+				}
+			}
+		}
+
+		for( iPos = 0; iPos < pConf->iSize; iPos += iChunk ){
+			iChunk = pConf->iSize - iPos;
+			if( pConf->iBurst > 0 && iChunk > pConf->iBurst ){
+				iChunk = pConf->iBurst;
+			}
+			if( iPos > 0 ) _bench_sleep_usec( pConf->lGapUsec );
+			if( _bench_write_all( pPeer->iMaster, cBuf + iPos, iChunk ) < 0 ) break;
+		}
+	}
+	return NULL;
+}
+
+static int _bench_cmp_long( const void *a, const void *b )
+{
+	long la = *(const long *)a, lb = *(const long *)b;
+	return ( la > lb ) - ( la < lb );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   1フレームを送信する関数
+///
+/// \return  0 … 成功, -1 … 失敗
+/// \param   AiPort  シリアルポート記述子
+/// \param   *AsMode  送信API ( put / putv / queue )
+/// \param   *AsBuffer  送信フレーム
+/// \param   AiLen  フレームサイズ
+//////////////////////////////////////////////////////////////////////////////
+static int _bench_send( int AiPort, const char *AsMode, unsigned char *AsBuffer, int AiLen )
+{
+	struct iovec iov[3];
+	int iHead = AiLen / 4, iTail = AiLen / 4;
+
+	if( strcmp( AsMode, "putv" ) == 0 ){
+		// ヘッダ,ペイロード,トレーラの3分割で送信
+		iov[0].iov_base = AsBuffer;
+		iov[0].iov_len = iHead;
+		iov[1].iov_base = AsBuffer + iHead;
+		iov[1].iov_len = AiLen - iHead - iTail;
+		iov[2].iov_base = AsBuffer + AiLen - iTail;
+		iov[2].iov_len = iTail;
+		return ( Serial_PutStringV( AiPort, iov, 3 ) == AiLen ) ? 0 : -1;
+	}
+	if( strcmp( AsMode, "queue" ) == 0 ){
+		// 同じく3分割で送信結合バッファに格納 (Serial_GetStringでまとめて送信される)
+		if( Serial_QueueString( AiPort, AsBuffer, iHead ) < 0 ) return -1;
+		if( Serial_QueueString( AiPort, AsBuffer + iHead, AiLen - iHead - iTail ) < 0 ) return -1;
+		if( Serial_QueueString( AiPort, AsBuffer + AiLen - iTail, iTail ) < 0 ) return -1;
+		return 0;
+	}
+	return Serial_PutString( AiPort, AsBuffer, AiLen );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   1つの送信APIについてベンチマークを実行する関数
+///
+/// \return  不一致またはタイムアウトしたフレーム数, -1 … 失敗
+/// \param   *AsMode  送信API ( put / putv / queue )
+//////////////////////////////////////////////////////////////////////////////
+static int _bench_run( const char *AsMode )
+{
+	BENCH_PEER peer;
+	pthread_t thPeer;
+	SERIAL_STATISTICS stat;
+	struct timespec tsStart, tsEnd, tsReq, tsRes;
+	unsigned char cTx[BENCH_FRAME_MAX], cRx[BENCH_FRAME_MAX];
+	char cSlave[64];
+	long *plLatency;
+	long lTotal;
+	int iPort, iFrame, iLen, iRet, iBad = 0, iTimeout = 0, i;
+	double dSec;
+
+	memset( &peer, 0, sizeof(peer) );
+	peer.pConf = &g_conf;
+	peer.uiSeed = 1;
+
+	peer.iMaster = Serial_PortOpen_Pty( cSlave, sizeof(cSlave) );
+	if( peer.iMaster < 0 ) return -1;
+
+	iPort = Serial_PortOpen_Func( cSlave, 115200, 8, 1, 0, BENCH_WAIT_MSEC, 0, 0 );
+	if( iPort < 0 ){
+		close( peer.iMaster );
+		return -1;
+	}
+	if( strcmp( AsMode, "queue" ) == 0 ){
+		Serial_SetCoalesce( iPort, g_conf.lCoalesceUsec );
+	}
+
+	plLatency = malloc( sizeof(long) * g_conf.iFrames );
+	if( plLatency == NULL ){
+		Serial_PortClose( iPort );
+		close( peer.iMaster );
+		return -1;
+	}
+
+	pthread_create( &thPeer, NULL, _bench_peer_thread, &peer );
+	Serial_ResetStatistics( iPort );
+
+	clock_gettime( CLOCK_MONOTONIC, &tsStart );
+	for( iFrame = 0; iFrame < g_conf.iFrames; iFrame++ ){
+		for( i = 0; i < g_conf.iSize; i++ ){
+			cTx[i] = (unsigned char)( iFrame + i );
+		}
+
+		clock_gettime( CLOCK_MONOTONIC, &tsReq );
+		if( _bench_send( iPort, AsMode, cTx, g_conf.iSize ) < 0 ){
+			iBad++;
+			break;
+		}
+		for( iLen = 0; iLen < g_conf.iSize; iLen += iRet ){
+			iRet = Serial_GetString( iPort, cRx + iLen, g_conf.iSize - iLen );
+			if( iRet <= 0 ) break;
+		}
+		clock_gettime( CLOCK_MONOTONIC, &tsRes );
+		plLatency[iFrame] = _bench_diff_usec( &tsReq, &tsRes );
+
+		if( iLen < g_conf.iSize ){
+			// 対向機器との同期が取れなくなるため打ち切る
+			iTimeout++;
+			iFrame++;
+			break;
+		}
+		if( memcmp( cTx, cRx, g_conf.iSize ) != 0 ) iBad++;
+	}
+	clock_gettime( CLOCK_MONOTONIC, &tsEnd );
+
+	Serial_GetStatistics( iPort, &stat, 0 );
+	peer.iStop = 1;
+	pthread_join( thPeer, NULL );
+	Serial_PortClose( iPort );
+	close( peer.iMaster );
+
+	dSec = _bench_diff_usec( &tsStart, &tsEnd ) / 1e6;
+	qsort( plLatency, iFrame, sizeof(long), _bench_cmp_long );
+	lTotal = (long)iFrame * g_conf.iSize * 2;
+
+	printf( "%-6s frames %6d  %10.0f bytes/s  %8.0f frames/s  %5.2f syscalls/frame"
+		"  p50 %6ld us  p99 %6ld us  mismatch %d (injected %lu)  timeout %d\n",
+		AsMode, iFrame,
+		( dSec > 0 ) ? lTotal / dSec : 0.0,
+		( dSec > 0 ) ? iFrame / dSec : 0.0,
+		( iFrame > 0 ) ? (double)( stat.ulWriteCalls + stat.ulReadCalls ) / iFrame : 0.0,
+		( iFrame > 0 ) ? plLatency[iFrame / 2] : 0L,
+		( iFrame > 0 ) ? plLatency[( iFrame * 99 ) / 100] : 0L,
+		iBad, peer.ulErrors, iTimeout );
+
+	free( plLatency );
+
+	return iBad + iTimeout;
+}
+
+int main( int argc, char *argv[] )
+{
+	const char *cMode = "all";
+	const char *cModes[] = { "put", "putv", "queue" };
+	int iOpt, iRet, iFail = 0, i;
+
+	while( ( iOpt = getopt( argc, argv, "n:s:l:j:b:g:e:c:m:" ) ) != -1 ){
+		switch( iOpt ){
+		case 'n': g_conf.iFrames = atoi( optarg ); break;
+		case 's': g_conf.iSize = atoi( optarg ); break;
+		case 'l': g_conf.lLatencyUsec = atol( optarg ); break;
+		case 'j': g_conf.lJitterUsec = atol( optarg ); break;
+		case 'b': g_conf.iBurst = atoi( optarg ); break;
+		case 'g': g_conf.lGapUsec = atol( optarg ); break;
+		case 'e': g_conf.lErrorPpm = atol( optarg ); break;
+		case 'c': g_conf.lCoalesceUsec = atol( optarg ); break;
+		case 'm': cMode = optarg; break;
+		default:
+			fprintf( stderr, "usage : %s [-n frames] [-s size] [-l latency_usec] [-j jitter_usec]"
+				" [-b burst_bytes] [-g burst_gap_usec] [-e error_ppm] [-c coalesce_usec]"
+				" [-m put|putv|queue|all]\n", argv[0] );
+			return 2;
+		}
+	}
+	if( g_conf.iFrames <= 0 || g_conf.iSize < 4 || g_conf.iSize > BENCH_FRAME_MAX ){
+		fprintf( stderr, "frames must be > 0 and size 4..%d\n", BENCH_FRAME_MAX );
+		return 2;
+	}
+
+	printf( "size %d  latency %ld+%ld us  burst %d/%ld us  error %ld ppm\n",
+		g_conf.iSize, g_conf.lLatencyUsec, g_conf.lJitterUsec,
+		g_conf.iBurst, g_conf.lGapUsec, g_conf.lErrorPpm );
+
+	for( i = 0; i < (int)( sizeof(cModes) / sizeof(cModes[0]) ); i++ ){
+		if( strcmp( cMode, "all" ) != 0 && strcmp( cMode, cModes[i] ) != 0 ) continue;
+		iRet = _bench_run( cModes[i] );
+		if( iRet < 0 ){
+			fprintf( stderr, "%s : open failed\n", cModes[i] );
+			return 1;
+		}
+		// 誤り注入時の不一致は期待どおりなので失敗としない
+		if( g_conf.lErrorPpm == 0 && iRet > 0 ) iFail = 1;
+	}
+
+	return iFail;
+}
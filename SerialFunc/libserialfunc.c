@@ -1,521 +1,1424 @@
-/*!
- *  Lib for Serial Port Communication Functions.
- *
- *  Copyright (C) 2015 Syunsuke Okamoto, CONTEC.CO.,Ltd.
- *
-* This library is free software; you can redistribute it and/or
-* modify it under the terms of the GNU Lesser General Public
-* License as published by the Free Software Foundation; either
-* version 2.1 of the License, or (at your option) any later version.
-* 
-* This library is distributed in the hope that it will be useful,
-* but WITHOUT ANY WARRANTY; without even the implied warranty of
-* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
-* Lesser General Public License for more details.
-* 
-* You should have received a copy of the GNU Lesser General Public
-* License along with this library; if not, see
-   <http://www.gnu.org/licenses/>.  */
-
-#include <stdio.h>
-#include <string.h>
-#include <termios.h>
-#include <unistd.h>
-#include <fcntl.h>
-#include <sys/ioctl.h>
-#include <linux/serial.h>
-#include "serialfunc.h"
-
-#define LIB_SERIAL_VERSION	"1.0.7"
-
-static struct termios oldtio; //!< 現在のシリアルポートの設定を格納
-
-/*!
- @~English
- @name DebugPrint macro
- @~Japanese
- @name デバッグ用表示マクロ
-*/
-/// @{
-
-#if 0
-#define DbgPrint(fmt...)	printf(fmt)
-#else
-#define DbgPrint(fmt...)	do { } while (0)
-#endif
-
-/// @}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   シリアルポートを半二重通信でオープンする関数
-///
-/// \return  オープンしたシリアルポートへのポインタ
-/// \param   *AsDev  オープンするシリアルデバイス /dev/ttyS?
-/// \param   AlSpeed      シリアルポートの速度 2400,4800,9600,19200,38400,57600,115200, 460800, 921600
-/// \param   AiLength     シリアルポートのデータ長 7,8
-/// \param   AiStop       シリアルポートのストップビット 0,1,2
-/// \param   AiParity     シリアルポートのパリティ 0(n),1(e),2(o)
-/// \param   AiWait       シリアルポートの受信待ち時間
-/// \param   AiBlockMode   シリアルポートのオープン時のブロッキング(0:無効 1:有効)
-////////////////////////////////////////////////////////////////////////////////
-int Serial_PortOpen_Half( char *AsDev, long AlSpeed, int AiLength, int AiStop, int AiParity , int AiWait, int AiBlockMode)
-{
-	static int iPort;
-
-	iPort = Serial_PortOpen_Func(AsDev, AlSpeed, AiLength, AiStop, AiParity, AiWait, AiBlockMode, 0);
-
-	ioctl( iPort, TIOCSRS485, 1  ); // rs485 enable
-
-	return iPort;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   シリアルポートをオープンする関数
-///
-/// \return  オープンしたシリアルポートへのポインタ
-/// \param   *AsDev  オープンするシリアルデバイス /dev/ttyS?
-/// \param   AlSpeed      シリアルポートの速度 2400,4800,9600,19200,38400,57600,115200,460800,921600
-/// \param   AiLength     シリアルポートのデータ長 7,8
-/// \param   AiStop       シリアルポートのストップビット 0,1,2
-/// \param   AiParity     シリアルポートのパリティ 0(n),1(e),2(o)
-/// \param   AiWait       シリアルポートの受信待ち時間
-/// \param   AiOpenMode   シリアルポートのオープン時のブロッキング(0:無効 1:有効)
-/// \param   AiFlow       シリアルポートのオープン時のフロー制御 ( 0:なし, 1:RTS/CTS, 2:DTR/DSR )
-//////////////////////////////////////////////////////////////////////////////
-int Serial_PortOpen_Func( char *AsDev, long AlSpeed, int AiLength, int AiStop, int AiParity ,int AiWait, int AiOpenMode, int AiFlow ){
-	static struct termios newtio;
-	static int iPort;
-	static int iOpenMode;
-
-	switch( AiOpenMode ){
-		case 0: iOpenMode = O_RDWR | O_NOCTTY ; break;
-		case 1: iOpenMode = O_RDWR | O_NOCTTY | O_NONBLOCK ; break;
-	}
-
-	/* 読み書きの為にモデムデバイスをオープンする。ノイズによってCTRL-Cが
-		たまたま発生しても接続が切れないようにtty制御はしない */
-	iPort = open( AsDev, iOpenMode );
-	if( iPort < 0 ){
-		perror( AsDev );
-		return -1;
-	}
-	// 現在のシリアルポートの設定を保存(Close時に戻す為)
-	tcgetattr( iPort, &oldtio );
-
-	Serial_PortSetParameter(iPort, AlSpeed, AiLength, AiStop, AiParity, AiWait, AiFlow);
-
-	return iPort;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   シリアルポートのパラメータを設定する関数
-///
-/// \param   AiPort       シリアルポートのファイルディスクリプタ
-/// \param   AiSpeed      シリアルポートの速度 2400,4800,9600,19200,38400,57600,115200,460800,921600
-/// \param   AiLength     シリアルポートのデータ長 7,8
-/// \param   AiStop       シリアルポートのストップビット 0,1,2
-/// \param   AiParity     シリアルポートのパリティ 0(n),1(e),2(o)
-/// \param   AiWait       シリアルポートの受信待ち時間
-//////////////////////////////////////////////////////////////////////////////
-void Serial_PortSetParameter(int AiPort, int AiSpeed, int AiLength, int AiStop, int AiParity, int AiWait, int AiFlow)
-{
-	static struct termios newtio;
-
-	// 制御コードの初期化を行う
-	newtio.c_iflag = 0;
-	newtio.c_oflag = 0;
-	newtio.c_cflag = 0;
-	newtio.c_lflag = 0;
-	newtio.c_line = 0;
-	bzero( newtio.c_cc, sizeof(newtio.c_cc) );
-
-	///// c_cflagの設定 /////
-	/* Setting for c_cflag
-		B921600～B2400 : 通信速度
-		CS5～CS8 : データビット長
-		CSTOPB   : ストップビット長=2(付けなければ1)
-		CPARENB  : パリティ有効(このままでは偶数)
-		CPARODD  : パリティを奇数にする
-		CLOCAL   : モデムの制御線を無視する
-		CREAD    : 受信文字を有効にする
-		CRTSCTS  : 出力のハードウェアフロー制御を有効にする
-		HUPCL    : 最後のプロセスがクローズした後、モデムの制御線をLOWにする
-	*/
-	// 通信速度のセット
-	switch( AiSpeed ){
-		case 921600:
-			newtio.c_cflag = B921600;
-			break;
-		case 460800:
-			newtio.c_cflag = B460800;
-			break;
-		case 115200:
-			newtio.c_cflag = B115200;
-			break;
-		case 57600:
-			newtio.c_cflag = B57600;
-			break;
-		case 38400:
-			newtio.c_cflag = B38400;
-			break;
-		case 19200:
-			newtio.c_cflag = B19200;
-			break;
-		case 9600:
-			newtio.c_cflag = B9600;
-			break;
-		case 4800:
-			newtio.c_cflag = B4800;
-			break;
-		case 2400:
-			newtio.c_cflag = B2400;
-			break;
-		default:
-			newtio.c_cflag = B9600; // デフォルトは9600bps
-			break;
-	}
-	// データビット長の設定
-	switch( AiLength ){
-		case 7:
-			// CS7  : データ長を7ビットにする
-			newtio.c_cflag = newtio.c_cflag | CS7 ;
-			break;
-		default:
-			// CS8  : デフォルトではデータ長を8ビットにする
-			newtio.c_cflag = newtio.c_cflag | CS8 ;
-			break;
-	}
-	// ストップビットの設定
-	switch( AiStop ){
-		case 2:
-			// CSTOPB   : ストップビットを2にする
-			newtio.c_cflag = newtio.c_cflag | CSTOPB ; 
-			break;
-		default:
-			// デフォルトでは1
-			newtio.c_cflag = newtio.c_cflag & ~CSTOPB ;
-			break;
-	}
-	// パリティのセット
-	switch( AiParity ){
-		case 1:
-			// PARENB  : パリティを有効にする(標準では偶数)
-			newtio.c_cflag = newtio.c_cflag | PARENB ;
-			break;
-		case 2:
-			// PARENB  : パリティを有効にし奇数をセット
-			newtio.c_cflag = newtio.c_cflag | PARENB | PARODD ;
-			break;
-		default:
-			// NO PARITY
-			break;
-	}
-
-	// Ver 1.0.3 Flow Control Added 
-	// Setting of hardware flow 
-	switch( AiFlow ){
-		case 1:
-			// CRTSCTS  : enables hardware flow
-			newtio.c_cflag = newtio.c_cflag | CRTSCTS;
-			break;
-		case 0:	
-		default:
-			// no hardware flow
-			break;
-	}
-	// Ver 1.0.3 End
-	
-//	newtio.c_cflag = newtio.c_cflag | CLOCAL | CREAD;
-	newtio.c_cflag = newtio.c_cflag | CLOCAL | CREAD;
-
-	///// c_iflagの設定 /////
-//	newtio.c_iflag = IGNPAR; // IGNPAR : パリティエラーのデータは無視
-	newtio.c_iflag = IGNPAR | IGNBRK; // IGNBRK : ブレーク信号は無視
-
-	///// c_oflagの設定 /////
-	newtio.c_oflag = 0;     // 0:Rawモードでの出力
-
-	///// c_lflagの設定 /////
-	newtio.c_lflag = 0;  // Set input mode (non-canonical,no echo,....)
-	/*　ICANON : カノニカル入力を有効にする */
-	newtio.c_cc[VTIME] = AiWait / 100; // 0:キャラクタタイマ ( AiWait(msec) / 100)
-	newtio.c_cc[VMIN] = 0;  // 指定文字来るまで読み込みをブロック(0:しない 1:する)
-
-	///// モデムラインをクリア /////
-	tcflush( AiPort, TCIFLUSH );
-// change start 2004/08/25 tkasuya,contec
-//	// 新しい設定を適用する (TCSANOW：ただちに変更が有効となる)
-//	tcsetattr( AiPort, TCSANOW, &newtio );
-	// 新しい設定を適用する (TCSADRAIN：変更を出力がフラッシュされた後に反映)
-	tcsetattr( AiPort, TCSADRAIN, &newtio );
-// change end
-
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   シリアルポートを閉じる関数
-///
-/// \return  void
-/// \param   AiPort  シリアルポート記述子
-//////////////////////////////////////////////////////////////////////////////
-void Serial_PortClose( int AiPort )
-{
-	// シリアルポートの設定をポートオープン前に戻す
-// change start 2004/08/25 tkasuya,contec
-//	tcsetattr( AiPort, TCSANOW, &oldtio );
-//	ioctl(AiPort, TIOCSRS485, 0); // rs485 enable
-	tcsetattr( AiPort, TCSADRAIN, &oldtio );
-// change end
-	close(AiPort);
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief シリアルポートへ1バイトを書き込む関数
-///
-/// \return  出力結果 0 … 成功, -1 … 失敗
-/// \param   AiPort  シリアルポート記述子
-/// \param   AcChar  出力データ
-//////////////////////////////////////////////////////////////////////////////
-int Serial_PutChar( int AiPort, unsigned char AcChar )
-{
-	if( write( AiPort, &AcChar, 1 ) != 1 ){
-		return -1;
-	}
-	return 0;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   シリアルポートから1文字読み込む関数
-///
-/// \return  受信データ(1バイト)
-/// \param   AiPort     シリアルポート記述子
-//////////////////////////////////////////////////////////////////////////////
-unsigned char Serial_GetChar( int AiPort )
-{
-	static unsigned char cRet = 0xFF;
-	static int iRet;
-
-	iRet = read( AiPort, (char *)&cRet, 1 );
-	return cRet;
-}
-
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   シリアルポートから文字列を読込む関数
-///
-/// \return  読込み完了バイト数
-/// \param   AiPort     シリアルポート記述子
-/// \param   *AsBuffer  読込んだ文字列を格納するバッファへのポインタ
-/// \param   AiLen       一度に読込むバイト数
-//////////////////////////////////////////////////////////////////////////////
-int Serial_GetString( int AiPort, unsigned char *AsBuffer, int AiLen )
-{
-	static int iRet = 0;
-	struct serial_icounter_struct icount;
-
-ioctl( AiPort, TIOCGICOUNT, &icount);
-//printf("rx[%d] tx[%d] Error:frame[%d] overrun[%d] parity[%d] boverrun[%d] \n", icount.rx, icount.tx, icount.frame, icount.overrun, icount.parity, icount.buf_overrun);
-
-	iRet = read( AiPort, (char *)AsBuffer, AiLen );
-
-	return iRet;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   シリアルポートへ多バイトのデータを書き込む関数
-///
-/// \return  出力結果 0 … 成功, -1 … 失敗
-/// \param   AiPort     シリアルポート記述子
-/// \param   *AsBuffer  送信文字列へのポインタ
-/// \param   AiLen      書込みバイト数
-//////////////////////////////////////////////////////////////////////////////
-int Serial_PutString( int AiPort, unsigned char *AsBuffer, int AiLen )
-{
-	//if( write( AiPort, AsBuffer, AiLen ) != 1 ){
-	//	return -1;
-	//}
-	
-	//return 0;
-	DbgPrint("<Serial PutString AsBuf %s , Len : %d \n", AsBuffer, AiLen );
-
-	return write( AiPort, (char *)AsBuffer, AiLen );
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   サムチェックを計算する関数
-///
-/// \return  サムチェック計算値
-/// \param   *AsBuffer    サムチェック対象文字列
-/// \param   AiLen        サムチェック対象文字数
-/// \param   AiComplement サムチェックに2の補数を適用 1…適用,他…非適用
-//////////////////////////////////////////////////////////////////////////////
-int Serial_SumCheck( char *AsBuffer, int AiLen, int AiComplement ){
-	int iRet = 0;
-	int i = 0;
-
-	for( i = 0 ; i < AiLen ; i++ ){
-		iRet = iRet + AsBuffer[i];
-	}
-
-	if( AiComplement == 1 ){
-		iRet ^= 0xff;
-		iRet = iRet + 1;
-	}
-	iRet = iRet % 0x100;
-	return iRet;
-}
-
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   RTSに値をセットする関数
-///
-/// \return  void
-/// \param   AiPort   シリアルポート記述子
-/// \param   AiValue  セット値(0:OFF , 1:ON)
-//////////////////////////////////////////////////////////////////////////////
-void Serial_Set_Rts( int AiPort, int AiValue ){
-        int a;
-        int ioctl_ret;
-
-        ioctl_ret=ioctl( AiPort, TIOCMGET, &a );
-
-        // printf( "ret=(%d) a=[%x]\n", ioctl_ret, a );
-
-        a &= ~TIOCM_RTS;
-        if( AiValue ){
-                a |= TIOCM_RTS;
-        }
-        ioctl( AiPort, TIOCMSET, &a);
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   DTRに値をセットする関数
-///
-/// \return  void
-/// \param   AiPort   シリアルポート記述子
-/// \param   AiValue  セット値(0:OFF , 1:ON)
-//////////////////////////////////////////////////////////////////////////////
-void Serial_Set_Dtr( int AiPort, int AiValue ){
-        int a;
-
-        ioctl( AiPort, TIOCMGET, &a );
-        a &= ~TIOCM_DTR;
-        if( AiValue ){
-                a |= TIOCM_DTR;
-        }
-        ioctl( AiPort, TIOCMSET, &a );
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   LSRの値を取得する関数
-///
-/// \return  void
-/// \param   AiPort   シリアルポート記述子
-/// \param   AiValue  Lsrの値
-//////////////////////////////////////////////////////////////////////////////
-void Serial_Get_Lsr( int AiPort, int *AiValue ){
-	int lsr;
-
-	ioctl( AiPort, TIOCSERGETLSR, &lsr);
-
-	if( lsr & LSR_FE )
-		printf(" Framing Error!\n");
-	if( lsr & LSR_OE )
-		printf(" Rx Overrun Error!\n");
-	if( lsr & LSR_PE )
-		printf(" Parity Error!\n");
-
-	*AiValue = lsr;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   RIの値を取得する関数
-///
-/// \return  int	取得値(0:OFF , 1:ON)
-/// \param   AiPort   シリアルポート記述子
-//////////////////////////////////////////////////////////////////////////////
-int Serial_Get_Ri( int AiPort ){
-
-	int a;
-
-	ioctl( AiPort, TIOCMGET, &a );
-
-	if( a & TIOCM_RI )
-		return 1;
-	else
-		return 0;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   DCDの値を取得する関数
-///
-/// \return  int 取得値(0:OFF , 1:ON)
-/// \param   AiPort   シリアルポート記述子
-//////////////////////////////////////////////////////////////////////////////
-int Serial_Get_Dcd( int AiPort ){
-
-	int a;
-
-	ioctl( AiPort, TIOCMGET, &a );
-
-	if( a & TIOCM_CAR )
-		return 1;
-	else
-		return 0;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   DSRの値を取得する関数
-///
-/// \return  int 取得値(0:OFF , 1:ON)
-/// \param   AiPort   シリアルポート記述子
-//////////////////////////////////////////////////////////////////////////////
-int Serial_Get_Dsr( int AiPort ){
-
-	int a;
-
-	ioctl( AiPort, TIOCMGET, &a );
-
-	if( a & TIOCM_DSR )
-		return 1;
-	else
-		return 0;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   シリアルポートの入力バッファを取得します
-///
-/// \return  void
-/// \param   AiPort   シリアルポート記述子
-/// \param   AiValue  入力バッファの値
-//////////////////////////////////////////////////////////////////////////////
-void Serial_Get_In_Buffer( int AiPort, int *AiValue ){
-
-	ioctl( AiPort, FIONREAD, AiValue);
-
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   シリアルポートの出力バッファを取得します
-///
-/// \return  void
-/// \param   AiPort   シリアルポート記述子
-/// \param   AiValue  出力バッファの値
-//////////////////////////////////////////////////////////////////////////////
-void Serial_Get_Out_Buffer( int AiPort, int *AiValue ){
-
-	ioctl( AiPort, TIOCOUTQ, AiValue);
-
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// \brief   シリアルライブラリのバージョンを取得します
-///
-/// \return  void
-/// \param   libVer   ライブラリのバージョン
-//////////////////////////////////////////////////////////////////////////////
-void Serial_Get_Lib_Version( char *libVer ){
-
-	strcpy(libVer,LIB_SERIAL_VERSION);
-
-}
+/*!
+ *  Lib for Serial Port Communication Functions.
+ *
+ *  Copyright (C) 2015 Syunsuke Okamoto, CONTEC.CO.,Ltd.
+ *
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+* 
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+* 
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, see
+   <http://www.gnu.org/licenses/>.  */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <termios.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sched.h>
+#include <linux/serial.h>
+#include "serialfunc.h"
+
+#define LIB_SERIAL_VERSION	"1.0.7"
+
+#define SERIAL_PORT_MAX	256	//!< ポート毎の情報を保持するファイルディスクリプタの上限
+#define SERIAL_COALESCE_BUFFER_SIZE	1024	//!< 送信結合バッファのサイズ
+#define SERIAL_IOV_MAX	16	//!< 一度のwritevで渡すiovecの最大数
+#define SERIAL_STAT_READ_RETRY	100000	//!< 統計情報のコピーをやり直す回数の上限
+
+#define SERIAL_RS485_MODE_NONE	0	//!< RS485方向制御なし
+#define SERIAL_RS485_MODE_KERNEL	1	//!< ドライバ(TIOCSRS485)による方向制御
+#define SERIAL_RS485_MODE_SOFTWARE	2	//!< ライブラリによるRTS方向制御
+
+/// ポート毎の情報
+typedef struct __serial_port_info__{
+	struct termios oldtio;	//!< オープン前のシリアルポートの設定
+	long lCharUsec;	//!< 1キャラクタの送出時間 (usec)
+	int iWaitMsec;	//!< 受信待ち時間 (msec) ノンブロッキング時の送信待ちにも使用
+	int iRs485Mode;	//!< RS485方向制御モード
+	long lRs485DelayBefore;	//!< 送信前のRTS ON待ち時間 (usec)
+	long lRs485DelayAfter;	//!< 送信後のRTS OFF待ち時間 (usec)
+	SERIAL_STATISTICS stat;	//!< 統計情報 (共有メモリ未使用時)
+	PSERIAL_STATISTICS pStat;	//!< 統計情報の格納先 (statまたは共有メモリ)
+	int iStatLock;	//!< 統計情報の更新ロック (送信スレッドと受信スレッドの排他)
+	char cShmName[64];	//!< 統計情報の共有メモリ名
+	int iAwaitResponse;	//!< 送信後、応答の先頭バイトを待っている
+	struct timespec tsRequest;	//!< 最後の送信完了時刻
+	long lIcountMsec;	//!< TIOCGICOUNTの取得周期 (msec) 0:要求時のみ
+	struct timespec tsIcount;	//!< 最後にTIOCGICOUNTを取得した時刻
+	long lCoalesceUsec;	//!< 送信結合の時間窓 (usec) 0:無効
+	int iCoalesceLen;	//!< 送信結合バッファ中のバイト数
+	struct timespec tsCoalesce;	//!< 送信結合バッファへ最初に格納した時刻
+	unsigned char cCoalesceBuf[SERIAL_COALESCE_BUFFER_SIZE];	//!< 送信結合バッファ
+}SERIAL_PORT_INFO, *PSERIAL_PORT_INFO;
+
+static struct termios oldtio; //!< 現在のシリアルポートの設定を格納
+static PSERIAL_PORT_INFO serial_port_info[SERIAL_PORT_MAX]; //!< ポート毎の情報
+
+/*!
+ @~English
+ @name DebugPrint macro
+ @~Japanese
+ @name デバッグ用表示マクロ
+*/
+/// @{
+
+#if 0
+#define DbgPrint(fmt...)	printf(fmt)
+#else
+#define DbgPrint(fmt...)	do { } while (0)
+#endif
+
+/// @}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   ポート毎の情報を取得する関数
+///
+/// \return  ポート毎の情報 (管理外のポートはNULL)
+/// \param   AiPort  シリアルポート記述子
+//////////////////////////////////////////////////////////////////////////////
+static PSERIAL_PORT_INFO _serial_get_port_info( int AiPort )
+{
+	if( AiPort < 0 || AiPort >= SERIAL_PORT_MAX ){
+		return (PSERIAL_PORT_INFO)NULL;
+	}
+	return serial_port_info[AiPort];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   2つの時刻の差をマイクロ秒で求める関数
+///
+/// \return  経過時間 (usec)
+/// \param   *AtStart  開始時刻
+/// \param   *AtEnd    終了時刻
+//////////////////////////////////////////////////////////////////////////////
+static long _serial_diff_usec( struct timespec *AtStart, struct timespec *AtEnd )
+{
+	return ( AtEnd->tv_sec - AtStart->tv_sec ) * 1000000L +
+		( AtEnd->tv_nsec - AtStart->tv_nsec ) / 1000L;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   統計情報の更新ロックを取得する関数
+///
+/// \param   pInfo   ポート毎の情報
+//////////////////////////////////////////////////////////////////////////////
+static void _serial_stat_lock( PSERIAL_PORT_INFO pInfo )
+{
+	while( __sync_lock_test_and_set( &pInfo->iStatLock, 1 ) ){
+		sched_yield();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   統計情報の更新ロックを解放する関数
+///
+/// \param   pInfo   ポート毎の情報
+//////////////////////////////////////////////////////////////////////////////
+static void _serial_stat_unlock( PSERIAL_PORT_INFO pInfo )
+{
+	__sync_lock_release( &pInfo->iStatLock );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   統計情報の更新を開始する関数
+///
+/// \param   pInfo   ポート毎の情報
+/// \note    ulGenerationを奇数にしてから更新します。読み出し側はulGenerationが
+///          偶数かつコピーの前後で同じ場合のみ、一貫したスナップショットとして扱います。
+//////////////////////////////////////////////////////////////////////////////
+static void _serial_stat_begin( PSERIAL_PORT_INFO pInfo )
+{
+	_serial_stat_lock( pInfo );
+	pInfo->pStat->ulGeneration++;
+	__sync_synchronize();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   統計情報の更新を終了する関数
+///
+/// \param   pInfo   ポート毎の情報
+//////////////////////////////////////////////////////////////////////////////
+static void _serial_stat_end( PSERIAL_PORT_INFO pInfo )
+{
+	__sync_synchronize();
+	pInfo->pStat->ulGeneration++;
+	_serial_stat_unlock( pInfo );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   TIOCGICOUNTでドライバのエラーカウンタを統計情報に取り込む関数
+///
+/// \param   AiPort  シリアルポート記述子
+/// \param   pInfo   ポート毎の情報
+//////////////////////////////////////////////////////////////////////////////
+static void _serial_stat_sample_icount( int AiPort, PSERIAL_PORT_INFO pInfo )
+{
+	struct serial_icounter_struct icount;
+
+	clock_gettime( CLOCK_MONOTONIC, &pInfo->tsIcount );
+
+	if( ioctl( AiPort, TIOCGICOUNT, &icount ) < 0 ) return;
+
+	_serial_stat_begin( pInfo );
+	pInfo->pStat->ulFrameErr = icount.frame;
+	pInfo->pStat->ulOverrunErr = icount.overrun;
+	pInfo->pStat->ulParityErr = icount.parity;
+	pInfo->pStat->ulBreak = icount.brk;
+	pInfo->pStat->ulBufOverrunErr = icount.buf_overrun;
+	_serial_stat_end( pInfo );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   TIOCGICOUNTの取得周期を過ぎていれば取り込む関数
+///
+/// \param   AiPort  シリアルポート記述子
+/// \param   pInfo   ポート毎の情報
+/// \param   *AtNow  現在時刻
+//////////////////////////////////////////////////////////////////////////////
+static void _serial_stat_check_icount( int AiPort, PSERIAL_PORT_INFO pInfo, struct timespec *AtNow )
+{
+	if( pInfo->lIcountMsec > 0 &&
+		_serial_diff_usec( &pInfo->tsIcount, AtNow ) >= pInfo->lIcountMsec * 1000L
+	){
+		_serial_stat_sample_icount( AiPort, pInfo );
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   送信完了を統計情報に記録する関数
+///
+/// \param   AiPort  シリアルポート記述子
+/// \param   pInfo   ポート毎の情報
+/// \param   AiLen   送信バイト数
+//////////////////////////////////////////////////////////////////////////////
+static void _serial_stat_sent( int AiPort, PSERIAL_PORT_INFO pInfo, int AiLen )
+{
+	_serial_stat_begin( pInfo );
+	pInfo->pStat->ulFramesOut++;
+	pInfo->pStat->ulBytesOut += AiLen;
+	_serial_stat_end( pInfo );
+
+	clock_gettime( CLOCK_MONOTONIC, &pInfo->tsRequest );
+	pInfo->iAwaitResponse = 1;
+
+	_serial_stat_check_icount( AiPort, pInfo, &pInfo->tsRequest );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   受信を統計情報に記録する関数
+///
+/// \param   AiPort  シリアルポート記述子
+/// \param   pInfo   ポート毎の情報
+/// \param   AiLen   受信バイト数 (readの戻り値)
+/// \note    送信後最初に受信したデータを応答の先頭とし、送信完了からの時間をヒストグラムに記録します。
+//////////////////////////////////////////////////////////////////////////////
+static void _serial_stat_received( int AiPort, PSERIAL_PORT_INFO pInfo, int AiLen )
+{
+	struct timespec tsNow;
+	long lUsec;
+	int iBucket;
+
+	if( AiLen <= 0 ){
+		_serial_stat_begin( pInfo );
+		pInfo->pStat->ulReadCalls++;
+		_serial_stat_end( pInfo );
+		return;
+	}
+
+	clock_gettime( CLOCK_MONOTONIC, &tsNow );
+
+	_serial_stat_begin( pInfo );
+	pInfo->pStat->ulReadCalls++;
+	pInfo->pStat->ulBytesIn += AiLen;
+
+	if( pInfo->iAwaitResponse ){
+		pInfo->iAwaitResponse = 0;
+		lUsec = _serial_diff_usec( &pInfo->tsRequest, &tsNow );
+
+		// バケット0 : 128usec未満, バケットn : 2^(n+6) 以上 2^(n+7) usec未満
+		for( iBucket = 0; iBucket < SERIAL_STAT_LATENCY_BUCKETS - 1; iBucket++ ){
+			if( lUsec < ( 128L << iBucket ) ) break;
+		}
+		pInfo->pStat->ulLatency[iBucket]++;
+		pInfo->pStat->ulFramesIn++;
+		pInfo->pStat->lLatencyLast = lUsec;
+		if( lUsec > pInfo->pStat->lLatencyMax ){
+			pInfo->pStat->lLatencyMax = lUsec;
+		}
+	}
+	_serial_stat_end( pInfo );
+
+	_serial_stat_check_icount( AiPort, pInfo, &tsNow );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   統計情報を記録しながらシリアルポートから読み込む関数
+///
+/// \return  readの戻り値
+/// \param   AiPort     シリアルポート記述子
+/// \param   *AsBuffer  読込んだ文字列を格納するバッファへのポインタ
+/// \param   AiLen      一度に読込むバイト数
+//////////////////////////////////////////////////////////////////////////////
+static int _serial_read( int AiPort, unsigned char *AsBuffer, int AiLen )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+	int iRet;
+
+	iRet = read( AiPort, (char *)AsBuffer, AiLen );
+
+	if( pInfo != NULL ){
+		_serial_stat_received( AiPort, pInfo, iRet );
+	}
+
+	return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   指定時刻までビジーウェイトする関数
+///
+/// \param   *AtStart  基準時刻
+/// \param   AlUsec    基準時刻からの待ち時間 (usec)
+//////////////////////////////////////////////////////////////////////////////
+static void _serial_busy_wait( struct timespec *AtStart, long AlUsec )
+{
+	struct timespec tsNow;
+
+	if( AlUsec <= 0 ) return;
+
+	do{
+		clock_gettime( CLOCK_MONOTONIC, &tsNow );
+	}while( _serial_diff_usec( AtStart, &tsNow ) < AlUsec );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   iovecの内容を全て書き込むまで繰り返す関数
+///
+/// \return  書き込んだバイト数, -1 … 失敗 (1バイトも書き込めずに送信バッファが一杯の場合はerrno=EAGAIN)
+/// \param   AiPort  シリアルポート記述子
+/// \param   *AsIov  書き込むiovec (書き込み済みの分だけ内容が進められる)
+/// \param   AiCnt   iovecの数
+/// \note    ノンブロッキングで送信バッファが一杯の場合は、ポートの受信待ち時間だけ
+///          空くのを待ち、それでも空かなければ書き込めた分だけを返します(writeと同じ)。
+//////////////////////////////////////////////////////////////////////////////
+static int _serial_writev_all( int AiPort, struct iovec *AsIov, int AiCnt )
+{
+	int iTotal = 0;
+	ssize_t lRet;
+	struct pollfd pfd;
+	int iRet;
+
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+
+	while( AiCnt > 0 ){
+		lRet = writev( AiPort, AsIov, AiCnt );
+		if( pInfo != NULL ){
+			_serial_stat_begin( pInfo );
+			pInfo->pStat->ulWriteCalls++;
+			_serial_stat_end( pInfo );
+		}
+		if( lRet < 0 ){
+			if( errno == EINTR ) continue;
+			if( errno != EAGAIN ) return -1;
+			lRet = 0;
+		}
+		iTotal += lRet;
+
+		// 書き込み済みのiovecを読み飛ばす
+		while( AiCnt > 0 && (size_t)lRet >= AsIov->iov_len ){
+			lRet -= AsIov->iov_len;
+			AsIov++;
+			AiCnt--;
+		}
+		if( AiCnt == 0 ) break;
+
+		if( lRet > 0 ){
+			// 部分書き込み
+			AsIov->iov_base = (char *)AsIov->iov_base + lRet;
+			AsIov->iov_len -= lRet;
+		}else{
+			// ノンブロッキングで送信バッファが一杯の場合は受信待ち時間だけ空くのを待つ
+			pfd.fd = AiPort;
+			pfd.events = POLLOUT;
+			do{
+				iRet = poll( &pfd, 1, ( pInfo != NULL ) ? pInfo->iWaitMsec : 0 );
+			}while( iRet < 0 && errno == EINTR );
+			if( iRet < 0 ) return -1;
+			if( iRet == 0 ){
+				if( iTotal > 0 ) break;
+				errno = EAGAIN;
+				return -1;
+			}
+		}
+	}
+
+	return iTotal;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   RTSで送信方向を切り替えながらiovecを書き込む関数
+///
+/// \return  書き込んだバイト数, -1 … 失敗
+/// \param   AiPort  シリアルポート記述子
+/// \param   pInfo   ポート毎の情報
+/// \param   *AsIov  書き込むiovec
+/// \param   AiCnt   iovecの数
+/// \note    tcdrainの後、UARTのシフトレジスタに残る最後の1キャラクタ分を
+///          ビジーウェイトしてからRTSをOFFにします。
+///          ターンアラウンドはtcdrainの完了からRTS OFFまでの時間です。
+//////////////////////////////////////////////////////////////////////////////
+static int _serial_rs485_writev( int AiPort, PSERIAL_PORT_INFO pInfo, struct iovec *AsIov, int AiCnt )
+{
+	struct timespec tsStart, tsDrained, tsEnd;
+	int iRet;
+
+	Serial_Set_Rts( AiPort, 1 );
+	clock_gettime( CLOCK_MONOTONIC, &tsStart );
+	_serial_busy_wait( &tsStart, pInfo->lRs485DelayBefore );
+
+	iRet = _serial_writev_all( AiPort, AsIov, AiCnt );
+
+	while( tcdrain( AiPort ) < 0 && errno == EINTR );
+	clock_gettime( CLOCK_MONOTONIC, &tsDrained );
+	_serial_busy_wait( &tsDrained, pInfo->lCharUsec + pInfo->lRs485DelayAfter );
+
+	Serial_Set_Rts( AiPort, 0 );
+	clock_gettime( CLOCK_MONOTONIC, &tsEnd );
+
+	_serial_stat_begin( pInfo );
+	pInfo->pStat->lTurnaroundLast = _serial_diff_usec( &tsDrained, &tsEnd );
+	if( pInfo->pStat->lTurnaroundLast > pInfo->pStat->lTurnaroundMax ){
+		pInfo->pStat->lTurnaroundMax = pInfo->pStat->lTurnaroundLast;
+	}
+	_serial_stat_end( pInfo );
+
+	return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   送信結合バッファを先頭に付けてiovecを書き込む関数
+///
+/// \return  書き込んだバイト数 (結合バッファ分は含まない), -1 … 失敗
+/// \param   AiPort  シリアルポート記述子
+/// \param   *AsIov  書き込むiovec
+/// \param   AiCnt   iovecの数
+//////////////////////////////////////////////////////////////////////////////
+static int _serial_put_iov( int AiPort, const struct iovec *AsIov, int AiCnt )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+	struct iovec iov[SERIAL_IOV_MAX];
+	int iTotal = 0;
+	int iSent = 0;
+	int iRet;
+	int iNum, i;
+	int iQueued = 0;
+	int iLen;
+
+	if( AiCnt < 0 || ( AiCnt > 0 && AsIov == NULL ) ){
+		return -1;
+	}
+
+	do{
+		iNum = 0;
+		iLen = 0;
+		if( pInfo != NULL && pInfo->iCoalesceLen > 0 ){
+			iov[iNum].iov_base = pInfo->cCoalesceBuf;
+			iov[iNum].iov_len = pInfo->iCoalesceLen;
+			iQueued = pInfo->iCoalesceLen;
+			pInfo->iCoalesceLen = 0;
+			iLen += iQueued;
+			iNum++;
+		}
+		for( i = 0; i < AiCnt && iNum < SERIAL_IOV_MAX ; i++, iNum++ ){
+			iov[iNum] = AsIov[i];
+			iLen += AsIov[i].iov_len;
+		}
+		AsIov += i;
+		AiCnt -= i;
+
+		if( pInfo != NULL && pInfo->iRs485Mode == SERIAL_RS485_MODE_SOFTWARE ){
+			iRet = _serial_rs485_writev( AiPort, pInfo, iov, iNum );
+		}else{
+			iRet = _serial_writev_all( AiPort, iov, iNum );
+		}
+		if( iRet < 0 ){
+			// 送信できなかった送信結合バッファの内容は残す
+			if( pInfo != NULL ) pInfo->iCoalesceLen = iQueued;
+			if( iSent == 0 && iTotal == 0 ) return -1;
+			break;
+		}
+		iSent += iRet;
+		if( iRet < iQueued ){
+			// 送信結合バッファの途中までしか送信できなかった
+			memmove( pInfo->cCoalesceBuf, &pInfo->cCoalesceBuf[iRet], iQueued - iRet );
+			pInfo->iCoalesceLen = iQueued - iRet;
+			break;
+		}
+		iTotal += iRet - iQueued;
+		iQueued = 0;
+		if( iRet < iLen ) break;	// 部分書き込み (ノンブロッキング)
+	}while( AiCnt > 0 );
+
+	if( pInfo != NULL && iSent > 0 ){
+		_serial_stat_sent( AiPort, pInfo, iSent );
+	}
+
+	return iTotal;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートを半二重通信でオープンする関数
+///
+/// \return  オープンしたシリアルポートへのポインタ
+/// \param   *AsDev  オープンするシリアルデバイス /dev/ttyS?
+/// \param   AlSpeed      シリアルポートの速度 2400,4800,9600,19200,38400,57600,115200, 460800, 921600
+/// \param   AiLength     シリアルポートのデータ長 7,8
+/// \param   AiStop       シリアルポートのストップビット 0,1,2
+/// \param   AiParity     シリアルポートのパリティ 0(n),1(e),2(o)
+/// \param   AiWait       シリアルポートの受信待ち時間
+/// \param   AiBlockMode   シリアルポートのオープン時のブロッキング(0:無効 1:有効)
+////////////////////////////////////////////////////////////////////////////////
+int Serial_PortOpen_Half( char *AsDev, long AlSpeed, int AiLength, int AiStop, int AiParity , int AiWait, int AiBlockMode)
+{
+	static int iPort;
+
+	iPort = Serial_PortOpen_Func(AsDev, AlSpeed, AiLength, AiStop, AiParity, AiWait, AiBlockMode, 0);
+
+	if( iPort < 0 ) return iPort;
+
+	Serial_SetRs485( iPort, SERIAL_RS485_ENABLE, 0, 0 ); // rs485 enable (ドライバ対応時のみ)
+
+	return iPort;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートをオープンする関数
+///
+/// \return  オープンしたシリアルポートへのポインタ
+/// \param   *AsDev  オープンするシリアルデバイス /dev/ttyS?
+/// \param   AlSpeed      シリアルポートの速度 2400,4800,9600,19200,38400,57600,115200,460800,921600
+/// \param   AiLength     シリアルポートのデータ長 7,8
+/// \param   AiStop       シリアルポートのストップビット 0,1,2
+/// \param   AiParity     シリアルポートのパリティ 0(n),1(e),2(o)
+/// \param   AiWait       シリアルポートの受信待ち時間
+/// \param   AiOpenMode   シリアルポートのオープン時のブロッキング(0:無効 1:有効)
+/// \param   AiFlow       シリアルポートのオープン時のフロー制御 ( 0:なし, 1:RTS/CTS, 2:DTR/DSR )
+//////////////////////////////////////////////////////////////////////////////
+int Serial_PortOpen_Func( char *AsDev, long AlSpeed, int AiLength, int AiStop, int AiParity ,int AiWait, int AiOpenMode, int AiFlow ){
+	static struct termios newtio;
+	static int iPort;
+	static int iOpenMode;
+
+	switch( AiOpenMode ){
+		case 0: iOpenMode = O_RDWR | O_NOCTTY ; break;
+		case 1: iOpenMode = O_RDWR | O_NOCTTY | O_NONBLOCK ; break;
+	}
+
+	/* 読み書きの為にモデムデバイスをオープンする。ノイズによってCTRL-Cが
+		たまたま発生しても接続が切れないようにtty制御はしない */
+	iPort = open( AsDev, iOpenMode );
+	if( iPort < 0 ){
+		perror( AsDev );
+		return -1;
+	}
+	// 現在のシリアルポートの設定を保存(Close時に戻す為)
+	tcgetattr( iPort, &oldtio );
+
+	if( iPort < SERIAL_PORT_MAX ){
+		// 同じ記述子番号で残っている情報の共有メモリを解放する
+		Serial_StatisticsShmClose( iPort );
+		free( serial_port_info[iPort] );
+		serial_port_info[iPort] = (PSERIAL_PORT_INFO)calloc( 1, sizeof(SERIAL_PORT_INFO) );
+		if( serial_port_info[iPort] != NULL ){
+			serial_port_info[iPort]->oldtio = oldtio;
+			serial_port_info[iPort]->pStat = &serial_port_info[iPort]->stat;
+			serial_port_info[iPort]->stat.ulVersion = SERIAL_STATISTICS_VERSION;
+		}
+	}
+
+	Serial_PortSetParameter(iPort, AlSpeed, AiLength, AiStop, AiParity, AiWait, AiFlow);
+
+	return iPort;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   ループバック用の疑似端末を作成する関数
+///
+/// \return  疑似端末マスタ側の記述子, -1 … 失敗
+/// \param   *AsSlaveName  スレーブ側のデバイス名の格納先 ( /dev/pts/? )
+/// \param   AiLen         AsSlaveNameのサイズ
+/// \note    スレーブ側をSerial_PortOpen_Funcでオープンし、マスタ側を対向機器として
+///          読み書きすることで、実機なしで送受信や統計情報を確認できます。
+///          マスタ側は加工なし(raw)に設定されます。不要になったらcloseしてください。
+//////////////////////////////////////////////////////////////////////////////
+int Serial_PortOpen_Pty( char *AsSlaveName, int AiLen )
+{
+	int iMaster;
+	struct termios tio;
+
+	if( AsSlaveName == NULL || AiLen <= 0 ) return -1;
+
+	iMaster = posix_openpt( O_RDWR | O_NOCTTY );
+	if( iMaster < 0 ){
+		perror( "posix_openpt" );
+		return -1;
+	}
+
+	if( grantpt( iMaster ) < 0 || unlockpt( iMaster ) < 0 ||
+		ptsname_r( iMaster, AsSlaveName, AiLen ) != 0
+	){
+		close( iMaster );
+		return -1;
+	}
+
+	if( tcgetattr( iMaster, &tio ) == 0 ){
+		cfmakeraw( &tio );
+		tcsetattr( iMaster, TCSANOW, &tio );
+	}
+
+	return iMaster;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートのパラメータを設定する関数
+///
+/// \param   AiPort       シリアルポートのファイルディスクリプタ
+/// \param   AiSpeed      シリアルポートの速度 2400,4800,9600,19200,38400,57600,115200,460800,921600
+/// \param   AiLength     シリアルポートのデータ長 7,8
+/// \param   AiStop       シリアルポートのストップビット 0,1,2
+/// \param   AiParity     シリアルポートのパリティ 0(n),1(e),2(o)
+/// \param   AiWait       シリアルポートの受信待ち時間
+//////////////////////////////////////////////////////////////////////////////
+void Serial_PortSetParameter(int AiPort, int AiSpeed, int AiLength, int AiStop, int AiParity, int AiWait, int AiFlow)
+{
+	static struct termios newtio;
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+	int iCharBits;
+
+	// 制御コードの初期化を行う
+	newtio.c_iflag = 0;
+	newtio.c_oflag = 0;
+	newtio.c_cflag = 0;
+	newtio.c_lflag = 0;
+	newtio.c_line = 0;
+	bzero( newtio.c_cc, sizeof(newtio.c_cc) );
+
+	///// c_cflagの設定 /////
+	/* Setting for c_cflag
+		B921600～B2400 : 通信速度
+		CS5～CS8 : データビット長
+		CSTOPB   : ストップビット長=2(付けなければ1)
+		CPARENB  : パリティ有効(このままでは偶数)
+		CPARODD  : パリティを奇数にする
+		CLOCAL   : モデムの制御線を無視する
+		CREAD    : 受信文字を有効にする
+		CRTSCTS  : 出力のハードウェアフロー制御を有効にする
+		HUPCL    : 最後のプロセスがクローズした後、モデムの制御線をLOWにする
+	*/
+	// 通信速度のセット
+	switch( AiSpeed ){
+		case 921600:
+			newtio.c_cflag = B921600;
+			break;
+		case 460800:
+			newtio.c_cflag = B460800;
+			break;
+		case 115200:
+			newtio.c_cflag = B115200;
+			break;
+		case 57600:
+			newtio.c_cflag = B57600;
+			break;
+		case 38400:
+			newtio.c_cflag = B38400;
+			break;
+		case 19200:
+			newtio.c_cflag = B19200;
+			break;
+		case 9600:
+			newtio.c_cflag = B9600;
+			break;
+		case 4800:
+			newtio.c_cflag = B4800;
+			break;
+		case 2400:
+			newtio.c_cflag = B2400;
+			break;
+		default:
+			newtio.c_cflag = B9600; // デフォルトは9600bps
+			break;
+	}
+	// データビット長の設定
+	switch( AiLength ){
+		case 7:
+			// CS7  : データ長を7ビットにする
+			newtio.c_cflag = newtio.c_cflag | CS7 ;
+			break;
+		default:
+			// CS8  : デフォルトではデータ長を8ビットにする
+			newtio.c_cflag = newtio.c_cflag | CS8 ;
+			break;
+	}
+	// ストップビットの設定
+	switch( AiStop ){
+		case 2:
+			// CSTOPB   : ストップビットを2にする
+			newtio.c_cflag = newtio.c_cflag | CSTOPB ; 
+			break;
+		default:
+			// デフォルトでは1
+			newtio.c_cflag = newtio.c_cflag & ~CSTOPB ;
+			break;
+	}
+	// パリティのセット
+	switch( AiParity ){
+		case 1:
+			// PARENB  : パリティを有効にする(標準では偶数)
+			newtio.c_cflag = newtio.c_cflag | PARENB ;
+			break;
+		case 2:
+			// PARENB  : パリティを有効にし奇数をセット
+			newtio.c_cflag = newtio.c_cflag | PARENB | PARODD ;
+			break;
+		default:
+			// NO PARITY
+			break;
+	}
+
+	// Ver 1.0.3 Flow Control Added 
+	// Setting of hardware flow 
+	switch( AiFlow ){
+		case 1:
+			// CRTSCTS  : enables hardware flow
+			newtio.c_cflag = newtio.c_cflag | CRTSCTS;
+			break;
+		case 0:	
+		default:
+			// no hardware flow
+			break;
+	}
+	// Ver 1.0.3 End
+	
+//	newtio.c_cflag = newtio.c_cflag | CLOCAL | CREAD;
+	newtio.c_cflag = newtio.c_cflag | CLOCAL | CREAD;
+
+	///// c_iflagの設定 /////
+//	newtio.c_iflag = IGNPAR; // IGNPAR : パリティエラーのデータは無視
+	newtio.c_iflag = IGNPAR | IGNBRK; // IGNBRK : ブレーク信号は無視
+
+	///// c_oflagの設定 /////
+	newtio.c_oflag = 0;     // 0:Rawモードでの出力
+
+	///// c_lflagの設定 /////
+	newtio.c_lflag = 0;  // Set input mode (non-canonical,no echo,....)
+	/*　ICANON : カノニカル入力を有効にする */
+	newtio.c_cc[VTIME] = AiWait / 100; // 0:キャラクタタイマ ( AiWait(msec) / 100)
+	if( pInfo != NULL ){
+		pInfo->iWaitMsec = ( AiWait > 0 ) ? AiWait : 0;
+	}
+	newtio.c_cc[VMIN] = 0;  // 指定文字来るまで読み込みをブロック(0:しない 1:する)
+
+	///// モデムラインをクリア /////
+	tcflush( AiPort, TCIFLUSH );
+// change start 2004/08/25 tkasuya,contec
+//	// 新しい設定を適用する (TCSANOW：ただちに変更が有効となる)
+//	tcsetattr( AiPort, TCSANOW, &newtio );
+	// 新しい設定を適用する (TCSADRAIN：変更を出力がフラッシュされた後に反映)
+	tcsetattr( AiPort, TCSADRAIN, &newtio );
+// change end
+
+	// 1キャラクタの送出時間 ( start + data + parity + stop )
+	if( pInfo != NULL ){
+		switch( AiSpeed ){
+		case 921600: case 460800: case 115200: case 57600:
+		case 38400: case 19200: case 9600: case 4800: case 2400:
+			break;
+		default:
+			AiSpeed = 9600;
+			break;
+		}
+		iCharBits = 1 + ( ( AiLength == 7 ) ? 7 : 8 ) +
+			( ( AiParity == 1 || AiParity == 2 ) ? 1 : 0 ) + ( ( AiStop == 2 ) ? 2 : 1 );
+		pInfo->lCharUsec = ( iCharBits * 1000000L + AiSpeed - 1 ) / AiSpeed;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートを閉じる関数
+///
+/// \return  void
+/// \param   AiPort  シリアルポート記述子
+//////////////////////////////////////////////////////////////////////////////
+void Serial_PortClose( int AiPort )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+
+	// 送信結合バッファに残っているデータを送信する
+	Serial_FlushQueue( AiPort );
+
+	// シリアルポートの設定をポートオープン前に戻す
+// change start 2004/08/25 tkasuya,contec
+//	tcsetattr( AiPort, TCSANOW, &oldtio );
+//	ioctl(AiPort, TIOCSRS485, 0); // rs485 enable
+	if( pInfo != NULL ){
+		tcsetattr( AiPort, TCSADRAIN, &pInfo->oldtio );
+		Serial_StatisticsShmClose( AiPort );
+		free( pInfo );
+		serial_port_info[AiPort] = (PSERIAL_PORT_INFO)NULL;
+	}else{
+		tcsetattr( AiPort, TCSADRAIN, &oldtio );
+	}
+// change end
+	close(AiPort);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief シリアルポートへ1バイトを書き込む関数
+///
+/// \return  出力結果 0 … 成功, -1 … 失敗
+/// \param   AiPort  シリアルポート記述子
+/// \param   AcChar  出力データ
+//////////////////////////////////////////////////////////////////////////////
+int Serial_PutChar( int AiPort, unsigned char AcChar )
+{
+	if( Serial_PutString( AiPort, &AcChar, 1 ) != 1 ){
+		return -1;
+	}
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートから1文字読み込む関数
+///
+/// \return  受信データ(1バイト)
+/// \param   AiPort     シリアルポート記述子
+//////////////////////////////////////////////////////////////////////////////
+unsigned char Serial_GetChar( int AiPort )
+{
+	static unsigned char cRet = 0xFF;
+	static int iRet;
+
+	iRet = _serial_read( AiPort, &cRet, 1 );
+	return cRet;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートから文字列を読込む関数
+///
+/// \return  読込み完了バイト数
+/// \param   AiPort     シリアルポート記述子
+/// \param   *AsBuffer  読込んだ文字列を格納するバッファへのポインタ
+/// \param   AiLen       一度に読込むバイト数
+//////////////////////////////////////////////////////////////////////////////
+int Serial_GetString( int AiPort, unsigned char *AsBuffer, int AiLen )
+{
+	static int iRet = 0;
+
+	// 応答を待つ前に送信結合バッファに残っている要求を送信する
+	Serial_FlushQueue( AiPort );
+
+	// TIOCGICOUNTは統計情報の取得時(または取得周期毎)に行う
+	iRet = _serial_read( AiPort, AsBuffer, AiLen );
+
+	return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートへ多バイトのデータを書き込む関数
+///
+/// \return  出力結果 0 … 成功, -1 … 失敗
+/// \param   AiPort     シリアルポート記述子
+/// \param   *AsBuffer  送信文字列へのポインタ
+/// \param   AiLen      書込みバイト数
+//////////////////////////////////////////////////////////////////////////////
+int Serial_PutString( int AiPort, unsigned char *AsBuffer, int AiLen )
+{
+	struct iovec iov;
+
+	//if( write( AiPort, AsBuffer, AiLen ) != 1 ){
+	//	return -1;
+	//}
+	
+	//return 0;
+	DbgPrint("<Serial PutString AsBuf %s , Len : %d \n", AsBuffer, AiLen );
+
+	if( AiLen < 0 ) return -1;
+
+	iov.iov_base = AsBuffer;
+	iov.iov_len = AiLen;
+
+	return _serial_put_iov( AiPort, &iov, 1 );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートへ複数のバッファを1回の送信として書き込む関数
+///
+/// \return  書き込んだバイト数, -1 … 失敗
+/// \param   AiPort     シリアルポート記述子
+/// \param   *AsIov     送信バッファの配列 (ヘッダ,ペイロード,トレーラなど)
+/// \param   AiCnt      送信バッファの数
+/// \note    部分書き込みが発生した場合は全て書き込むまで繰り返します。
+//////////////////////////////////////////////////////////////////////////////
+int Serial_PutStringV( int AiPort, const struct iovec *AsIov, int AiCnt )
+{
+	return _serial_put_iov( AiPort, AsIov, AiCnt );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   送信結合の時間窓を設定する関数
+///
+/// \return  0 … 成功, -1 … 失敗
+/// \param   AiPort     シリアルポート記述子
+/// \param   AlUsec     時間窓 (usec) 0で結合しない
+/// \note    Serial_QueueStringで格納したデータはタイマでは送信されません。
+///          時間窓が経過した後の次のSerial_QueueString、バッファが一杯になった時、
+///          またはSerial_PutString/Serial_GetString/Serial_FlushQueue/Serial_Drain/
+///          Serial_PortCloseの呼び出し時にまとめて送信されます。
+///          時間窓の経過だけで送信したい場合はSerial_FlushQueueを周期的に呼んでください。
+//////////////////////////////////////////////////////////////////////////////
+int Serial_SetCoalesce( int AiPort, long AlUsec )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+
+	if( pInfo == NULL || AlUsec < 0 ) return -1;
+
+	if( AlUsec == 0 && Serial_FlushQueue( AiPort ) < 0 ) return -1;
+
+	pInfo->lCoalesceUsec = AlUsec;
+
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートへの送信データを送信結合バッファに格納する関数
+///
+/// \return  格納(または送信)したバイト数, -1 … 失敗
+/// \param   AiPort     シリアルポート記述子
+/// \param   *AsBuffer  送信文字列へのポインタ
+/// \param   AiLen      書込みバイト数
+/// \note    送信結合が無効の場合はSerial_PutStringと同じです。
+//////////////////////////////////////////////////////////////////////////////
+int Serial_QueueString( int AiPort, unsigned char *AsBuffer, int AiLen )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+	struct timespec tsNow;
+
+	if( AiLen < 0 ) return -1;
+
+	if( pInfo == NULL || pInfo->lCoalesceUsec == 0 ){
+		return Serial_PutString( AiPort, AsBuffer, AiLen );
+	}
+
+	clock_gettime( CLOCK_MONOTONIC, &tsNow );
+
+	// 時間窓を過ぎている、または入りきらない場合は溜まっている分と合わせて送信する
+	if( pInfo->iCoalesceLen > 0 &&
+		_serial_diff_usec( &pInfo->tsCoalesce, &tsNow ) >= pInfo->lCoalesceUsec
+	){
+		return Serial_PutString( AiPort, AsBuffer, AiLen );
+	}
+	if( pInfo->iCoalesceLen + AiLen > SERIAL_COALESCE_BUFFER_SIZE ){
+		return Serial_PutString( AiPort, AsBuffer, AiLen );
+	}
+
+	if( pInfo->iCoalesceLen == 0 ){
+		pInfo->tsCoalesce = tsNow;
+	}
+	memcpy( &pInfo->cCoalesceBuf[pInfo->iCoalesceLen], AsBuffer, AiLen );
+	pInfo->iCoalesceLen += AiLen;
+
+	return AiLen;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   送信結合バッファに溜まっているデータを送信する関数
+///
+/// \return  送信したバイト数, -1 … 失敗
+/// \param   AiPort     シリアルポート記述子
+//////////////////////////////////////////////////////////////////////////////
+int Serial_FlushQueue( int AiPort )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+	int iLen;
+
+	if( pInfo == NULL || pInfo->iCoalesceLen == 0 ) return 0;
+
+	iLen = pInfo->iCoalesceLen;
+
+	// RS485のソフトウェア方向制御と統計情報の記録を通常の送信と共通にする
+	if( _serial_put_iov( AiPort, NULL, 0 ) < 0 ) return -1;
+
+	return iLen;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   送信データが全て送出されるまで待つ関数
+///
+/// \return  0 … 成功, -1 … 失敗
+/// \param   AiPort     シリアルポート記述子
+/// \param   *AlUsec    送出完了までにかかった時間 (usec) 不要な場合はNULL
+/// \note    送信結合バッファに溜まっているデータも送信してから待ちます。
+///          半二重通信でRTSを戻すタイミングの判断に使用します。
+//////////////////////////////////////////////////////////////////////////////
+int Serial_Drain( int AiPort, long *AlUsec )
+{
+	struct timespec tsStart, tsEnd;
+	int iRet;
+
+	clock_gettime( CLOCK_MONOTONIC, &tsStart );
+
+	if( Serial_FlushQueue( AiPort ) < 0 ) return -1;
+
+	do{
+		iRet = tcdrain( AiPort );
+	}while( iRet < 0 && errno == EINTR );
+
+	clock_gettime( CLOCK_MONOTONIC, &tsEnd );
+
+	if( AlUsec != NULL ){
+		*AlUsec = _serial_diff_usec( &tsStart, &tsEnd );
+	}
+
+	return ( iRet < 0 ) ? -1 : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   サムチェックを計算する関数
+///
+/// \return  サムチェック計算値
+/// \param   *AsBuffer    サムチェック対象文字列
+/// \param   AiLen        サムチェック対象文字数
+/// \param   AiComplement サムチェックに2の補数を適用 1…適用,他…非適用
+//////////////////////////////////////////////////////////////////////////////
+int Serial_SumCheck( char *AsBuffer, int AiLen, int AiComplement ){
+	int iRet = 0;
+	int i = 0;
+
+	for( i = 0 ; i < AiLen ; i++ ){
+		iRet = iRet + AsBuffer[i];
+	}
+
+	if( AiComplement == 1 ){
+		iRet ^= 0xff;
+		iRet = iRet + 1;
+	}
+	iRet = iRet % 0x100;
+	return iRet;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   RTSに値をセットする関数
+///
+/// \return  void
+/// \param   AiPort   シリアルポート記述子
+/// \param   AiValue  セット値(0:OFF , 1:ON)
+//////////////////////////////////////////////////////////////////////////////
+void Serial_Set_Rts( int AiPort, int AiValue ){
+        int a;
+        int ioctl_ret;
+
+        ioctl_ret=ioctl( AiPort, TIOCMGET, &a );
+
+        // printf( "ret=(%d) a=[%x]\n", ioctl_ret, a );
+        if( ioctl_ret < 0 ) return; // 疑似端末などモデム制御線のないデバイス
+
+        a &= ~TIOCM_RTS;
+        if( AiValue ){
+                a |= TIOCM_RTS;
+        }
+        ioctl( AiPort, TIOCMSET, &a);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   RS485の送信方向制御を設定する関数
+///
+/// \return  1 … ドライバで制御, 0 … ライブラリで制御(または無効), -1 … 失敗
+/// \param   AiPort             シリアルポート記述子
+/// \param   AiEnable           SERIAL_RS485_DISABLE:無効 SERIAL_RS485_ENABLE:有効
+///                             SERIAL_RS485_ENABLE_SOFTWARE:有効 (ドライバ非対応時はライブラリで制御)
+/// \param   AlDelayBeforeUsec  RTS ONから送信開始までの時間 (usec)
+/// \param   AlDelayAfterUsec   送信完了からRTS OFFまでの時間 (usec)
+/// \note    SERIAL_RS485_ENABLEでUARTがTIOCSRS485に対応していない場合は-1を返し、何も変更しません。
+///          SERIAL_RS485_ENABLE_SOFTWAREの場合は、送信毎にRTSをONにし、
+///          tcdrainと1キャラクタ分のビジーウェイトの後にRTSをOFFにします。
+///          (送信の度にビジーウェイトが発生します)
+///          ドライバの遅延時間はmsec単位のため切り上げて設定します。
+//////////////////////////////////////////////////////////////////////////////
+int Serial_SetRs485( int AiPort, int AiEnable, long AlDelayBeforeUsec, long AlDelayAfterUsec )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+	struct serial_rs485 rs485conf;
+
+	if( AlDelayBeforeUsec < 0 || AlDelayAfterUsec < 0 ) return -1;
+
+	memset( &rs485conf, 0, sizeof(rs485conf) );
+	if( AiEnable ){
+		rs485conf.flags = SER_RS485_ENABLED | SER_RS485_RTS_ON_SEND;
+		rs485conf.delay_rts_before_send = ( AlDelayBeforeUsec + 999 ) / 1000;
+		rs485conf.delay_rts_after_send = ( AlDelayAfterUsec + 999 ) / 1000;
+	}
+
+	if( ioctl( AiPort, TIOCSRS485, &rs485conf ) == 0 ){
+		if( pInfo != NULL ){
+			pInfo->iRs485Mode = AiEnable ? SERIAL_RS485_MODE_KERNEL : SERIAL_RS485_MODE_NONE;
+		}
+		return AiEnable ? 1 : 0;
+	}
+
+	if( AiEnable == SERIAL_RS485_ENABLE ) return -1;
+
+	if( pInfo == NULL ) return AiEnable ? -1 : 0;
+
+	// ドライバが対応していないのでソフトウェアで切り替える
+	if( AiEnable ){
+		pInfo->iRs485Mode = SERIAL_RS485_MODE_SOFTWARE;
+		pInfo->lRs485DelayBefore = AlDelayBeforeUsec;
+		pInfo->lRs485DelayAfter = AlDelayAfterUsec;
+		Serial_Set_Rts( AiPort, 0 );
+	}else{
+		pInfo->iRs485Mode = SERIAL_RS485_MODE_NONE;
+	}
+
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   RS485の送信完了からRTS OFFまでの時間を取得する関数
+///
+/// \return  0 … 成功, -1 … 失敗
+/// \param   AiPort    シリアルポート記述子
+/// \param   *AlLast   最後の送信の時間 (usec)
+/// \param   *AlMax    最大時間 (usec)
+/// \note    tcdrainの完了からRTS OFFまでの時間です。
+///          ライブラリで方向制御している場合(SERIAL_RS485_ENABLE_SOFTWARE)のみ計測されます。
+///          ドライバで方向制御している場合はRTSの切り替えがライブラリから見えないため、
+///          常に0が返ります。
+//////////////////////////////////////////////////////////////////////////////
+int Serial_GetRs485Turnaround( int AiPort, long *AlLast, long *AlMax )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+
+	if( pInfo == NULL ) return -1;
+
+	if( AlLast != NULL ) *AlLast = pInfo->pStat->lTurnaroundLast;
+	if( AlMax != NULL ) *AlMax = pInfo->pStat->lTurnaroundMax;
+
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートの統計情報を取得する関数
+///
+/// \return  0 … 成功, -1 … 失敗
+/// \param   AiPort     シリアルポート記述子
+/// \param   *AsStat    統計情報の格納先
+/// \param   AiSample   1:TIOCGICOUNTでエラーカウンタを取得してから返す 0:前回取得した値を返す
+/// \note    ulGenerationが偶数で、コピーの前後で変わらなくなるまでコピーをやり直すため、
+///          送受信中に呼んでもカウンタとヒストグラムの間で一貫した値が得られます。
+///          共有メモリを参照する監視プロセスも同じ手順で読み出してください。
+//////////////////////////////////////////////////////////////////////////////
+int Serial_GetStatistics( int AiPort, PSERIAL_STATISTICS AsStat, int AiSample )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+	volatile unsigned long *pSrc;
+	unsigned long *pDst;
+	unsigned long ulGen;
+	int i, iRetry;
+
+	if( pInfo == NULL || AsStat == NULL ) return -1;
+
+	if( AiSample ){
+		_serial_stat_sample_icount( AiPort, pInfo );
+	}
+
+	pSrc = (volatile unsigned long *)pInfo->pStat;
+	pDst = (unsigned long *)AsStat;
+
+	for( iRetry = 0; iRetry < SERIAL_STAT_READ_RETRY; iRetry++ ){
+		ulGen = ((volatile SERIAL_STATISTICS *)pSrc)->ulGeneration;
+		__sync_synchronize();
+		if( ulGen & 1 ){
+			// 更新中
+			sched_yield();
+			continue;
+		}
+		for( i = 0; i < (int)( sizeof(SERIAL_STATISTICS) / sizeof(unsigned long) ); i++ ){
+			pDst[i] = pSrc[i];
+		}
+		__sync_synchronize();
+		if( ((volatile SERIAL_STATISTICS *)pSrc)->ulGeneration == ulGen ){
+			return 0;
+		}
+	}
+
+	errno = EBUSY;
+	return -1;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートの統計情報をクリアする関数
+///
+/// \return  0 … 成功, -1 … 失敗
+/// \param   AiPort     シリアルポート記述子
+//////////////////////////////////////////////////////////////////////////////
+int Serial_ResetStatistics( int AiPort )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+
+	unsigned long ulGen;
+
+	if( pInfo == NULL ) return -1;
+
+	_serial_stat_begin( pInfo );
+	ulGen = pInfo->pStat->ulGeneration;
+	memset( pInfo->pStat, 0, sizeof(SERIAL_STATISTICS) );
+	pInfo->pStat->ulVersion = SERIAL_STATISTICS_VERSION;
+	pInfo->pStat->ulGeneration = ulGen;
+	_serial_stat_end( pInfo );
+
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   TIOCGICOUNTでエラーカウンタを取得する周期を設定する関数
+///
+/// \return  0 … 成功, -1 … 失敗
+/// \param   AiPort     シリアルポート記述子
+/// \param   AlMsec     取得周期 (msec) 0:Serial_GetStatisticsで要求された時のみ
+/// \note    周期は送受信の度に確認するため、送受信がない間は更新されません。
+//////////////////////////////////////////////////////////////////////////////
+int Serial_SetStatisticsInterval( int AiPort, long AlMsec )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+
+	if( pInfo == NULL || AlMsec < 0 ) return -1;
+
+	pInfo->lIcountMsec = AlMsec;
+
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   統計情報を共有メモリに配置する関数
+///
+/// \return  0 … 成功, -1 … 失敗
+/// \param   AiPort     シリアルポート記述子
+/// \param   *AsName    共有メモリ名 ( shm_openの名前 例: "/serialstat_ttyS1" )
+/// \note    外部の監視プロセスはポートを開かずに共有メモリを読込み専用でmmapして
+///          SERIAL_STATISTICSとして参照できます。
+//////////////////////////////////////////////////////////////////////////////
+int Serial_StatisticsShmOpen( int AiPort, const char *AsName )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+	PSERIAL_STATISTICS pShm;
+	int fd;
+
+	if( pInfo == NULL || AsName == NULL ) return -1;
+	if( strlen( AsName ) >= sizeof(pInfo->cShmName) ) return -1;
+
+	Serial_StatisticsShmClose( AiPort );
+
+	fd = shm_open( AsName, O_CREAT | O_RDWR, 0644 );
+	if( fd < 0 ) return -1;
+
+	if( ftruncate( fd, sizeof(SERIAL_STATISTICS) ) < 0 ){
+		close( fd );
+		shm_unlink( AsName );
+		return -1;
+	}
+
+	pShm = (PSERIAL_STATISTICS)mmap( NULL, sizeof(SERIAL_STATISTICS), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+	close( fd );
+	if( pShm == (PSERIAL_STATISTICS)MAP_FAILED ){
+		shm_unlink( AsName );
+		return -1;
+	}
+
+	// これまでの統計情報を引き継いで共有メモリ側を更新する
+	_serial_stat_lock( pInfo );
+	memcpy( pShm, pInfo->pStat, sizeof(SERIAL_STATISTICS) );
+	__sync_synchronize();
+	pInfo->pStat = pShm;
+	_serial_stat_unlock( pInfo );
+	strcpy( pInfo->cShmName, AsName );
+
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   統計情報の共有メモリを解放する関数
+///
+/// \return  0 … 成功, -1 … 失敗
+/// \param   AiPort     シリアルポート記述子
+//////////////////////////////////////////////////////////////////////////////
+int Serial_StatisticsShmClose( int AiPort )
+{
+	PSERIAL_PORT_INFO pInfo = _serial_get_port_info( AiPort );
+	PSERIAL_STATISTICS pShm;
+
+	if( pInfo == NULL ) return -1;
+	if( pInfo->pStat == &pInfo->stat ) return 0;
+
+	_serial_stat_lock( pInfo );
+	pShm = pInfo->pStat;
+	memcpy( &pInfo->stat, pShm, sizeof(SERIAL_STATISTICS) );
+	__sync_synchronize();
+	pInfo->pStat = &pInfo->stat;
+	_serial_stat_unlock( pInfo );
+
+	munmap( pShm, sizeof(SERIAL_STATISTICS) );
+	shm_unlink( pInfo->cShmName );
+	pInfo->cShmName[0] = '\0';
+
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   DTRに値をセットする関数
+///
+/// \return  void
+/// \param   AiPort   シリアルポート記述子
+/// \param   AiValue  セット値(0:OFF , 1:ON)
+//////////////////////////////////////////////////////////////////////////////
+void Serial_Set_Dtr( int AiPort, int AiValue ){
+        int a;
+
+        if( ioctl( AiPort, TIOCMGET, &a ) < 0 ) return;
+        a &= ~TIOCM_DTR;
+        if( AiValue ){
+                a |= TIOCM_DTR;
+        }
+        ioctl( AiPort, TIOCMSET, &a );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   LSRの値を取得する関数
+///
+/// \return  void
+/// \param   AiPort   シリアルポート記述子
+/// \param   AiValue  Lsrの値
+//////////////////////////////////////////////////////////////////////////////
+void Serial_Get_Lsr( int AiPort, int *AiValue ){
+	int lsr;
+
+	ioctl( AiPort, TIOCSERGETLSR, &lsr);
+
+	if( lsr & LSR_FE )
+		printf(" Framing Error!\n");
+	if( lsr & LSR_OE )
+		printf(" Rx Overrun Error!\n");
+	if( lsr & LSR_PE )
+		printf(" Parity Error!\n");
+
+	*AiValue = lsr;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   RIの値を取得する関数
+///
+/// \return  int	取得値(0:OFF , 1:ON)
+/// \param   AiPort   シリアルポート記述子
+//////////////////////////////////////////////////////////////////////////////
+int Serial_Get_Ri( int AiPort ){
+
+	int a;
+
+	ioctl( AiPort, TIOCMGET, &a );
+
+	if( a & TIOCM_RI )
+		return 1;
+	else
+		return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   DCDの値を取得する関数
+///
+/// \return  int 取得値(0:OFF , 1:ON)
+/// \param   AiPort   シリアルポート記述子
+//////////////////////////////////////////////////////////////////////////////
+int Serial_Get_Dcd( int AiPort ){
+
+	int a;
+
+	ioctl( AiPort, TIOCMGET, &a );
+
+	if( a & TIOCM_CAR )
+		return 1;
+	else
+		return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   DSRの値を取得する関数
+///
+/// \return  int 取得値(0:OFF , 1:ON)
+/// \param   AiPort   シリアルポート記述子
+//////////////////////////////////////////////////////////////////////////////
+int Serial_Get_Dsr( int AiPort ){
+
+	int a;
+
+	ioctl( AiPort, TIOCMGET, &a );
+
+	if( a & TIOCM_DSR )
+		return 1;
+	else
+		return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートの入力バッファを取得します
+///
+/// \return  void
+/// \param   AiPort   シリアルポート記述子
+/// \param   AiValue  入力バッファの値
+//////////////////////////////////////////////////////////////////////////////
+void Serial_Get_In_Buffer( int AiPort, int *AiValue ){
+
+	ioctl( AiPort, FIONREAD, AiValue);
+
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルポートの出力バッファを取得します
+///
+/// \return  void
+/// \param   AiPort   シリアルポート記述子
+/// \param   AiValue  出力バッファの値
+//////////////////////////////////////////////////////////////////////////////
+void Serial_Get_Out_Buffer( int AiPort, int *AiValue ){
+
+	ioctl( AiPort, TIOCOUTQ, AiValue);
+
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// \brief   シリアルライブラリのバージョンを取得します
+///
+/// \return  void
+/// \param   libVer   ライブラリのバージョン
+//////////////////////////////////////////////////////////////////////////////
+void Serial_Get_Lib_Version( char *libVer ){
+
+	strcpy(libVer,LIB_SERIAL_VERSION);
+
+}
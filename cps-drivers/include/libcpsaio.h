@@ -178,6 +178,15 @@
 
 #define CPSAIO_AO_CALIBRATION_CLEAR_ALL		0x03
 
+/* Register Transaction */
+#define CPSAIO_REG_SPACE_NORMAL		0	///< Inp / Outp
+#define CPSAIO_REG_SPACE_ECU		1	///< EcuInp / EcuOutp
+#define CPSAIO_REG_SPACE_COMMAND	2	///< CommandInp / CommandOutp
+
+#define CPSAIO_REG_OP_READ		0	///< result = register
+#define CPSAIO_REG_OP_WRITE		1	///< register = val
+#define CPSAIO_REG_OP_MODIFY	2	///< result = register, register = ( result & ~mask ) | ( val & mask )
+
 #define AIS_BUSY	( 0x00000001 )
 #define AIS_START_TRG	( 0x00000002 )
 #define AIS_DATA_NUM	( 0x00000010 )
@@ -204,6 +213,18 @@ typedef struct __contec_cps_aio_int_callback_data__
 
 typedef void (*PCONTEC_CPS_AIO_INT_CALLBACK)(short, short, long, long, void *);
 
+typedef struct __contec_cps_aio_reg_transaction__
+{
+	unsigned char op;	///< CPSAIO_REG_OP_*
+	unsigned char space;	///< CPSAIO_REG_SPACE_*
+	unsigned char size;	///< 1, 2 or 4 byte
+	unsigned long addr;	///< Address
+	unsigned long val;	///< Write data
+	unsigned long mask;	///< Modify bits ( CPSAIO_REG_OP_MODIFY )
+	unsigned long result;	///< Read data ( CPSAIO_REG_OP_READ, CPSAIO_REG_OP_MODIFY )
+
+}CONTEC_CPS_AIO_REG_TRANSACTION, *PCONTEC_CPS_AIO_REG_TRANSACTION;
+
 /**** Common Functions ****/
 extern unsigned long ContecCpsAioInit( char *DeviceName, short *Id );
 extern unsigned long ContecCpsAioExit( short Id );
@@ -263,6 +284,11 @@ extern unsigned long ContecCpsAioSingleAo( short Id, short AoChannel, long AoDat
 extern unsigned long ContecCpsAioSingleAoEx( short Id, short AoChannel, double AoData );
 extern unsigned long ContecCpsAioMultiAo( short Id, short AoChannels, long AoData[] );
 extern unsigned long ContecCpsAioMultiAoEx( short Id, short AoChannels, double AoData[] );
+extern unsigned long ContecCpsAioStartAoDirect( short Id, short AoChannel );
+extern unsigned long ContecCpsAioStartAoDirectMulti( short Id, short AoChannels );
+extern unsigned long ContecCpsAioStopAoDirect( short Id );
+extern unsigned long ContecCpsAioAoDirect( short Id, long AoData[] );
+extern unsigned long ContecCpsAioAoDirectEx( short Id, double AoData[] );
 extern unsigned long ContecCpsAioSetAoSamplingClock( short Id, double AoSamplingClock );
 extern unsigned long ContecCpsAioSetAoEventSamplingTimes( short Id, unsigned long AoSamplingTimes );
 extern unsigned long ContecCpsAioSetAoCalibrationData( short Id, unsigned char select, unsigned char ch, unsigned char range, unsigned short data );
@@ -300,5 +326,7 @@ extern unsigned long ContecCpsAioCommandOutp( short Id, unsigned long addr, unsi
 extern unsigned long ContecCpsAioCommandOutpW( short Id, unsigned long addr, unsigned short value );
 extern unsigned long ContecCpsAioCommandOutpD( short Id, unsigned long addr, unsigned long value );
 
+extern unsigned long ContecCpsAioRegTransaction( short Id, CONTEC_CPS_AIO_REG_TRANSACTION Trans[], unsigned long Num, unsigned long *Done );
+
 
 #endif
@@ -24,6 +24,8 @@
 #define SSI_ERR_INFO_NOT_FIND_DEVICE	10051
 #define SSI_ERR_INFO_INVALID_INFOTYPE	10052
 
+#define SSI_ERR_OTHER		99900		///< マジックエラーナンバー
+
 #define SSIM_INTERRUPT	0x1300	///< Interrupt Message ID
 
 #define SSI_CHANNEL_3WIRE	0x00	///< 3-Wire
@@ -37,6 +39,11 @@
 
 #define CPSSSI_CALIBRATION_CLEAR_ALL		( CPSSSI_CALIBRATION_CLEAR_RAM | CPSSSI_CALIBRATION_CLEAR_ROM )	// ALL CLEAR FLAG
 
+/* Command Register Transaction */
+#define CPSSSI_REG_OP_READ		0	///< result = register
+#define CPSSSI_REG_OP_WRITE		1	///< register = val
+#define CPSSSI_REG_OP_MODIFY	2	///< result = register, register = ( result & ~mask ) | ( val & mask )
+
 /****  Structure ****/
 typedef struct __contec_cps_ssi_int_callback_data__
 {
@@ -50,6 +57,16 @@ typedef struct __contec_cps_ssi_int_callback_data__
 
 typedef void (*PCONTEC_CPS_SSI_INT_CALLBACK)(short, short, long, long, void *);
 
+typedef struct __contec_cps_ssi_reg_transaction__
+{
+	unsigned char op;	///< CPSSSI_REG_OP_*
+	unsigned long addr;	///< Address
+	unsigned char val;	///< Write data
+	unsigned char mask;	///< Modify bits ( CPSSSI_REG_OP_MODIFY )
+	unsigned char result;	///< Read data ( CPSSSI_REG_OP_READ, CPSSSI_REG_OP_MODIFY )
+
+}CONTEC_CPS_SSI_REG_TRANSACTION, *PCONTEC_CPS_SSI_REG_TRANSACTION;
+
 /**** Common Functions ****/
 extern unsigned long ContecCpsSsiInit( char *DeviceName, short *Id );
 extern unsigned long ContecCpsSsiExit( short Id );
@@ -88,6 +105,11 @@ extern unsigned long ContecCpsSsiReadCalibrationGain( short Id, double *value );
 extern unsigned long ContecCpsSsiReadCalibrationOffset( short Id, unsigned char ch, double *wire3Value, double *wire4Value );
 extern unsigned long ContecCpsSsiClearCalibrationData( short Id, int iClear );
 
+// Direct Input / Output Functions(Debug)
+extern unsigned long ContecCpsSsiCommandInp( short Id, unsigned long addr, unsigned char *value );
+extern unsigned long ContecCpsSsiCommandOutp( short Id, unsigned long addr, unsigned char value );
+extern unsigned long ContecCpsSsiCommandTransaction( short Id, CONTEC_CPS_SSI_REG_TRANSACTION Trans[], unsigned long Num, unsigned long *Done );
+
 // The Spell Misstake functions
 #define ContecCpsSsiSetSenceRegister ContecCpsSsiSetSenseResistor 
 #define ContecCpsSsiGetSenceRegister ContecCpsSsiGetSenseResistor
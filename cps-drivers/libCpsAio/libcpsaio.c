@@ -63,6 +63,36 @@ typedef struct __contec_cps_aio_int_callback__
 
 CONTEC_CPS_AIO_INT_CALLBACK_LIST contec_cps_aio_cb_list[CPS_DEVICE_MAX_NUM];
 
+#define CONTEC_CPSAIO_LIB_AI_MAX	10.0	// AI range ( -10V to +10V )
+#define CONTEC_CPSAIO_LIB_AI_MIN	-10.0
+#define CONTEC_CPSAIO_LIB_AO_MAX	20.0	// AO range ( 0mA to 20mA )
+#define CONTEC_CPSAIO_LIB_AO_MIN	0.0
+
+#define CONTEC_CPSAIO_LIB_AO_DIRECT_CHANNEL_NUM	16	// AO direct output : channels converted without malloc
+
+/*
+	Conversion table of a device.
+	  Analog input  : value = raw * aiScale + aiOffset
+	  Analog output : raw = value * aoScale + aoOffset
+	The coefficients are the nominal ones of the range ( no calibration is applied ).
+*/
+typedef struct __contec_cps_aio_conversion__{
+	short id;	// Device ID
+	unsigned char used;	// 1: built
+	unsigned long aiStatus;	// result of getting AI resolution
+	unsigned long aoStatus;	// result of getting AO resolution
+	unsigned short aiResolution;
+	unsigned short aoResolution;
+	double aiScale;
+	double aiOffset;
+	double aoScale;
+	double aoOffset;
+	short aoDirectChannel;	// AO direct output : first channel
+	short aoDirectChannels;	// AO direct output : number of channels ( 0: stopped )
+}CONTEC_CPS_AIO_CONVERSION, *PCONTEC_CPS_AIO_CONVERSION;
+
+static CONTEC_CPS_AIO_CONVERSION contec_cps_aio_conv_list[CPS_DEVICE_MAX_NUM];
+
 /**
 	@~English
 	@brief callback process function.(The running process is called to receive user's signal.)
@@ -300,6 +330,134 @@ unsigned long _contec_cpsaio_singlemulti_storeParam(short Id, unsigned char isOu
 	return ulRet;
 }
 
+/**
+	@~English
+	@brief find the conversion table of a device.
+	@param Id : Device ID
+	@return Success: conversion table , Failed: NULL
+	@~Japanese
+	@brief デバイスの変換テーブルを検索する内部関数。
+	@param Id : デバイスID
+	@return 成功: 変換テーブル , 失敗: NULL
+**/
+static PCONTEC_CPS_AIO_CONVERSION _contec_cpsaio_find_conversion( short Id )
+{
+	int cnt;
+
+	for( cnt = 0; cnt < CPS_DEVICE_MAX_NUM ; cnt ++ ){
+		if( contec_cps_aio_conv_list[cnt].used && contec_cps_aio_conv_list[cnt].id == Id )
+			return &contec_cps_aio_conv_list[cnt];
+	}
+
+	return (PCONTEC_CPS_AIO_CONVERSION)NULL;
+}
+
+/**
+	@~English
+	@brief leave the analog output direct mode.
+	@param Id : Device ID
+	@~Japanese
+	@brief アナログ出力のダイレクト出力モードを解除する内部関数。
+	@param Id : デバイスID
+**/
+static void _contec_cpsaio_leave_ao_direct( short Id )
+{
+	PCONTEC_CPS_AIO_CONVERSION conv = _contec_cpsaio_find_conversion( Id );
+
+	if( conv != (PCONTEC_CPS_AIO_CONVERSION)NULL )
+		conv->aoDirectChannels = 0;
+}
+
+/**
+	@~English
+	@brief build the conversion table of a device.
+	@param Id : Device ID
+	@return Success: conversion table , Failed: NULL
+	@~Japanese
+	@brief デバイスの変換テーブルを作成する内部関数。
+	@param Id : デバイスID
+	@return 成功: 変換テーブル , 失敗: NULL
+	@par 分解能は作成時に一度だけ取得し、レンジの公称の係数を計算します。
+**/
+static PCONTEC_CPS_AIO_CONVERSION _contec_cpsaio_build_conversion( short Id )
+{
+	PCONTEC_CPS_AIO_CONVERSION conv = (PCONTEC_CPS_AIO_CONVERSION)NULL;
+	int cnt;
+
+	for( cnt = 0; cnt < CPS_DEVICE_MAX_NUM ; cnt ++ ){
+		if( contec_cps_aio_conv_list[cnt].used && contec_cps_aio_conv_list[cnt].id == Id ){
+			conv = &contec_cps_aio_conv_list[cnt];
+			break;
+		}
+		if( conv == (PCONTEC_CPS_AIO_CONVERSION)NULL && !contec_cps_aio_conv_list[cnt].used )
+			conv = &contec_cps_aio_conv_list[cnt];
+	}
+
+	if( conv == (PCONTEC_CPS_AIO_CONVERSION)NULL ) return conv;
+
+	memset( conv, 0, sizeof(CONTEC_CPS_AIO_CONVERSION) );
+	conv->id = Id;
+	conv->aiStatus = ContecCpsAioGetAiResolution( Id, &conv->aiResolution );
+	conv->aoStatus = ContecCpsAioGetAoResolution( Id, &conv->aoResolution );
+
+	conv->aiScale = ( CONTEC_CPSAIO_LIB_AI_MAX - CONTEC_CPSAIO_LIB_AI_MIN ) / ldexp( 1.0, conv->aiResolution );
+	conv->aiOffset = CONTEC_CPSAIO_LIB_AI_MIN;
+	conv->aoScale = ldexp( 1.0, conv->aoResolution ) / ( CONTEC_CPSAIO_LIB_AO_MAX - CONTEC_CPSAIO_LIB_AO_MIN );
+	conv->aoOffset = -CONTEC_CPSAIO_LIB_AO_MIN * conv->aoScale;
+
+	conv->used = 1;
+
+	return conv;
+}
+
+/**
+	@~English
+	@brief get the conversion table of a device.
+	@param Id : Device ID
+	@param isOutput : "Analog Input" or "Analog Output" Flag
+	@param conv : conversion table
+	@return Success: AIO_ERR_SUCCESS
+	@~Japanese
+	@brief デバイスの変換テーブルを取得する内部関数。
+	@param Id : デバイスID
+	@param isOutput : "アナログ入力"か"アナログ出力"か
+	@param conv : 変換テーブル
+	@return 成功: AIO_ERR_SUCCESS
+	@par ContecCpsAioInit を使わずに取得したIDの場合はここで作成します。
+**/
+static unsigned long _contec_cpsaio_get_conversion( short Id, unsigned char isOutput, PCONTEC_CPS_AIO_CONVERSION *conv )
+{
+	*conv = _contec_cpsaio_find_conversion( Id );
+
+	if( *conv == (PCONTEC_CPS_AIO_CONVERSION)NULL )
+		*conv = _contec_cpsaio_build_conversion( Id );
+
+	if( *conv == (PCONTEC_CPS_AIO_CONVERSION)NULL )
+		return AIO_ERR_INI_MEMORY;
+
+	if( isOutput == CPS_AIO_INOUT_AO )
+		return (*conv)->aoStatus;
+
+	return (*conv)->aiStatus;
+}
+
+/**
+	@~English
+	@brief convert the physical value to the analog output data.
+	@param conv : conversion table
+	@param value : physical value
+	@return analog output data
+	@~Japanese
+	@brief 物理値をアナログ出力データに変換する内部関数。
+	@param conv : 変換テーブル
+	@param value : 物理値
+	@return アナログ出力データ
+**/
+static inline long _contec_cpsaio_ao_convert( PCONTEC_CPS_AIO_CONVERSION conv, double value )
+{
+	return (long)( value * conv->aoScale + conv->aoOffset );
+}
+
 
 /**
 	@~English
@@ -343,6 +501,12 @@ unsigned long ContecCpsAioInit( char *DeviceName, short *Id )
 
 	ulRet = ContecCpsAioResetDevice( *Id );
 
+	// build the conversion table ( resolution )
+	if( ulRet == AIO_ERR_SUCCESS ){
+		if( _contec_cpsaio_build_conversion( *Id ) == (PCONTEC_CPS_AIO_CONVERSION)NULL )
+			ulRet = AIO_ERR_INI_MEMORY;
+	}
+
 	// ioctl( *Id, IOCTL_CPSAIO_INIT, &arg);
 
 	// ContecCpsAioSetEcuSignal(*Id, AIOECU_DEST_AI_CLK, AIOECU_SRC_AI_CLK );
@@ -376,6 +540,7 @@ unsigned long ContecCpsAioExit( short Id )
 	struct cpsaio_ioctl_arg	arg;
 	unsigned long ulRet = AIO_ERR_SUCCESS;
 	int iRet = 0;
+	int cnt;
 
 	arg.val = 0;
 
@@ -384,6 +549,11 @@ unsigned long ContecCpsAioExit( short Id )
 	if( iRet < 0 )
 		ulRet = AIO_ERR_DLL_CALL_DRIVER;
 
+	for( cnt = 0; cnt < CPS_DEVICE_MAX_NUM ; cnt ++ ){
+		if( contec_cps_aio_conv_list[cnt].used && contec_cps_aio_conv_list[cnt].id == Id )
+			contec_cps_aio_conv_list[cnt].used = 0;
+	}
+
 	// close
 	close( Id );
 	return ulRet;
@@ -479,6 +649,8 @@ unsigned long ContecCpsAioResetDevice(short Id){
 	if( iRet < 0 )
 		return AIO_ERR_DLL_CALL_DRIVER;
 
+	_contec_cpsaio_leave_ao_direct( Id );
+
 	ulRet = ContecCpsAioSetEcuSignal(Id, AIOECU_DEST_AI_CLK, AIOECU_SRC_AI_CLK );
 	ulRet = ContecCpsAioSetEcuSignal(Id, AIOECU_DEST_AI_START, AIOECU_SRC_START );
 //	ulRet = ContecCpsAioSetEcuSignal(Id, AIOECU_DEST_AI_STOP, AIOECU_SRC_AI_STOP );
@@ -1277,9 +1449,8 @@ unsigned long ContecCpsAioGetAiSamplingDataEx( short Id, long *AiSamplingTimes,
 
 	long *tmpAiData = (long *) NULL;
 	long tmpAiCount = 0;
-	unsigned short AiResolution = 0;
 	int cnt = 0;
-	double dblMin, dblMax;
+	PCONTEC_CPS_AIO_CONVERSION conv;
 	unsigned long ulRet = AIO_ERR_SUCCESS;
 
 	// NULL Pointer Checks
@@ -1320,23 +1491,12 @@ unsigned long ContecCpsAioGetAiSamplingDataEx( short Id, long *AiSamplingTimes,
 	}
 
 	if( ulRet == AIO_ERR_SUCCESS ){
-		ulRet = ContecCpsAioGetAiResolution( Id, &AiResolution );
+		ulRet = _contec_cpsaio_get_conversion( Id, CPS_AIO_INOUT_AI, &conv );
 	}
 
 	if( ulRet == AIO_ERR_SUCCESS ){
-
-/*
-	ContecCpsAioGetAiRange( Id, &AiRange ); 
-	switch( AiRange ){
-		case PM10 :
-*/
-			dblMax = 10.0; dblMin = -10.0;
-/*
-			break;
-	}
-*/	
 		for( cnt = 0;cnt < *AiSamplingTimes; cnt ++){
-			AiData[cnt] =  (double)( tmpAiData[cnt] / pow(2.0,AiResolution) ) *(dblMax - dblMin) + dblMin;
+			AiData[cnt] = tmpAiData[cnt] * conv->aiScale + conv->aiOffset;
 		}
 	}
 
@@ -1484,9 +1644,8 @@ unsigned long ContecCpsAioSingleAiEx( short Id, short AiChannel, double *AiData
 {
 
 	long tmpAiData = 0;
-	unsigned short AiResolution = 0;
+	PCONTEC_CPS_AIO_CONVERSION conv;
 	unsigned long ulRet = AIO_ERR_SUCCESS;
-	double dblMin = 0.0, dblMax = 0.0;
 
 	// NULL Pointer Checks
 	if( AiData == (double *)NULL )
@@ -1495,21 +1654,11 @@ unsigned long ContecCpsAioSingleAiEx( short Id, short AiChannel, double *AiData
 	ulRet = ContecCpsAioSingleAi( Id, AiChannel, &tmpAiData );
 
 	if( ulRet == AIO_ERR_SUCCESS ){
-		ulRet = ContecCpsAioGetAiResolution( Id, &AiResolution );
+		ulRet = _contec_cpsaio_get_conversion( Id, CPS_AIO_INOUT_AI, &conv );
 	}
 
 	if( ulRet == AIO_ERR_SUCCESS ){
-/*
-	ContecCpsAioGetAiRange( Id, &AiRange ); 
-	switch( AiRange ){
-		case PM10 :
-*/
-			dblMax = 10.0; dblMin = -10.0;
-/*
-			break;
-	}
-*/	
-		*AiData =  (double)( tmpAiData / pow(2.0,AiResolution) ) *(dblMax - dblMin) + dblMin;
+		*AiData = tmpAiData * conv->aiScale + conv->aiOffset;
 	}
 
 	return ulRet;
@@ -1714,9 +1863,8 @@ unsigned long ContecCpsAioMultiAiEx( short Id, short AiChannels, double AiData[]
 {
 
 	long *tmpAiData;
-	unsigned short AiResolution = 0;
 	int cnt;
-	double dblMin, dblMax;
+	PCONTEC_CPS_AIO_CONVERSION conv;
 	unsigned long ulRet = AIO_ERR_SUCCESS;	
 
 	// NULL Pointer Checks
@@ -1732,22 +1880,12 @@ unsigned long ContecCpsAioMultiAiEx( short Id, short AiChannels, double AiData[]
 	ulRet = ContecCpsAioMultiAi( Id, AiChannels, tmpAiData );
 
 	if( ulRet == AIO_ERR_SUCCESS ){
-		ulRet = ContecCpsAioGetAiResolution( Id, &AiResolution );
+		ulRet = _contec_cpsaio_get_conversion( Id, CPS_AIO_INOUT_AI, &conv );
 	}
 
 	if( ulRet == AIO_ERR_SUCCESS ){
-/*
-	ContecCpsAioGetAiRange( Id, &AiRange ); 
-	switch( AiRange ){
-		case PM10 :
-*/
-			dblMax = 10.0; dblMin = -10.0;
-/*
-			break;
-	}
-*/	
 		for( cnt = 0;cnt < AiChannels; cnt ++){
-			AiData[cnt] =  (double)( tmpAiData[cnt] / pow(2.0,AiResolution) ) *(dblMax - dblMin) + dblMin;
+			AiData[cnt] = tmpAiData[cnt] * conv->aiScale + conv->aiOffset;
 		}
 	}
 
@@ -1858,6 +1996,9 @@ unsigned long ContecCpsAioSetAoChannels( short Id, short AoChannels )
 	unsigned long ulRet = AIO_ERR_SUCCESS;
 	int iRet = 0;
 
+	// the channel setting of direct output is overwritten.
+	_contec_cpsaio_leave_ao_direct( Id );
+
 	/* Multi only*/
 	_contec_cpsaio_set_exchange( Id, CPS_AIO_INOUT_AO, CONTEC_CPSAIO_LIB_EXCHANGE_MULTI );
 
@@ -1889,6 +2030,9 @@ unsigned long ContecCpsAioSetAoEventSamplingTimes( short Id, unsigned long AoSam
 	unsigned long ulRet = AIO_ERR_SUCCESS;
 	int iRet = 0;
 
+	// the sampling number of direct output is overwritten.
+	_contec_cpsaio_leave_ao_direct( Id );
+
 	/* Set Channel */
 	arg.val = AoSamplingTimes - 1 ;
 	iRet = ioctl( Id, IOCTL_CPSAIO_SET_SAMPNUM_AO, &arg );
@@ -1904,15 +2048,15 @@ unsigned long ContecCpsAioSetAoEventSamplingTimes( short Id, unsigned long AoSam
 //----- Running Functions ------
 /**
 	@~English
-	@brief AIO Library start analog output sampling.
+	@brief start analog output sampling.( keep the direct mode )
 	@param Id : Device ID
 	@return Success: AIO_ERR_SUCCESS
 	@~Japanese
-	@brief アナログ出力サンプリングの開始。
+	@brief アナログ出力サンプリングを開始する内部関数。( ダイレクト出力モードを解除しない )
 	@param Id : デバイスID
 	@return 成功: AIO_ERR_SUCCESS
 **/
-unsigned long ContecCpsAioStartAo( short Id )
+static unsigned long _contec_cpsaio_start_ao( short Id )
 {
 
 	struct cpsaio_ioctl_arg	arg;
@@ -1938,6 +2082,24 @@ unsigned long ContecCpsAioStartAo( short Id )
 
 }
 
+/**
+	@~English
+	@brief AIO Library start analog output sampling.
+	@param Id : Device ID
+	@return Success: AIO_ERR_SUCCESS
+	@~Japanese
+	@brief アナログ出力サンプリングの開始。
+	@param Id : デバイスID
+	@return 成功: AIO_ERR_SUCCESS
+	@par メモリ方式の出力を開始するため、ダイレクト出力モードは解除します。
+**/
+unsigned long ContecCpsAioStartAo( short Id )
+{
+	_contec_cpsaio_leave_ao_direct( Id );
+
+	return _contec_cpsaio_start_ao( Id );
+}
+
 /**
 	@~English
 	@brief AIO Library stop analog output sampling.
@@ -2054,6 +2216,9 @@ unsigned long ContecCpsAioSingleAo( short Id, short AoChannel, long AoData )
 		return AIO_ERR_PTR_AO_CHANNELS;// chaneel error
 	}
 
+	// the channel setting of direct output is overwritten.
+	_contec_cpsaio_leave_ao_direct( Id );
+
 	// Exchange Transfer Mode Single Ao
 	ulRet = _contec_cpsaio_set_exchange( Id, CPS_AIO_INOUT_AO, CONTEC_CPSAIO_LIB_EXCHANGE_SINGLE );
 
@@ -2107,25 +2272,13 @@ unsigned long ContecCpsAioSingleAoEx( short Id, short AoChannel, double AoData )
 {
 
 	long tmpAoData = 0;
-	unsigned short AoResolution = 0;
+	PCONTEC_CPS_AIO_CONVERSION conv;
 	unsigned long ulRet = AIO_ERR_SUCCESS;
-	double dblMin, dblMax;
 
-	ulRet = ContecCpsAioGetAoResolution( Id, &AoResolution );
+	ulRet = _contec_cpsaio_get_conversion( Id, CPS_AIO_INOUT_AO, &conv );
 
 	if( ulRet == AIO_ERR_SUCCESS ){
-/*
-	ContecCpsAioGetAoRange( Id, &AoRange ); 
-	switch( AoRange ){
-		case PM10 :
-*/
-			dblMax = 20.0; dblMin = 0.0;
-/*
-			break;
-	}
-*/
-
-		tmpAoData = (long)( (AoData - dblMin) * pow(2.0, AoResolution) / (dblMax - dblMin) );
+		tmpAoData = _contec_cpsaio_ao_convert( conv, AoData );
 	
 		ulRet = ContecCpsAioSingleAo( Id, AoChannel, tmpAoData );
 	}
@@ -2168,6 +2321,9 @@ unsigned long ContecCpsAioMultiAo( short Id, short AoChannels, long AoData[] )
 	if( AoChannels > AoMaxChannel )
 		return AIO_ERR_OTHER;// channel error
 
+	// the channel setting of direct output is overwritten.
+	_contec_cpsaio_leave_ao_direct( Id );
+
 	ulRet = ContecCpsAioSetAoChannels(Id, AoChannels );
 
 	if( ulRet == AIO_ERR_SUCCESS ){
@@ -2215,9 +2371,8 @@ unsigned long ContecCpsAioMultiAoEx( short Id, short AoChannels, double AoData[]
 {
 
 	long *tmpAoData;
-	unsigned short AoResolution = 0;
 	int cnt = 0;
-	double dblMin = 0.0, dblMax = 0.0;
+	PCONTEC_CPS_AIO_CONVERSION conv;
 	unsigned long ulRet = AIO_ERR_SUCCESS;
 
 	// NULL Pointer Checks
@@ -2230,22 +2385,11 @@ unsigned long ContecCpsAioMultiAoEx( short Id, short AoChannels, double AoData[]
 		return AIO_ERR_INI_MEMORY;
 	}
 
-	ulRet = ContecCpsAioGetAoResolution( Id, &AoResolution );
+	ulRet = _contec_cpsaio_get_conversion( Id, CPS_AIO_INOUT_AO, &conv );
 
 	if( ulRet == AIO_ERR_SUCCESS ){	
-
-/*
-	ContecCpsAioGetAoRange( Id, &AoRange ); 
-	switch( AoRange ){
-		case PM10 :
-*/
-			dblMax = 20.0; dblMin = 0.0;
-/*
-			break;
-	}
-*/	
 		for( cnt = 0;cnt < AoChannels; cnt ++){
-			tmpAoData[cnt] = (long)( (AoData[cnt] - dblMin) * pow(2.0, AoResolution) / (dblMax - dblMin) );
+			tmpAoData[cnt] = _contec_cpsaio_ao_convert( conv, AoData[cnt] );
 		}
 
 		ulRet = ContecCpsAioMultiAo( Id, AoChannels, tmpAoData );
@@ -2256,6 +2400,231 @@ unsigned long ContecCpsAioMultiAoEx( short Id, short AoChannels, double AoData[]
 	return ulRet;
 }
 
+/**
+	@~English
+	@brief AIO Library start the analog output direct mode.( single channel )
+	@param Id : Device ID
+	@param AoChannel : set the Data Channel
+	@return Success: AIO_ERR_SUCCESS
+	@~Japanese
+	@brief アナログ出力のダイレクト出力モードを開始する関数。(単一チャネル)
+	@param Id : デバイスID
+	@param AoChannel : チャネル番号
+	@return 成功: AIO_ERR_SUCCESS
+	@par チャネルと転送モードを一度だけ設定します。以降は ContecCpsAioAoDirect でデータだけを書き込みます。
+**/
+unsigned long ContecCpsAioStartAoDirect( short Id, short AoChannel )
+{
+	struct cpsaio_ioctl_arg	arg;
+	short AoMaxChannel = 0;
+	PCONTEC_CPS_AIO_CONVERSION conv;
+	unsigned long ulRet = AIO_ERR_SUCCESS;
+	int iRet = 0;
+
+	ulRet = ContecCpsAioGetAoMaxChannels(Id, &AoMaxChannel);
+
+	if( ulRet != AIO_ERR_SUCCESS )
+		return ulRet;
+
+	if( AoChannel < 0 || AoChannel >= AoMaxChannel )
+		return AIO_ERR_AO_CHANNEL;
+
+	ulRet = _contec_cpsaio_get_conversion( Id, CPS_AIO_INOUT_AO, &conv );
+
+	if( ulRet != AIO_ERR_SUCCESS )
+		return ulRet;
+
+	conv->aoDirectChannels = 0;
+
+	// Exchange Transfer Mode Single Ao
+	ulRet = _contec_cpsaio_set_exchange( Id, CPS_AIO_INOUT_AO, CONTEC_CPSAIO_LIB_EXCHANGE_SINGLE );
+
+	if( ulRet == AIO_ERR_SUCCESS ){
+		// Set Ao Channel
+		arg.val = AoChannel;
+		iRet = ioctl( Id, IOCTL_CPSAIO_SETCHANNEL_AO, &arg );
+
+		if( iRet < 0 )
+			ulRet = AIO_ERR_DLL_CALL_DRIVER;
+	}
+
+	if( ulRet == AIO_ERR_SUCCESS ){
+		// Set Sampling Number
+		ulRet = ContecCpsAioSetAoEventSamplingTimes( Id, 1 );
+	}
+
+	if( ulRet == AIO_ERR_SUCCESS ){
+		conv->aoDirectChannel = AoChannel;
+		conv->aoDirectChannels = 1;
+	}
+
+	return ulRet;
+}
+
+/**
+	@~English
+	@brief AIO Library start the analog output direct mode.( multiple channels )
+	@param Id : Device ID
+	@param AoChannels : set the Data Channels
+	@return Success: AIO_ERR_SUCCESS
+	@~Japanese
+	@brief アナログ出力のダイレクト出力モードを開始する関数。(複数チャネル)
+	@param Id : デバイスID
+	@param AoChannels : チャネル数
+	@return 成功: AIO_ERR_SUCCESS
+	@par チャネル 0 から AoChannels - 1 までを一度に更新します。
+**/
+unsigned long ContecCpsAioStartAoDirectMulti( short Id, short AoChannels )
+{
+	short AoMaxChannel = 0;
+	PCONTEC_CPS_AIO_CONVERSION conv;
+	unsigned long ulRet = AIO_ERR_SUCCESS;
+
+	ulRet = ContecCpsAioGetAoMaxChannels(Id, &AoMaxChannel);
+
+	if( ulRet != AIO_ERR_SUCCESS )
+		return ulRet;
+
+	if( AoChannels <= 0 || AoChannels > AoMaxChannel )
+		return AIO_ERR_AO_CHANNELS;
+
+	ulRet = _contec_cpsaio_get_conversion( Id, CPS_AIO_INOUT_AO, &conv );
+
+	if( ulRet != AIO_ERR_SUCCESS )
+		return ulRet;
+
+	conv->aoDirectChannels = 0;
+
+	ulRet = ContecCpsAioSetAoChannels(Id, AoChannels );
+
+	if( ulRet == AIO_ERR_SUCCESS ){
+		// Set Sampling Number
+		ulRet = ContecCpsAioSetAoEventSamplingTimes( Id, 1 );
+	}
+
+	if( ulRet == AIO_ERR_SUCCESS ){
+		conv->aoDirectChannel = 0;
+		conv->aoDirectChannels = AoChannels;
+	}
+
+	return ulRet;
+}
+
+/**
+	@~English
+	@brief AIO Library stop the analog output direct mode.
+	@param Id : Device ID
+	@return Success: AIO_ERR_SUCCESS
+	@~Japanese
+	@brief アナログ出力のダイレクト出力モードを終了する関数。
+	@param Id : デバイスID
+	@return 成功: AIO_ERR_SUCCESS
+**/
+unsigned long ContecCpsAioStopAoDirect( short Id )
+{
+	_contec_cpsaio_leave_ao_direct( Id );
+
+	return AIO_ERR_SUCCESS;
+}
+
+/**
+	@~English
+	@brief AIO Library output data by the analog output direct mode.( long type )
+	@param Id : Device ID
+	@param AoData : Data array of analog output ( number of channels set by direct mode )
+	@return Success: AIO_ERR_SUCCESS
+	@~Japanese
+	@brief ダイレクト出力モードでアナログ出力データを出力する関数。(整数型)
+	@param Id : デバイスID
+	@param AoData : アナログ出力データ配列 ( ダイレクト出力モードで設定したチャネル数 )
+	@return 成功: AIO_ERR_SUCCESS , ダイレクト出力モードでない場合: AIO_ERR_NOT_START
+	@par 1回の更新はチャネルごとの OUTDATA と StartAo 、 StopAo のドライバ呼び出しです。ドライバに一括書き込みがないため、 ContecCpsAioMultiAo に比べて省けるのはチャネル数とサンプリング数の設定だけです。
+	@par ContecCpsAioSetAoChannels 、 ContecCpsAioSetAoEventSamplingTimes 、 ContecCpsAioStartAo 、 ContecCpsAioSingleAo 、 ContecCpsAioMultiAo 、 ContecCpsAioResetDevice を呼び出すとダイレクト出力モードは解除されます。
+**/
+unsigned long ContecCpsAioAoDirect( short Id, long AoData[] )
+{
+	struct cpsaio_ioctl_arg	arg;
+	PCONTEC_CPS_AIO_CONVERSION conv;
+	unsigned long ulRet = AIO_ERR_SUCCESS;
+	int cnt = 0;
+	int iRet = 0;
+
+	// NULL Pointer Checks
+	if( AoData == ( long * )NULL )
+		return AIO_ERR_PTR_AO_DATA;
+
+	conv = _contec_cpsaio_find_conversion( Id );
+
+	if( conv == (PCONTEC_CPS_AIO_CONVERSION)NULL || conv->aoDirectChannels == 0 )
+		return AIO_ERR_NOT_START;
+
+	for( cnt = 0;cnt < conv->aoDirectChannels; cnt ++ ){
+		arg.val = AoData[cnt];
+		iRet = ioctl( Id, IOCTL_CPSAIO_OUTDATA, &arg );
+		if( iRet < 0 ){
+			ulRet = AIO_ERR_DLL_CALL_DRIVER;
+			break;
+		}
+	}
+
+	if( ulRet == AIO_ERR_SUCCESS ){
+		// Ao Start ( keep the direct mode )
+		ulRet = _contec_cpsaio_start_ao( Id );
+	}
+
+	// Ao Stop
+	ContecCpsAioStopAo( Id );
+
+	return ulRet;
+}
+
+/**
+	@~English
+	@brief AIO Library output data by the analog output direct mode.( double type )
+	@param Id : Device ID
+	@param AoData : Data array of analog output ( number of channels set by direct mode )
+	@return Success: AIO_ERR_SUCCESS
+	@~Japanese
+	@brief ダイレクト出力モードでアナログ出力データを出力する関数。(浮動小数点型)
+	@param Id : デバイスID
+	@param AoData : アナログ出力データ配列 ( ダイレクト出力モードで設定したチャネル数 )
+	@return 成功: AIO_ERR_SUCCESS , ダイレクト出力モードでない場合: AIO_ERR_NOT_START
+**/
+unsigned long ContecCpsAioAoDirectEx( short Id, double AoData[] )
+{
+	long tmpAoData[CONTEC_CPSAIO_LIB_AO_DIRECT_CHANNEL_NUM];
+	long *pAoData = tmpAoData;
+	PCONTEC_CPS_AIO_CONVERSION conv;
+	unsigned long ulRet = AIO_ERR_SUCCESS;
+	int cnt = 0;
+
+	// NULL Pointer Checks
+	if( AoData == ( double * )NULL )
+		return AIO_ERR_PTR_AO_DATA;
+
+	conv = _contec_cpsaio_find_conversion( Id );
+
+	if( conv == (PCONTEC_CPS_AIO_CONVERSION)NULL || conv->aoDirectChannels == 0 )
+		return AIO_ERR_NOT_START;
+
+	if( conv->aoDirectChannels > CONTEC_CPSAIO_LIB_AO_DIRECT_CHANNEL_NUM ){
+		pAoData = (long*)malloc( sizeof(long) * conv->aoDirectChannels );
+		if( pAoData == (long *) NULL )
+			return AIO_ERR_INI_MEMORY;
+	}
+
+	for( cnt = 0;cnt < conv->aoDirectChannels; cnt ++ ){
+		pAoData[cnt] = _contec_cpsaio_ao_convert( conv, AoData[cnt] );
+	}
+
+	ulRet = ContecCpsAioAoDirect( Id, pAoData );
+
+	if( pAoData != tmpAoData )
+		free(pAoData);
+
+	return ulRet;
+}
+
 /**
 	@~English
 	@brief AIO Library set destination and source signals by E Control unit.
@@ -3342,3 +3711,122 @@ unsigned long ContecCpsAioCommandOutpD( short Id, unsigned long addr, unsigned l
 	return ulRet;
 }
 
+
+/**
+	@~English
+	@brief access the register of a transaction.
+	@param Id : Device ID
+	@param trans : transaction
+	@param isWrite : read or write
+	@param value : Values
+	@return Success: AIO_ERR_SUCCESS
+	@~Japanese
+	@brief トランザクションのレジスタにアクセスする内部関数。
+	@param Id : デバイスID
+	@param trans : トランザクション
+	@param isWrite : 読み出しか書き出しか
+	@param value : 値
+	@return 成功: AIO_ERR_SUCCESS
+**/
+static unsigned long _contec_cpsaio_reg_access( short Id, PCONTEC_CPS_AIO_REG_TRANSACTION trans, int isWrite, unsigned long *value )
+{
+	struct cpsaio_direct_arg arg;
+	struct cpsaio_direct_command_arg cmdarg;
+	unsigned long mask;
+	int iRet = 0;
+
+	if( trans->size == 1 )	mask = 0xFF;
+	else if( trans->size == 2 )	mask = 0xFFFF;
+	else	mask = 0xFFFFFFFF;
+
+	if( trans->space == CPSAIO_REG_SPACE_NORMAL ){
+		memset(&arg, 0, sizeof(struct cpsaio_direct_arg));
+		arg.addr = trans->addr;
+		if( isWrite ){
+			arg.val = *value & mask;
+			iRet = ioctl( Id, IOCTL_CPSAIO_DIRECT_OUTPUT, &arg );
+		}else{
+			iRet = ioctl( Id, IOCTL_CPSAIO_DIRECT_INPUT, &arg );
+			*value = arg.val & mask;
+		}
+	}else{
+		memset(&cmdarg, 0, sizeof(struct cpsaio_direct_command_arg));
+		cmdarg.addr = trans->addr;
+		cmdarg.isEcu = ( trans->space == CPSAIO_REG_SPACE_ECU );
+		cmdarg.size = trans->size;
+		if( isWrite ){
+			cmdarg.val = *value & mask;
+			iRet = ioctl( Id, IOCTL_CPSAIO_DIRECT_COMMAND_OUTPUT, &cmdarg );
+		}else{
+			iRet = ioctl( Id, IOCTL_CPSAIO_DIRECT_COMMAND_INPUT, &cmdarg );
+			*value = cmdarg.val & mask;
+		}
+	}
+
+	if( iRet < 0 )
+		return AIO_ERR_DLL_CALL_DRIVER;
+
+	return AIO_ERR_SUCCESS;
+}
+
+/**
+	@~English
+	@brief AIO Library run the list of register transactions.
+	@param Id : Device ID
+	@param Trans : transactions
+	@param Num : number of transactions
+	@param Done : number of finished transactions
+	@return Success: AIO_ERR_SUCCESS
+	@~Japanese
+	@brief デバイスのレジスタ(通常、ECU、COMMAND)へのアクセスをまとめて実行する関数。
+	@param Id : デバイスID
+	@param Trans : トランザクション配列
+	@param Num : トランザクション数
+	@param Done : 完了したトランザクション数
+	@return 成功: AIO_ERR_SUCCESS
+	@par 1件ずつ既存のダイレクト入出力のドライバ呼び出しで実行します。ドライバ呼び出しの回数は減りませんが、読み出し・変更・書き込みをまとめて記述できます。
+	@par エラーが発生した場合はそのトランザクションで中断します。Done は中断したトランザクションの番号です。
+**/
+unsigned long ContecCpsAioRegTransaction( short Id, CONTEC_CPS_AIO_REG_TRANSACTION Trans[], unsigned long Num, unsigned long *Done )
+{
+	unsigned long cnt;
+	unsigned long value;
+	unsigned long ulRet = AIO_ERR_SUCCESS;
+
+	// NULL Pointer Checks
+	if( Trans == ( PCONTEC_CPS_AIO_REG_TRANSACTION )NULL || Done == ( unsigned long * )NULL )
+		return AIO_ERR_OTHER;
+
+	*Done = 0;
+
+	for( cnt = 0; cnt < Num ; cnt ++ ){
+		if( Trans[cnt].op > CPSAIO_REG_OP_MODIFY ||
+			Trans[cnt].space > CPSAIO_REG_SPACE_COMMAND ||
+			( Trans[cnt].size != 1 && Trans[cnt].size != 2 && Trans[cnt].size != 4 ) )
+			return AIO_ERR_OTHER;
+	}
+
+	for( cnt = 0; cnt < Num ; cnt ++ ){
+		switch( Trans[cnt].op ){
+		case CPSAIO_REG_OP_READ:
+			ulRet = _contec_cpsaio_reg_access( Id, &Trans[cnt], 0, &Trans[cnt].result );
+			break;
+		case CPSAIO_REG_OP_WRITE:
+			value = Trans[cnt].val;
+			ulRet = _contec_cpsaio_reg_access( Id, &Trans[cnt], 1, &value );
+			break;
+		case CPSAIO_REG_OP_MODIFY:
+			ulRet = _contec_cpsaio_reg_access( Id, &Trans[cnt], 0, &Trans[cnt].result );
+			if( ulRet == AIO_ERR_SUCCESS ){
+				value = ( Trans[cnt].result & ~Trans[cnt].mask ) | ( Trans[cnt].val & Trans[cnt].mask );
+				ulRet = _contec_cpsaio_reg_access( Id, &Trans[cnt], 1, &value );
+			}
+			break;
+		}
+		if( ulRet != AIO_ERR_SUCCESS )
+			break;
+		*Done = cnt + 1;
+	}
+
+	return ulRet;
+}
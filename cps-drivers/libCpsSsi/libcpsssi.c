@@ -1239,3 +1239,101 @@ unsigned long ContecCpsSsiCommandOutp( short Id, unsigned long addr, unsigned ch
 
 	return ulRet;
 }
+
+/**
+	@~English
+	@brief SSI Library access the command register of a transaction.
+	@param Id : Device ID
+	@param addr : Address
+	@param isWrite : read or write
+	@param value : Values
+	@return Success: SSI_ERR_SUCCESS
+	@~Japanese
+	@brief トランザクションのCOMMANDアドレスレジスタにアクセスする内部関数。
+	@param Id : デバイスID
+	@param addr : アドレス
+	@param isWrite : 読み出しか書き出しか
+	@param value : 値
+	@return 成功: SSI_ERR_SUCCESS
+**/
+static unsigned long _contec_cpsssi_command_access( short Id, unsigned long addr, int isWrite, unsigned char *value )
+{
+	struct cpsssi_direct_command_arg arg;
+	int iRet = 0;
+
+	memset(&arg, 0, sizeof(struct cpsssi_direct_command_arg));
+
+	arg.addr = addr;
+	if( isWrite ){
+		arg.val = (unsigned long)*value;
+		iRet = ioctl( Id, IOCTL_CPSSSI_DIRECT_COMMAND_OUTPUT, &arg );
+	}else{
+		iRet = ioctl( Id, IOCTL_CPSSSI_DIRECT_COMMAND_INPUT, &arg );
+		*value = (unsigned char)arg.val;
+	}
+
+	if( iRet < 0 )
+		return SSI_ERR_DLL_CALL_DRIVER;
+
+	return SSI_ERR_SUCCESS;
+}
+
+/**
+	@~English
+	@brief SSI Library run the list of command register transactions.
+	@param Id : Device ID
+	@param Trans : transactions
+	@param Num : number of transactions
+	@param Done : number of finished transactions
+	@return Success: SSI_ERR_SUCCESS
+	@~Japanese
+	@brief デバイスのCOMMANDアドレスレジスタへのアクセスをまとめて実行する関数。
+	@param Id : デバイスID
+	@param Trans : トランザクション配列
+	@param Num : トランザクション数
+	@param Done : 完了したトランザクション数
+	@return 成功: SSI_ERR_SUCCESS
+	@par 1件ずつ既存のダイレクト入出力のドライバ呼び出しで実行します。ドライバ呼び出しの回数は減りませんが、読み出し・変更・書き込みをまとめて記述できます。
+	@par エラーが発生した場合はそのトランザクションで中断します。Done は中断したトランザクションの番号です。
+**/
+unsigned long ContecCpsSsiCommandTransaction( short Id, CONTEC_CPS_SSI_REG_TRANSACTION Trans[], unsigned long Num, unsigned long *Done )
+{
+	unsigned long cnt;
+	unsigned char value;
+	unsigned long ulRet = SSI_ERR_SUCCESS;
+
+	// NULL Pointer Checks
+	if( Trans == ( PCONTEC_CPS_SSI_REG_TRANSACTION )NULL || Done == ( unsigned long * )NULL )
+		return SSI_ERR_OTHER;
+
+	*Done = 0;
+
+	for( cnt = 0; cnt < Num ; cnt ++ ){
+		if( Trans[cnt].op > CPSSSI_REG_OP_MODIFY )
+			return SSI_ERR_OTHER;
+	}
+
+	for( cnt = 0; cnt < Num ; cnt ++ ){
+		switch( Trans[cnt].op ){
+		case CPSSSI_REG_OP_READ:
+			ulRet = _contec_cpsssi_command_access( Id, Trans[cnt].addr, 0, &Trans[cnt].result );
+			break;
+		case CPSSSI_REG_OP_WRITE:
+			value = Trans[cnt].val;
+			ulRet = _contec_cpsssi_command_access( Id, Trans[cnt].addr, 1, &value );
+			break;
+		case CPSSSI_REG_OP_MODIFY:
+			ulRet = _contec_cpsssi_command_access( Id, Trans[cnt].addr, 0, &Trans[cnt].result );
+			if( ulRet == SSI_ERR_SUCCESS ){
+				value = ( Trans[cnt].result & ~Trans[cnt].mask ) | ( Trans[cnt].val & Trans[cnt].mask );
+				ulRet = _contec_cpsssi_command_access( Id, Trans[cnt].addr, 1, &value );
+			}
+			break;
+		}
+		if( ulRet != SSI_ERR_SUCCESS )
+			break;
+		*Done = cnt + 1;
+	}
+
+	return ulRet;
+}
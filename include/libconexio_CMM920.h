@@ -87,6 +87,11 @@ typedef unsigned long DWORD,*LPDWORD;
 #define CONEXIO_CMM920_SFDNUM_0	( 0 )		///< SFD Number 0
 #define CONEXIO_CMM920_SFDNUM_1	( 1 )		///< SFD Number 1
 
+#define CONEXIO_CMM920_CRC_CHECK_OFF	0	///< CRC check Off
+#define CONEXIO_CMM920_CRC_CHECK_ON	1	///< CRC check On ( drop telegrams with a CRC error )
+
+typedef struct __conexioCMM920_context *CONEXIO920HANDLE;	///< instance handle
+
 typedef struct __conexioCMM920_packet{
 	BYTE dle;		///< DLE
 	BYTE stx;		///< STX
@@ -99,6 +104,191 @@ typedef struct __conexioCMM920_packet{
 	BYTE etx;	///< ETX
 } CONEXIO920PACKET, *PCONEXIO920PACKET;
 
+typedef struct __conexioCMM920_rtt{
+	unsigned long count;	///< number of responses
+	unsigned long timeout;	///< number of timeouts
+	long last;	///< last round trip time (usec)
+	long min;	///< minimum round trip time (usec)
+	long max;	///< maximum round trip time (usec)
+	long long total;	///< total round trip time (usec) ( average = total / count )
+} CONEXIO920RTT, *PCONEXIO920RTT;
+
+typedef struct __conexioCMM920_wait_profile{
+	BYTE mode;	///< CMM920 mode
+	BYTE command;	///< CMM920 command
+	unsigned long samples;	///< number of learned responses ( reset by timeout )
+	unsigned long timeout;	///< number of timeouts
+	long expected;	///< expected round trip time (usec) ( EWMA )
+	long deviation;	///< round trip time deviation (usec) ( EWMA )
+	long deadline;	///< current response deadline (usec)
+} CONEXIO920WAITPROFILE, *PCONEXIO920WAITPROFILE;
+
+typedef struct __conexioCMM920_stat{
+	unsigned long frames_sent;	///< number of sent frames
+	unsigned long frames_recv;	///< number of received frames
+	unsigned long long bytes_sent;	///< number of sent bytes
+	unsigned long long bytes_recv;	///< number of received bytes
+	unsigned long telegrams_sent;	///< number of sent telegrams
+	unsigned long telegrams_recv;	///< number of received telegrams
+	unsigned long frame_errors;	///< number of broken frames ( size, footer or check sum error )
+	unsigned long crc_errors;	///< number of telegrams dropped by the CRC check
+	unsigned long timeouts;	///< number of response timeouts
+	unsigned long recv_drop;	///< number of telegrams dropped by the full receive queue
+	unsigned long pool_get;	///< number of frames taken from the frame pool ( all instances )
+	unsigned long pool_empty;	///< number of frame pool allocation failures ( all instances )
+	int pool_peak;	///< maximum number of frames in use at once ( all instances )
+} CONEXIO920STAT, *PCONEXIO920STAT;
+
+#define CONEXIO_CMM920_TRACE_OFF	0	///< Trace Off
+#define CONEXIO_CMM920_TRACE_RING	1	///< Trace to ring buffer
+#define CONEXIO_CMM920_TRACE_TEXT	2	///< Trace to ring buffer and syslog ( rate limited )
+
+#define CONEXIO_CMM920_TRACE_DIR_SEND	0	///< Trace Send Frame
+#define CONEXIO_CMM920_TRACE_DIR_RECV	1	///< Trace Receive Frame
+
+#define CONEXIO_CMM920_TRACE_DATA_MAX	128	///< Trace data size ( longer frames are truncated )
+
+typedef struct __conexioCMM920_trace{
+	unsigned long seq;	///< sequence number
+	long sec;	///< time ( CLOCK_MONOTONIC sec )
+	long usec;	///< time ( CLOCK_MONOTONIC usec )
+	BYTE dir;	///< CONEXIO_CMM920_TRACE_DIR_SEND or CONEXIO_CMM920_TRACE_DIR_RECV
+	unsigned short length;	///< frame length
+	BYTE data[CONEXIO_CMM920_TRACE_DATA_MAX];	///< frame data
+} CONEXIO920TRACE, *PCONEXIO920TRACE;
+
+/// telegram callback ( buf : data, size : data size, r_channel : receive channel, rx_pwr : receive power, arg : argument )
+typedef void (*CONEXIO920RECVCALLBACK)( BYTE buf[], int size, int r_channel, int rx_pwr, void *arg );
+
+/// transmit queue callback ( id : request id, result : 0 success, -7 timeout, other send error, buf : response data, size : response size, arg : argument )
+typedef void (*CONEXIO920TXCALLBACK)( int id, int result, BYTE buf[], int size, void *arg );
+
+typedef struct __conexioCMM920_txq_stat{
+	long dest_addr;	///< dest address
+	unsigned long sent;	///< number of sends ( including retries )
+	unsigned long response;	///< number of responses
+	unsigned long retry;	///< number of retries
+	unsigned long timeout;	///< number of timeouts ( after all retries )
+	int depth;	///< number of queued and in-flight telegrams
+	long rtt_last;	///< last round trip time (usec)
+	long rtt_min;	///< minimum round trip time (usec)
+	long rtt_max;	///< maximum round trip time (usec)
+	long long rtt_total;	///< total round trip time (usec) ( average = rtt_total / response )
+} CONEXIO920TXQSTAT, *PCONEXIO920TXQSTAT;
+
+#define CONEXIO_CMM920_LINK_ADAPTIVE_OFF	0	///< transmit queue uses the fixed retry count and timeout
+#define CONEXIO_CMM920_LINK_ADAPTIVE_ON	1	///< transmit queue adapts the retry count and timeout to the link
+
+typedef struct __conexioCMM920_link{
+	long addr;	///< node address
+	unsigned long recv;	///< number of received telegrams
+	int channel;	///< last receive channel
+	int rssi_last;	///< last receive power (dBm)
+	int rssi_avg;	///< receive power average (0.1dBm) ( EWMA )
+	unsigned long sent;	///< number of sends waiting for the response ( including retries )
+	unsigned long lost;	///< number of sends without the response
+	int loss_rate;	///< loss rate (1/1000) ( EWMA )
+	unsigned long rtt_samples;	///< number of round trip time samples
+	long rtt_avg;	///< round trip time average (usec) ( EWMA )
+	long rtt_dev;	///< round trip time deviation (usec) ( EWMA )
+	int retry;	///< adaptive retry count
+	long timeout;	///< adaptive response timeout (usec)
+} CONEXIO920LINK, *PCONEXIO920LINK;
+
+#define CONEXIO_CMM920_TXQ_PRIORITY_LOW	0	///< transmit queue priority low ( 0 - 255, higher first )
+#define CONEXIO_CMM920_TXQ_PRIORITY_NORMAL	1	///< transmit queue priority normal ( conexio_cmm920_txq_send )
+#define CONEXIO_CMM920_TXQ_PRIORITY_HIGH	2	///< transmit queue priority high
+
+typedef struct __conexioCMM920_airtime{
+	long bitrate;	///< bit rate (bps)
+	long window_msec;	///< budget window (msec)
+	long budget_msec;	///< airtime budget in the window (msec) ( 0 : no limit )
+	long long used_usec;	///< airtime in the window (usec)
+	long long queued_usec;	///< airtime of the telegrams waiting in the transmit queue (usec)
+	unsigned long sent;	///< number of sent telegrams
+	long long total_usec;	///< total airtime (usec)
+	unsigned long rejected;	///< number of sends rejected by the budget
+	unsigned long deferred;	///< number of transmit queue telegrams deferred by the budget
+} CONEXIO920AIRTIME, *PCONEXIO920AIRTIME;
+
+#define CONEXIO_CMM920_LSI_OP_WRITE	0	///< LSI transaction write
+#define CONEXIO_CMM920_LSI_OP_READ	1	///< LSI transaction read
+#define CONEXIO_CMM920_LSI_OP_VERIFY	2	///< LSI transaction read and compare ( ( result & mask ) == ( value & mask ) )
+
+#define CONEXIO_CMM920_LSI_VERIFY_ERROR	(-3)	///< LSI transaction verify mismatch
+
+typedef struct __conexioCMM920_lsi_op{
+	BYTE op;	///< CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSI_OP_READ or CONEXIO_CMM920_LSI_OP_VERIFY
+	unsigned long lsi_addr;	///< LSI address
+	unsigned short value;	///< write value or expected value
+	unsigned short mask;	///< verify mask
+	unsigned short result;	///< read value ( read and verify )
+} CONEXIO920LSIOP, *PCONEXIO920LSIOP;
+
+#define CONEXIO_CMM920_XFER_HEAD_SIZE	6	///< fragment header size ( type, id, index(2), count(2) )
+#define CONEXIO_CMM920_XFER_FRAG_DATA	192	///< fragment data size
+#define CONEXIO_CMM920_XFER_FRAG_MAX	1024	///< maximum number of fragments per transfer
+#define CONEXIO_CMM920_XFER_SIZE_MAX	( CONEXIO_CMM920_XFER_FRAG_DATA * CONEXIO_CMM920_XFER_FRAG_MAX )	///< maximum transfer size
+#define CONEXIO_CMM920_XFER_WINDOW_MAX	8	///< maximum number of fragments per window
+
+typedef struct __conexioCMM920_xfer_stat{
+	unsigned long bytes;	///< transferred data bytes
+	unsigned long fragments;	///< number of fragments
+	unsigned long sent;	///< number of sent fragments ( including retransmissions ) or received fragments ( including duplicates )
+	unsigned long retransmit;	///< number of retransmitted fragments
+	unsigned long duplicate;	///< number of duplicate fragments ( receive )
+	unsigned long ack;	///< number of acknowledges ( sent or received )
+	unsigned long timeout;	///< number of acknowledge timeouts ( send )
+	long elapsed;	///< transfer time (usec)
+	long goodput;	///< effective goodput (bit/sec) ( bytes * 8 / elapsed )
+} CONEXIO920XFERSTAT, *PCONEXIO920XFERSTAT;
+
+typedef struct __conexioCMM920_xfer{
+	BYTE *buf;	///< reassembly buffer ( allocated by caller )
+	int capacity;	///< reassembly buffer size
+	int size;	///< received data size
+	int id;	///< current transfer id ( -1 : none )
+	int done_id;	///< last completed transfer id ( -1 : none )
+	int count;	///< number of fragments of current transfer
+	int received;	///< number of received fragments of current transfer
+	BYTE map[CONEXIO_CMM920_XFER_FRAG_MAX / 8];	///< received fragment bitmap
+	long start_sec;	///< first fragment receive time ( CLOCK_MONOTONIC sec )
+	long start_nsec;	///< first fragment receive time ( CLOCK_MONOTONIC nsec )
+	CONEXIO920XFERSTAT stat;	///< statistics of the last transfer
+} CONEXIO920XFER, *PCONEXIO920XFER;
+
+#define CONEXIO_CMM920_TLM_CH_MAX	32	///< maximum number of telemetry value channels
+#define CONEXIO_CMM920_TLM_DIO_MAX	64	///< maximum number of telemetry DIO bits
+#define CONEXIO_CMM920_TLM_HISTORY	8	///< number of frames kept as delta reference ( encoder pending / decoder history, power of 2 )
+#define CONEXIO_CMM920_TLM_SIZE_MAX	( 3 + CONEXIO_CMM920_TLM_CH_MAX / 8 + CONEXIO_CMM920_TLM_CH_MAX * 10 + CONEXIO_CMM920_TLM_DIO_MAX / 8 )	///< maximum encoded frame size
+
+#define CONEXIO_CMM920_TLM_FLAG_KEY	0x80	///< telemetry key frame ( absolute values )
+#define CONEXIO_CMM920_TLM_FLAG_DIO	0x40	///< telemetry frame includes DIO bits
+
+typedef struct __conexioCMM920_tlm{
+	int ch_num;	///< number of value channels
+	int dio_num;	///< number of DIO bits
+	long deadband[CONEXIO_CMM920_TLM_CH_MAX];	///< deadband per channel ( 0 : send every change )
+	long ref[CONEXIO_CMM920_TLM_CH_MAX];	///< reference values ( last acknowledged frame )
+	BYTE ref_dio[CONEXIO_CMM920_TLM_DIO_MAX / 8];	///< reference DIO bits ( last acknowledged frame )
+	int pend_valid[CONEXIO_CMM920_TLM_HISTORY];	///< pending snapshot is valid
+	BYTE pend_seq[CONEXIO_CMM920_TLM_HISTORY];	///< pending snapshot sequence number
+	long pend[CONEXIO_CMM920_TLM_HISTORY][CONEXIO_CMM920_TLM_CH_MAX];	///< values of the recently encoded frames as seen by the decoder
+	BYTE pend_dio[CONEXIO_CMM920_TLM_HISTORY][CONEXIO_CMM920_TLM_DIO_MAX / 8];	///< DIO bits of the recently encoded frames
+	int ref_valid;	///< reference is valid ( 0 : next frame is a key frame )
+	BYTE ref_seq;	///< sequence number of the reference frame
+	BYTE seq;	///< sequence number of the last encoded frame
+} CONEXIO920TLM, *PCONEXIO920TLM;
+
+typedef struct __conexioCMM920_tlm_decoder{
+	int ch_num;	///< number of value channels
+	int dio_num;	///< number of DIO bits
+	int valid[CONEXIO_CMM920_TLM_HISTORY];	///< history entry is valid
+	BYTE seq[CONEXIO_CMM920_TLM_HISTORY];	///< history sequence number
+	long value[CONEXIO_CMM920_TLM_HISTORY][CONEXIO_CMM920_TLM_CH_MAX];	///< history values
+	BYTE dio[CONEXIO_CMM920_TLM_HISTORY][CONEXIO_CMM920_TLM_DIO_MAX / 8];	///< history DIO bits
+} CONEXIO920TLMDEC, *PCONEXIO920TLMDEC;
+
 /* FC */
 #define CONEXIO_CMM920_MHR_FC( srcmode, ver, destmode, sqnsupp, panidcomp, ar, pending, sec, type )	\
 	( (WORD) (srcmode << 14)| (ver << 12) | \
@@ -108,24 +298,52 @@ typedef struct __conexioCMM920_packet{
 			(type) \
 	)
 
-#define CONEXIO_CMM920_MHR_FC_DESTADDRMODE( fc )	( (fc & 0xC000) >> 14 )
+#define CONEXIO_CMM920_MHR_FC_DESTADDRMODE( fc )	( (fc & 0x0C00) >> 10 )
 
 #define CONEXIO_CMM920_MHR_FC_DESTADDRMODE_NONE	0
 #define CONEXIO_CMM920_MHR_FC_DESTADDRMODE_8BIT	1
 #define CONEXIO_CMM920_MHR_FC_DESTADDRMODE_16BIT	2
 #define CONEXIO_CMM920_MHR_FC_DESTADDRMODE_64BIT	3
 
-#define CONEXIO_CMM920_MHR_FC_SRCADDRMODE( fc )	( (fc & 0x0C00) >> 10 )
+#define CONEXIO_CMM920_MHR_FC_SRCADDRMODE( fc )	( (fc & 0xC000) >> 14 )
 
 #define CONEXIO_CMM920_MHR_FC_SRCADDRMODE_NONE	0
 #define CONEXIO_CMM920_MHR_FC_SRCADDRMODE_8BIT	1
 #define CONEXIO_CMM920_MHR_FC_SRCADDRMODE_16BIT	2
 #define CONEXIO_CMM920_MHR_FC_SRCADDRMODE_64BIT	3
 
+#define CONEXIO_CMM920_MHR_FC_PANIDCOMP( fc )	( (fc & 0x0040) >> 6 )
+
+#define CONEXIO_CMM920_MHR_LAYOUT_NUM	32	///< number of MHR layouts ( dest mode x source mode x PAN ID compression )
+
+typedef struct __conexioCMM920_mhr_layout{
+	BYTE valid;	///< layout is supported ( 64bit address is not supported )
+	BYTE size;	///< header size ( frame control + sequence number + PAN IDs + addresses )
+	BYTE dest_id;	///< dest PAN ID offset ( 0 : none )
+	BYTE dest_addr;	///< dest address offset
+	BYTE dest_addr_size;	///< dest address size ( 0 : none )
+	BYTE src_id;	///< source PAN ID offset ( 0 : none )
+	BYTE src_addr;	///< source address offset
+	BYTE src_addr_size;	///< source address size ( 0 : none )
+} CONEXIO920MHRLAYOUT, *PCONEXIO920MHRLAYOUT;
+
+typedef struct __conexioCMM920_mhr_view{
+	const CONEXIO920MHRLAYOUT *layout;	///< header layout
+	unsigned short fc;	///< frame control
+	BYTE seq_no;	///< sequence number
+	unsigned short dest_id;	///< dest PAN ID
+	unsigned short src_id;	///< source PAN ID ( dest PAN ID with PAN ID compression )
+	long dest_addr;	///< dest address
+	long src_addr;	///< source address
+	BYTE *payload;	///< payload ( points into the decoded buffer )
+	int size;	///< payload size
+} CONEXIO920MHRVIEW, *PCONEXIO920MHRVIEW;
+
 // function
 extern int conexio_cmm920_init(char* PortName);
 extern int conexio_cmm920_exit();
 extern int conexio_cmm920_reset();
+extern int conexio_cmm920_refresh_config(void);
 extern int conexio_cmm920_mode(BYTE isWrite , int *code);
 extern int conexio_cmm920_address(BYTE isWrite, unsigned short *panId, BYTE Addr[], unsigned short *shortAddr );
 extern int conexio_cmm920_wireless(BYTE isWrite, BYTE *bitrate, BYTE *channel, BYTE *power, char *sendSenceLvl, char *recvSenceLvl, unsigned short *sendSenceTim, BYTE *sendSenceNum, BYTE *ackRetryNum, unsigned short *ackWaitTim);
@@ -165,6 +383,46 @@ extern int conexio_cmm920_get_auto_ack_frame( unsigned short *phr, unsigned char
 extern int conexio_cmm920_get_antenna( BYTE *antennaMode );
 
 extern void conexio_cmm920_set_hop_mode( BYTE hop );
+extern int conexio_cmm920_lsi_transaction( PCONEXIO920LSIOP ops, int num, int *fail_index );
+extern int conexio_cmm920_lsi_profile( BYTE hop, int *fail_index );
+extern int conexio_cmm920_xfer_init( PCONEXIO920XFER xfer, BYTE buf[], int capacity );
+extern int conexio_cmm920_xfer_send( BYTE buf[], int size, int hop, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr, int window, int timeout_msec, int retry, PCONEXIO920XFERSTAT stat );
+extern int conexio_cmm920_xfer_recv( PCONEXIO920XFER xfer, int hop, int timeout_msec );
+
+extern int conexio_cmm920_set_timeout( BYTE mode, BYTE command, int msec );
+extern int conexio_cmm920_get_timeout( BYTE mode, BYTE command, int *msec );
+extern int conexio_cmm920_get_command_rtt( BYTE mode, BYTE command, PCONEXIO920RTT rtt );
+extern void conexio_cmm920_reset_command_rtt( void );
+extern int conexio_cmm920_get_wait_profile( PCONEXIO920WAITPROFILE profile, int num );
+extern void conexio_cmm920_get_stat( PCONEXIO920STAT stat );
+extern int conexio_cmm920_set_crc_check( int mode );
+extern unsigned int conexio_cmm920_crc32( unsigned int crc, const BYTE buf[], int size );
+extern void conexio_cmm920_reset_stat( void );
+
+extern int conexio_cmm920_set_trace( int level );
+extern int conexio_cmm920_get_trace( void );
+extern int conexio_cmm920_set_trace_rate( int rate );
+extern int conexio_cmm920_trace_read( PCONEXIO920TRACE trace, int num );
+extern int conexio_cmm920_trace_dump( void );
+
+extern int conexio_cmm920_start_recv_thread( CONEXIO920RECVCALLBACK callback, void *arg );
+extern int conexio_cmm920_stop_recv_thread( void );
+extern unsigned long conexio_cmm920_get_recv_drop_count( void );
+
+extern int conexio_cmm920_txq_start( int window, int timeout_msec, int retry, CONEXIO920TXCALLBACK callback, void *arg );
+extern int conexio_cmm920_txq_stop( void );
+extern int conexio_cmm920_txq_send( BYTE buf[], int size, int send_mode, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr );
+extern int conexio_cmm920_txq_get_depth( int *pending, int *inflight );
+extern int conexio_cmm920_txq_get_stat( long dest_addr, PCONEXIO920TXQSTAT stat );
+extern int conexio_cmm920_set_link_adaptive( int mode );
+extern int conexio_cmm920_get_link( long addr, PCONEXIO920LINK link );
+extern int conexio_cmm920_get_link_list( PCONEXIO920LINK link, int num );
+extern void conexio_cmm920_reset_link( void );
+extern int conexio_cmm920_txq_send_priority( BYTE buf[], int size, int send_mode, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr, int priority );
+extern long conexio_cmm920_airtime_usec( int size );
+extern int conexio_cmm920_set_airtime_budget( long window_msec, long budget_msec );
+extern long long conexio_cmm920_get_airtime_wait( int size, int priority );
+extern void conexio_cmm920_get_airtime( PCONEXIO920AIRTIME airtime );
 
 //extern int conexio_cmm920_set_address_default();
 extern int conexio_cmm920_set_wireless_default();
@@ -172,6 +430,98 @@ extern int conexio_cmm920_set_timer_default();
 extern int conexio_cmm920_set_auto_ack_frame_default();
 
 
+// multi hop header function
+extern const CONEXIO920MHRLAYOUT* conexio_cmm920_mhr_layout( unsigned short fc );
+extern int conexio_cmm920_mhr_encode( BYTE mhr[], unsigned short fc, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr );
+extern int conexio_cmm920_mhr_decode( BYTE buf[], int size, PCONEXIO920MHRVIEW view );
+
+// telemetry function
+extern int conexio_cmm920_tlm_init( PCONEXIO920TLM tlm, int ch_num, int dio_num );
+extern int conexio_cmm920_tlm_set_deadband( PCONEXIO920TLM tlm, int ch, long deadband );
+extern void conexio_cmm920_tlm_reset( PCONEXIO920TLM tlm );
+extern int conexio_cmm920_tlm_encode( PCONEXIO920TLM tlm, long value[], BYTE dio[], BYTE buf[], int size );
+extern int conexio_cmm920_tlm_ack( PCONEXIO920TLM tlm, BYTE seq );
+extern int conexio_cmm920_tlm_decoder_init( PCONEXIO920TLMDEC dec, int ch_num, int dio_num );
+extern int conexio_cmm920_tlm_decode( PCONEXIO920TLMDEC dec, BYTE buf[], int size, long value[], BYTE dio[], BYTE *seq );
+
+// handle function
+extern CONEXIO920HANDLE conexio_cmm920_open(char* PortName);
+extern int conexio_cmm920_close(CONEXIO920HANDLE ctx);
+extern CONEXIO920HANDLE conexio_cmm920_default_handle(void);
+extern int conexio_cmm920_init_h( CONEXIO920HANDLE ctx, char* PortName );
+extern int conexio_cmm920_exit_h( CONEXIO920HANDLE ctx );
+extern int conexio_cmm920_get_last_error_h( CONEXIO920HANDLE ctx );
+extern int conexio_cmm920_reset_h( CONEXIO920HANDLE ctx );
+extern int conexio_cmm920_refresh_config_h( CONEXIO920HANDLE ctx );
+extern int conexio_cmm920_mode_h( CONEXIO920HANDLE ctx, BYTE isWrite , int *code );
+extern int conexio_cmm920_address_h( CONEXIO920HANDLE ctx, BYTE isWrite, unsigned short *panId, BYTE Addr[], unsigned short *shortAddr );
+extern int conexio_cmm920_wireless_h( CONEXIO920HANDLE ctx, BYTE isWrite, BYTE *bitrate, BYTE *channel, BYTE *power, char *sendSenceLvl, char *recvSenceLvl, unsigned short *sendSenceTim, BYTE *sendSenceNum, BYTE *ackRetryNum, unsigned short *ackWaitTim );
+extern int conexio_cmm920_timer_h( CONEXIO920HANDLE ctx, BYTE isWrite, unsigned short *tim );
+extern int conexio_cmm920_auto_ack_frame_h( CONEXIO920HANDLE ctx, BYTE isWrite, unsigned short *phr, unsigned char *fc_upper );
+extern int conexio_cmm920_antenna_h( CONEXIO920HANDLE ctx, BYTE isWrite, BYTE *antennaMode );
+extern int conexio_cmm920_version_h( CONEXIO920HANDLE ctx, int *ver, int *rev );
+extern int conexio_cmm920_lsi_h( CONEXIO920HANDLE ctx, unsigned long lsi_addr, int isWrite, unsigned short *value );
+extern int conexio_cmm920_lsi_data_preamble_bit_len_h( CONEXIO920HANDLE ctx, int isWrite, BYTE length );
+extern int conexio_cmm920_lsi_data_whitening_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable );
+extern int conexio_cmm920_lsi_diversity_enable_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable );
+extern int conexio_cmm920_lsi_mhr_mode_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable );
+extern int conexio_cmm920_lsi_crc_calc_inverse_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable );
+extern int conexio_cmm920_lsi_s_panid_filter_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable );
+extern int conexio_cmm920_lsi_d_panid_filter_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable );
+extern int conexio_cmm920_lsi_d_address_filter_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable );
+extern int conexio_cmm920_lsi_data_sfd_h( CONEXIO920HANDLE ctx, int isWrite, unsigned short address, BYTE sfd_no );
+extern int conexio_cmm920_data_send_single_h( CONEXIO920HANDLE ctx, BYTE buf[], int size, int send_mode, BYTE r_buf[] );
+extern int conexio_cmm920_data_send_multi_h( CONEXIO920HANDLE ctx, BYTE buf[], int size, int send_mode, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr, BYTE r_buf[] );
+extern int conexio_cmm920_data_recv_h( CONEXIO920HANDLE ctx, BYTE buf[], int *size, int hop, int *r_channel, int *rx_pwr, unsigned int *crc_val );
+extern int conexio_cmm920_data_recv_single_h( CONEXIO920HANDLE ctx, BYTE buf[], int *size, int *r_channel, int *rx_pwr, unsigned int *crc_val );
+extern int conexio_cmm920_data_recv_multi_h( CONEXIO920HANDLE ctx, BYTE buf[], int *size, int *r_channel, int *rx_pwr, unsigned int *crc_val, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr );
+extern int conexio_cmm920_set_timeout_h( CONEXIO920HANDLE ctx, BYTE mode, BYTE command, int msec );
+extern int conexio_cmm920_get_timeout_h( CONEXIO920HANDLE ctx, BYTE mode, BYTE command, int *msec );
+extern int conexio_cmm920_get_command_rtt_h( CONEXIO920HANDLE ctx, BYTE mode, BYTE command, PCONEXIO920RTT rtt );
+extern void conexio_cmm920_reset_command_rtt_h( CONEXIO920HANDLE ctx );
+extern int conexio_cmm920_get_wait_profile_h( CONEXIO920HANDLE ctx, PCONEXIO920WAITPROFILE profile, int num );
+extern void conexio_cmm920_get_stat_h( CONEXIO920HANDLE ctx, PCONEXIO920STAT stat );
+extern int conexio_cmm920_set_crc_check_h( CONEXIO920HANDLE ctx, int mode );
+extern void conexio_cmm920_reset_stat_h( CONEXIO920HANDLE ctx );
+extern int conexio_cmm920_start_recv_thread_h( CONEXIO920HANDLE ctx, CONEXIO920RECVCALLBACK callback, void *arg );
+extern int conexio_cmm920_stop_recv_thread_h( CONEXIO920HANDLE ctx );
+extern unsigned long conexio_cmm920_get_recv_drop_count_h( CONEXIO920HANDLE ctx );
+extern int conexio_cmm920_txq_start_h( CONEXIO920HANDLE ctx, int window, int timeout_msec, int retry, CONEXIO920TXCALLBACK callback, void *arg );
+extern int conexio_cmm920_txq_stop_h( CONEXIO920HANDLE ctx );
+extern int conexio_cmm920_txq_send_h( CONEXIO920HANDLE ctx, BYTE buf[], int size, int send_mode, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr );
+extern int conexio_cmm920_txq_get_depth_h( CONEXIO920HANDLE ctx, int *pending, int *inflight );
+extern int conexio_cmm920_txq_get_stat_h( CONEXIO920HANDLE ctx, long dest_addr, PCONEXIO920TXQSTAT stat );
+extern int conexio_cmm920_set_link_adaptive_h( CONEXIO920HANDLE ctx, int mode );
+extern int conexio_cmm920_get_link_h( CONEXIO920HANDLE ctx, long addr, PCONEXIO920LINK link );
+extern int conexio_cmm920_get_link_list_h( CONEXIO920HANDLE ctx, PCONEXIO920LINK link, int num );
+extern void conexio_cmm920_reset_link_h( CONEXIO920HANDLE ctx );
+extern int conexio_cmm920_txq_send_priority_h( CONEXIO920HANDLE ctx, BYTE buf[], int size, int send_mode, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr, int priority );
+extern long conexio_cmm920_airtime_usec_h( CONEXIO920HANDLE ctx, int size );
+extern int conexio_cmm920_set_airtime_budget_h( CONEXIO920HANDLE ctx, long window_msec, long budget_msec );
+extern long long conexio_cmm920_get_airtime_wait_h( CONEXIO920HANDLE ctx, int size, int priority );
+extern void conexio_cmm920_get_airtime_h( CONEXIO920HANDLE ctx, PCONEXIO920AIRTIME airtime );
+extern int conexio_cmm920_set_mode_h( CONEXIO920HANDLE ctx, int code );
+extern int conexio_cmm920_set_address_h( CONEXIO920HANDLE ctx, unsigned short panId, BYTE Addr[], unsigned short shortAddr );
+extern int conexio_cmm920_set_wireless_h( CONEXIO920HANDLE ctx, int iBitrate, BYTE channel, BYTE power, char sendLv, char recvLv, unsigned short sendTim, BYTE sendNum, BYTE ackRetryNum, unsigned short ackWaitTim );
+extern int conexio_cmm920_set_timer_h( CONEXIO920HANDLE ctx, unsigned short tim );
+extern int conexio_cmm920_set_auto_ack_frame_h( CONEXIO920HANDLE ctx, unsigned short phr, unsigned char fc_upper );
+extern int conexio_cmm920_set_antenna_h( CONEXIO920HANDLE ctx, BYTE antennaMode );
+extern int conexio_cmm920_get_mode_h( CONEXIO920HANDLE ctx, int *code );
+extern int conexio_cmm920_get_address_h( CONEXIO920HANDLE ctx, unsigned short *panId, BYTE Addr[], unsigned short *shortAddr );
+extern int conexio_cmm920_get_wireless_h( CONEXIO920HANDLE ctx, int *iBitrate, BYTE *channel, BYTE *power, char *sendLv, char *recvLv, unsigned short *sendTim, BYTE *sendNum, BYTE *ackRetryNum, unsigned short *ackWaitTim );
+extern int conexio_cmm920_get_timer_h( CONEXIO920HANDLE ctx, unsigned short *tim );
+extern int conexio_cmm920_get_auto_ack_frame_h( CONEXIO920HANDLE ctx, unsigned short *phr, unsigned char *fc_upper );
+extern int conexio_cmm920_get_antenna_h( CONEXIO920HANDLE ctx, BYTE *antennaMode );
+extern void conexio_cmm920_set_hop_mode_h( CONEXIO920HANDLE ctx, BYTE hop );
+extern int conexio_cmm920_lsi_transaction_h( CONEXIO920HANDLE ctx, PCONEXIO920LSIOP ops, int num, int *fail_index );
+extern int conexio_cmm920_lsi_profile_h( CONEXIO920HANDLE ctx, BYTE hop, int *fail_index );
+extern int conexio_cmm920_xfer_send_h( CONEXIO920HANDLE ctx, BYTE buf[], int size, int hop, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr, int window, int timeout_msec, int retry, PCONEXIO920XFERSTAT stat );
+extern int conexio_cmm920_xfer_recv_h( CONEXIO920HANDLE ctx, PCONEXIO920XFER xfer, int hop, int timeout_msec );
+extern int conexio_cmm920_mhr_encode_h( CONEXIO920HANDLE ctx, BYTE mhr[], unsigned short fc, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr );
+extern int conexio_cmm920_set_wireless_default_h( CONEXIO920HANDLE ctx );
+extern int conexio_cmm920_set_auto_ack_frame_default_h( CONEXIO920HANDLE ctx );
+extern int conexio_cmm920_set_timer_default_h( CONEXIO920HANDLE ctx );
+
 // Internal( private function )
 
 BYTE _calc_Hex2Bcd( BYTE hex );
@@ -188,6 +538,13 @@ int RecvTelegramSingleHop(BYTE buf[], int *size , int *r_channel, int *rx_pwr ,
 int RecvTelegram(BYTE buf[], int *size , int hop, int *r_channel, int *rx_pwr , unsigned int *crc, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr);
 int RecvCommandAck( BYTE *buf, int *size , BYTE mode, BYTE command );
 
+int addMHR_h( CONEXIO920HANDLE ctx, BYTE pktBuf[] , unsigned short fc, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr );
+int SendTelegram_h( CONEXIO920HANDLE ctx, BYTE buf[], int size, int hop, int send_mode, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr );
+int RecvTelegram_h( CONEXIO920HANDLE ctx, BYTE buf[], int *size , int hop, int *r_channel, int *rx_pwr, unsigned int *crc ,unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr );
+int RecvTelegramSingleHop_h( CONEXIO920HANDLE ctx, BYTE buf[], int *size , int *r_channel, int *rx_pwr , unsigned int *crc );
+int SendCommand_h( CONEXIO920HANDLE ctx, BYTE buf[], int size, BYTE mode, BYTE command );
+int RecvCommandAck_h( CONEXIO920HANDLE ctx, BYTE *buf, int *size , BYTE mode, BYTE command );
+
 PCONEXIO920PACKET allocConexioCMM920_packet(PCONEXIO920PACKET pac, BYTE mode, BYTE com, BYTE isSend);
 void freeConexioCMM920_packet(PCONEXIO920PACKET pac);
 BYTE* pktGetBYTEArray(PCONEXIO920PACKET pac, int size,int *retSize);
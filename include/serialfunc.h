@@ -8,17 +8,65 @@
 #ifndef _SERIALFUNC_H_
 #define _SERIALFUNC_H_
 
+#include <sys/uio.h>
+
+#define SERIAL_STATISTICS_VERSION	2
+
+/* Serial_SetRs485 AiEnable */
+#define SERIAL_RS485_DISABLE	0	// disable
+#define SERIAL_RS485_ENABLE	1	// enable by the driver ( TIOCSRS485 ) only
+#define SERIAL_RS485_ENABLE_SOFTWARE	2	// enable, RTS is switched by the library if the driver does not support TIOCSRS485
+#define SERIAL_STAT_LATENCY_BUCKETS	16
+
+/* Serial line statistics ( all members are unsigned long / long )
+   ulGeneration is odd while the block is being updated. A reader copies the
+   block only when ulGeneration is even and is the same before and after the
+   copy ( Serial_GetStatistics does this; shared-memory readers must too ). */
+typedef struct __serial_statistics__{
+	unsigned long ulVersion;	// SERIAL_STATISTICS_VERSION
+	unsigned long ulGeneration;	// update generation ( odd : updating )
+	unsigned long ulBytesIn;	// received bytes
+	unsigned long ulBytesOut;	// sent bytes
+	unsigned long ulFramesIn;	// responses ( first data received after a send )
+	unsigned long ulFramesOut;	// send requests
+	unsigned long ulReadCalls;	// read() system calls
+	unsigned long ulWriteCalls;	// write()/writev() system calls
+	unsigned long ulFrameErr;	// TIOCGICOUNT frame
+	unsigned long ulOverrunErr;	// TIOCGICOUNT overrun
+	unsigned long ulParityErr;	// TIOCGICOUNT parity
+	unsigned long ulBreak;	// TIOCGICOUNT brk
+	unsigned long ulBufOverrunErr;	// TIOCGICOUNT buf_overrun
+	long lLatencyLast;	// send complete to first response byte (usec)
+	long lLatencyMax;
+	unsigned long ulLatency[SERIAL_STAT_LATENCY_BUCKETS];	// [0] < 128usec, [n] < (128 << n) usec, last : others
+	long lTurnaroundLast;	// RS485 tcdrain complete to RTS off (usec), software control only
+	long lTurnaroundMax;
+}SERIAL_STATISTICS, *PSERIAL_STATISTICS;
+
 extern int Serial_PortOpen_Half( char *AsDev, long AlSpeed, int AiLength, int AiStop, int AiParity , int AiWait, int AiBlockMode);
 extern int Serial_PortOpen_Func( char *AsDev, long AlSpeed, int AiLength, int AiStop, int AiParity ,int AiWait, int AiOpenMode, int AiFlow);
+extern int Serial_PortOpen_Pty( char *AsSlaveName, int AiLen );
 extern void Serial_PortSetParameter(int AiPort, int AiSpeed, int AiLength, int AiStop, int AiParity, int AiWait, int AiFlow);
 extern void Serial_PortClose( int AiPort );
 extern int Serial_PutChar( int AiPort, unsigned char AcChar );
 extern unsigned char Serial_GetChar( int AiPort );
 extern int Serial_GetString( int AiPort, unsigned char *AsBuffer, int AiLen );
 extern int Serial_PutString( int AiPort, unsigned char *AsBuffer, int AiLen );
+extern int Serial_PutStringV( int AiPort, const struct iovec *AsIov, int AiCnt );
+extern int Serial_SetCoalesce( int AiPort, long AlUsec );
+extern int Serial_QueueString( int AiPort, unsigned char *AsBuffer, int AiLen );
+extern int Serial_FlushQueue( int AiPort );
+extern int Serial_Drain( int AiPort, long *AlUsec );
 extern int Serial_SumCheck( char *AsBuffer, int AiLen, int AiComplement );
 extern void Serial_Set_Rts( int AiPort, int AiValue );
 extern void Serial_Set_Dtr( int AiPort, int AiValue );
+extern int Serial_SetRs485( int AiPort, int AiEnable, long AlDelayBeforeUsec, long AlDelayAfterUsec );
+extern int Serial_GetRs485Turnaround( int AiPort, long *AlLast, long *AlMax );
+extern int Serial_GetStatistics( int AiPort, PSERIAL_STATISTICS AsStat, int AiSample );
+extern int Serial_ResetStatistics( int AiPort );
+extern int Serial_SetStatisticsInterval( int AiPort, long AlMsec );
+extern int Serial_StatisticsShmOpen( int AiPort, const char *AsName );
+extern int Serial_StatisticsShmClose( int AiPort );
 extern void Serial_Get_Lsr( int AiPort, int *AiValue );
 extern int Serial_Get_Ri( int AiPort );
 extern int Serial_Get_Dcd( int AiPort );
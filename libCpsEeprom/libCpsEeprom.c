@@ -5,6 +5,8 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
 #include "libCpsEeprom.h"
 
 /* EEPROM offset address define */
@@ -24,6 +26,10 @@
 
 static char cEepromFilePath[256] = "/sys/bus/i2c/devices/1-0050/eeprom";	/* EEPROM file path */
 
+static char cEepromCache[256];	/* EEPROM image cache */
+static int iEepromCacheValid = 0;	/* 1: cEepromCache holds the image of cEepromFilePath */
+static pthread_mutex_t EepromCacheMutex = PTHREAD_MUTEX_INITIALIZER;	/* cache and file path lock */
+
 /*
  * @brief read EEPROM data
  */
@@ -49,6 +55,91 @@ char *buf)	/* (OUT) 
 	return retcd;
 }
 
+/*
+ * @brief read EEPROM data from the cache
+ *        (the device file is read on first use and after invalidation)
+ */
+static int ReadEEPROMcache(
+char *buf)	/* (OUT) 256byte Stored buffer */
+{
+	int retcd = 0;
+
+	pthread_mutex_lock(&EepromCacheMutex);
+	if (!iEepromCacheValid) {
+		retcd = ReadEEPROMdata(cEepromCache);
+		if (retcd == 0) {
+			iEepromCacheValid = 1;
+		}
+	}
+	if (retcd == 0) {
+		memcpy(buf, cEepromCache, 256);
+	}
+	pthread_mutex_unlock(&EepromCacheMutex);
+
+	return retcd;
+}
+
+/*
+ * @brief decode a string field
+ *        (not printable characters are replaced with 0)
+ */
+static void DecodeString(
+char *out,		/* (OUT) string (size + 1 byte or more) */
+const char *in,	/* (IN) EEPROM field */
+int size)		/* (IN) field size */
+{
+	int i;
+
+	memcpy(out, in, size);
+	for (i=0; i<size; i++) {
+		if (out[i] < 0x20 || out[i] > 0x7f) {
+			out[i] = 0;
+		}
+	}
+	out[i] = 0;
+}
+
+/*
+ * @brief decode a 16bit big endian field
+ */
+static short DecodeShort(
+const char *in)	/* (IN) EEPROM field (2byte) */
+{
+	return (short)(((unsigned char)in[0] << 8) | (unsigned char)in[1]);
+}
+
+/*
+ * @brief decode calibration data
+ */
+static void DecodeCaribration(
+const char *in,	/* (IN) EEPROM field (8 channel * 4byte) */
+short *sOffet,	/* (OUT) Offset Data (8 channnel) */
+short *sGain)	/* (OUT) Gain Data  (8 channnel) */
+{
+	int i;
+
+	for (i=0; i<8; i++) {
+		sOffet[i] = DecodeShort(&in[i * 4]);
+		sGain[i] = DecodeShort(&in[i * 4 + 2]);
+	}
+}
+
+/*
+ * @brief decode FPGA revision (BCD yyyy mm dd to yyyymmdd)
+ */
+static long DecodeFPGARevision(
+const char *in)	/* (IN) EEPROM field (4byte) */
+{
+	const unsigned char *bcd = (const unsigned char *)in;
+	int	year, month, day;
+
+	year = (((bcd[0] >> 4) & 0xf) * 1000) + ((bcd[0] & 0xf) * 100) + (((bcd[1] >> 4) & 0xf) * 10) + (bcd[1] & 0xf);
+	month = (((bcd[2] >> 4) & 0xf) * 10) + (bcd[2] & 0xf);
+	day = (((bcd[3] >> 4) & 0xf) * 10) + (bcd[3] & 0xf);
+
+	return (year * 10000L) + (month * 100) + day;
+}
+
 /*
  * @brief Set EEPROM file path
  * 
@@ -57,10 +148,29 @@ int SetEepromFilePath(
 const char *cFilePath) /* (IN) Set File pathname */
 {
 //	strcpy(cEepromFilePath, cFilePath);
-	sprintf(cEepromFilePath, "%s", cFilePath);
+	pthread_mutex_lock(&EepromCacheMutex);
+	snprintf(cEepromFilePath, sizeof(cEepromFilePath), "%s", cFilePath);
+	iEepromCacheValid = 0;
+	pthread_mutex_unlock(&EepromCacheMutex);
 	return 0;
 }
 
+/*
+ * @brief Refresh EEPROM cache
+ *        (read the device file again, e.g. after the EEPROM is rewritten)
+ */
+int RefreshEepromCache(void)	/* return code 0:Success -1:Error */
+{
+	int ret;
+
+	pthread_mutex_lock(&EepromCacheMutex);
+	ret = ReadEEPROMdata(cEepromCache);
+	iEepromCacheValid = (ret == 0);
+	pthread_mutex_unlock(&EepromCacheMutex);
+
+	return ret;
+}
+
 /*
  * @brief Get EEPROM Header Info 
  * 
@@ -71,7 +181,7 @@ char *outbuf)	/* (OUT) 
 	char eeprombuf[256];
 	int ret;
 
-	ret = ReadEEPROMdata(eeprombuf);
+	ret = ReadEEPROMcache(eeprombuf);
 	if (ret == 0) {
 		memcpy(outbuf, &eeprombuf[EEPROMADDR_HEADER_INFO], 4);
 	}
@@ -88,17 +198,10 @@ char *cBoardName)	/* (OUT) BOARD Name (9byte or more)*/
 {
 	char eeprombuf[256];
 	int ret;
-	int i;
 
-	ret = ReadEEPROMdata(eeprombuf);
+	ret = ReadEEPROMcache(eeprombuf);
 	if (ret == 0) {
-		memcpy(cBoardName, &eeprombuf[EEPROMADDR_BOARD_NAME], 8);
-		for (i=0; i<8; i++) {
-			if (cBoardName[i] < 0x20 || cBoardName[i] > 0x7f) {
-				cBoardName[i] = 0;
-			}
-		}
-		cBoardName[i] = 0;
+		DecodeString(cBoardName, &eeprombuf[EEPROMADDR_BOARD_NAME], 8);
 	}
 	
 	return ret;
@@ -114,7 +217,7 @@ int *iCpuInfo)	/* (OUT) CPU Clock Info 0x8:1GHz, 0x4:800MHz, 0x1:600MHz */
 	char eeprombuf[256];
 	int ret;
 
-	ret = ReadEEPROMdata(eeprombuf);
+	ret = ReadEEPROMcache(eeprombuf);
 	if (ret == 0) {
 		*iCpuInfo = (eeprombuf[EEPROMADDR_CPU_MEMORY_INFO] >> 4) & 0xf;
 	}
@@ -132,7 +235,7 @@ int *iCpuInfo)	/* (OUT) CPU Clock Info 0x2:512Mbyte, 0x0:256Mbyte, 0x1:128Mbyte
 	char eeprombuf[256];
 	int ret;
 
-	ret = ReadEEPROMdata(eeprombuf);
+	ret = ReadEEPROMcache(eeprombuf);
 	if (ret == 0) {
 		*iCpuInfo = eeprombuf[EEPROMADDR_CPU_MEMORY_INFO] & 0xf;
 	}
@@ -151,7 +254,7 @@ char *cEthernetMAC)	/* (OUT) Ethernet MAC (6byte) */
 	char eeprombuf[256];
 	int ret;
 
-	ret = ReadEEPROMdata(eeprombuf);
+	ret = ReadEEPROMcache(eeprombuf);
 	if (ret == 0) {
 		if (iNum == 0 || iNum == 1) {
 			memcpy(cEthernetMAC, &eeprombuf[EEPROMADDR_ETHERNET_MAC+(6*iNum)], 6);
@@ -173,17 +276,10 @@ char *cSerialNumber)	/* (OUT) BOARD Name (9byte or more)*/
 {
 	char eeprombuf[256];
 	int ret;
-	int i;
 
-	ret = ReadEEPROMdata(eeprombuf);
+	ret = ReadEEPROMcache(eeprombuf);
 	if (ret == 0) {
-		memcpy(cSerialNumber, &eeprombuf[EEPROMADDR_SERIAL_NUMBER], 13);
-		for (i=0; i<13; i++) {
-			if (cSerialNumber[i] < 0x20 || cSerialNumber[i] > 0x7f) {
-				cSerialNumber[i] = 0;
-			}
-		}
-		cSerialNumber[i] = 0;
+		DecodeString(cSerialNumber, &eeprombuf[EEPROMADDR_SERIAL_NUMBER], 13);
 	}
 	
 	return ret;
@@ -199,16 +295,10 @@ short *sGain)	/* (OUT) Gain Data  (8 channnel) */
 {
 	char eeprombuf[256];
 	int ret;
-	int i;
-	int addr;
 
-	ret = ReadEEPROMdata(eeprombuf);
+	ret = ReadEEPROMcache(eeprombuf);
 	if (ret == 0) {
-		for (i=0; i<8; i++) {
-			addr = EEPROMADDR_AI_CARIBRATION + (i * 4);
-			sOffet[i] = ((eeprombuf[addr] << 8) + eeprombuf[addr + 1]);
-			sGain[i] = ((eeprombuf[addr + 2] << 8) + eeprombuf[addr + 3]);
-		}
+		DecodeCaribration(&eeprombuf[EEPROMADDR_AI_CARIBRATION], sOffet, sGain);
 	}
 
 	return ret;
@@ -224,16 +314,10 @@ short *sGain)	/* (OUT) Gain Data  (8 channnel) */
 {
 	char eeprombuf[256];
 	int ret;
-	int i;
-	int addr;
 
-	ret = ReadEEPROMdata(eeprombuf);
+	ret = ReadEEPROMcache(eeprombuf);
 	if (ret == 0) {
-		for (i=0; i<8; i++) {
-			addr = EEPROMADDR_AO_CARIBRATION + (i * 4);
-			sOffet[i] = ((eeprombuf[addr] << 8) + eeprombuf[addr + 1]);
-			sGain[i] = ((eeprombuf[addr + 2] << 8) + eeprombuf[addr + 3]);
-		}
+		DecodeCaribration(&eeprombuf[EEPROMADDR_AO_CARIBRATION], sOffet, sGain);
 	}
 
 	return ret;
@@ -249,9 +333,9 @@ short *sRevision)	/* (OUT) Board Revision */
 	char eeprombuf[256];
 	int ret;
 
-	ret = ReadEEPROMdata(eeprombuf);
+	ret = ReadEEPROMcache(eeprombuf);
 	if (ret == 0) {
-		*sRevision = ((eeprombuf[EEPROMADDR_BOARD_REVISION] << 8) + eeprombuf[EEPROMADDR_BOARD_REVISION + 1]);
+		*sRevision = DecodeShort(&eeprombuf[EEPROMADDR_BOARD_REVISION]);
 	}
 
 	return ret;
@@ -266,14 +350,57 @@ long *lRevision)	/* (OUT) FPGA Revision */
 {
 	char eeprombuf[256];
 	int ret;
-	int	year, month, day;
 
-	ret = ReadEEPROMdata(eeprombuf);
+	ret = ReadEEPROMcache(eeprombuf);
+	if (ret == 0) {
+		*lRevision = DecodeFPGARevision(&eeprombuf[EEPROMADDR_FPGA_REVISION]);
+	}
+
+	return ret;
+}
+
+/*
+ * @brief Get all EEPROM data
+ *        (decode the whole image at once)
+ *        image_sum is not compared with anything (the EEPROM has no checksum field)
+ */
+int GetEepromAll(	/* return code 0:Success -1:Error */
+struct cps_eeprom_info *info)	/* (OUT) EEPROM data */
+{
+	char eeprombuf[256];
+	int ret;
+	int i;
+	unsigned short sum = 0;
+	int blank = 1;
+
+	ret = ReadEEPROMcache(eeprombuf);
 	if (ret == 0) {
-		year = (((eeprombuf[EEPROMADDR_FPGA_REVISION] >> 4) & 0xf) * 1000) + (eeprombuf[EEPROMADDR_BOARD_REVISION] & 0xf * 100) + (((eeprombuf[EEPROMADDR_FPGA_REVISION+1] >> 4) & 0xf) * 10) + (eeprombuf[EEPROMADDR_BOARD_REVISION+1] & 0xf) ;
-		month = (((eeprombuf[EEPROMADDR_FPGA_REVISION+2]  >> 4) & 0xf) * 10) + (eeprombuf[EEPROMADDR_BOARD_REVISION+2] & 0xf);
-		day = (((eeprombuf[EEPROMADDR_FPGA_REVISION+3]  >> 4) & 0xf) * 10) + (eeprombuf[EEPROMADDR_BOARD_REVISION+3] & 0xf);
-		*lRevision = (year * 10000) + (month * 100) + day;
+		memset(info, 0, sizeof(*info));
+		info->version = CPS_EEPROM_INFO_VERSION;
+
+		for (i=0; i<256; i++) {
+			sum += (unsigned char)eeprombuf[i];
+			if (eeprombuf[i] != eeprombuf[0]) {
+				blank = 0;
+			}
+		}
+		info->image_sum = sum;
+		/* not written EEPROM is filled with 0xFF (or 0x00) */
+		info->written = !(blank && (eeprombuf[0] == (char)0xFF || eeprombuf[0] == 0));
+
+		memcpy(info->header, &eeprombuf[EEPROMADDR_HEADER_INFO], 4);
+		DecodeString(info->board_name, &eeprombuf[EEPROMADDR_BOARD_NAME], 8);
+		info->cpu_info = (eeprombuf[EEPROMADDR_CPU_MEMORY_INFO] >> 4) & 0xf;
+		info->memory_info = eeprombuf[EEPROMADDR_CPU_MEMORY_INFO] & 0xf;
+		info->display_output = eeprombuf[EEPROMADDR_DISPLAY_OUTPUT];
+		memcpy(info->ethernet_mac, &eeprombuf[EEPROMADDR_ETHERNET_MAC], 12);
+		info->spread_spectrum_clocking = eeprombuf[EEPROMADDR_SPREAD_SPECTRUM_CLOCKING];
+		info->serial_port_for_debug = eeprombuf[EEPROMADDR_SERIAL_PORT_FOR_DEBUG];
+		DecodeString(info->serial_number, &eeprombuf[EEPROMADDR_SERIAL_NUMBER], 13);
+		DecodeCaribration(&eeprombuf[EEPROMADDR_AI_CARIBRATION], info->ai_offset, info->ai_gain);
+		DecodeCaribration(&eeprombuf[EEPROMADDR_AO_CARIBRATION], info->ao_offset, info->ao_gain);
+		info->board_revision = DecodeShort(&eeprombuf[EEPROMADDR_BOARD_REVISION]);
+		info->fpga_revision = DecodeFPGARevision(&eeprombuf[EEPROMADDR_FPGA_REVISION]);
 	}
 
 	return ret;
@@ -10,11 +10,45 @@
 #define EXTERN 
 #endif
 
+#define CPS_EEPROM_INFO_VERSION	1	/* version of struct cps_eeprom_info */
+
+/*
+ * @brief Decoded EEPROM data (GetEepromAll)
+ *        The EEPROM map has no stored checksum, so the image cannot be
+ *        verified. image_sum is informational (e.g. to notice a change
+ *        between reads) and written only tells a blank EEPROM apart.
+ */
+struct cps_eeprom_info {
+	int version;		/* struct version (CPS_EEPROM_INFO_VERSION) */
+	int written;		/* 1: written, 0: blank (all 0xFF or 0x00), not an integrity check */
+	unsigned short image_sum;	/* 16bit sum of the 256byte image (informational, not verified) */
+	char header[4];		/* Header Info */
+	char board_name[9];	/* BOARD Name */
+	int cpu_info;		/* CPU Clock Info 0x8:1GHz, 0x4:800MHz, 0x1:600MHz */
+	int memory_info;	/* Memory Info 0x2:512Mbyte, 0x0:256Mbyte, 0x1:128Mbyte */
+	unsigned char display_output;	/* Display Output */
+	char ethernet_mac[2][6];	/* Ethernet MAC (Ether#0, Ether#1) */
+	unsigned char spread_spectrum_clocking;	/* Spread Spectrum Clocking */
+	unsigned char serial_port_for_debug;	/* Serial Port for Debug */
+	char serial_number[14];	/* Serial Number */
+	short ai_offset[8];	/* AI Caribration Offset Data (8 channnel) */
+	short ai_gain[8];	/* AI Caribration Gain Data (8 channnel) */
+	short ao_offset[8];	/* AO Caribration Offset Data (8 channnel) */
+	short ao_gain[8];	/* AO Caribration Gain Data (8 channnel) */
+	short board_revision;	/* Board Revision */
+	long fpga_revision;	/* FPGA Revision (yyyymmdd) */
+};
+
 /*
  * @brief Set EEPROM file path
  * 
  */
 EXTERN int SetEepromFilePath(const char *cFilePath);
+/*
+ * @brief Refresh EEPROM cache
+ * 
+ */
+EXTERN int RefreshEepromCache(void);	/* return code 0:Success -1:Error */
 /*
  * @brief Get EEPROM Header Info 
  * 
@@ -84,4 +118,11 @@ short *sRevision);	/* (OUT) Board Revision */
 EXTERN int GetEepromFPGARevision(	/* return code 0:Success -1:Error */
 long *lRevision);	/* (OUT) FPGA Revision */
 
+/*
+ * @brief Get all EEPROM data
+ * 
+ */
+EXTERN int GetEepromAll(	/* return code 0:Success -1:Error */
+struct cps_eeprom_info *info);	/* (OUT) EEPROM data */
+
 #endif
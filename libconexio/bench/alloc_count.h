@@ -0,0 +1,47 @@
+/**
+	@file alloc_count.h
+	@~English
+	@brief Heap allocation counter for benchmarks and tests
+	@par Interposes malloc/calloc/realloc/free of glibc. Include from exactly one source file of a program.
+	@~Japanese
+	@brief ベンチマーク・テスト用のヒープ確保回数カウンタ
+	@par glibc の malloc/calloc/realloc/free を置き換えます。1つのプログラムで1つのソースファイルからだけインクルードしてください。
+**/
+#ifndef __ALLOC_COUNT_H__
+#define __ALLOC_COUNT_H__
+
+#include <stddef.h>
+
+extern void *__libc_malloc( size_t size );
+extern void *__libc_calloc( size_t num, size_t size );
+extern void *__libc_realloc( void *ptr, size_t size );
+extern void __libc_free( void *ptr );
+
+static volatile unsigned long alloc_count;	///< number of malloc/calloc/realloc calls
+static volatile unsigned long free_count;	///< number of free calls ( not NULL )
+
+void *malloc( size_t size )
+{
+	__sync_fetch_and_add( &alloc_count, 1 );
+	return __libc_malloc( size );
+}
+
+void *calloc( size_t num, size_t size )
+{
+	__sync_fetch_and_add( &alloc_count, 1 );
+	return __libc_calloc( num, size );
+}
+
+void *realloc( void *ptr, size_t size )
+{
+	__sync_fetch_and_add( &alloc_count, 1 );
+	return __libc_realloc( ptr, size );
+}
+
+void free( void *ptr )
+{
+	if( ptr != NULL ) __sync_fetch_and_add( &free_count, 1 );
+	__libc_free( ptr );
+}
+
+#endif
@@ -0,0 +1,127 @@
+/**
+	@file alloc_test.c
+	@~English
+	@brief Steady-state heap allocation test of the CMM920 packet path
+	@par Counts malloc/calloc/realloc calls while commands and telegrams are exchanged with the
+	PTY module simulator, and fails if the steady state allocates.
+	@~Japanese
+	@brief CMM920 パケット処理の定常状態のヒープ確保テスト
+	@par 疑似端末モジュールシミュレータとコマンド・電文をやり取りする間の malloc/calloc/realloc の
+	呼び出し回数を数え、定常状態で確保があれば失敗します。
+**/
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "libconexio_CMM920.h"
+#include "cmm920_sim.h"
+#include "alloc_count.h"
+
+#define TEST_WARMUP	10	///< iterations before counting
+#define TEST_COUNT	100	///< counted iterations
+
+/**
+	@~English
+	@brief One iteration of the packet path
+	@return Success : 0 , Failed : otherwise 0
+	@~Japanese
+	@brief パケット処理を1回行う関数
+	@return 成功:  0 失敗 :  0以外
+**/
+static int _test_iteration( CONEXIO920HANDLE ctx, int thread, int i )
+{
+	BYTE payload[64], recv[512];
+	unsigned short value = (unsigned short)i;
+	unsigned short dest_id = 0x1234, src_id = 0x1234;
+	long dest_addr = 2, src_addr = 1;
+	int length;
+
+	memset( payload, i, sizeof(payload) );
+
+	// command round trips ( LSI is not cached, timer write goes through to the module )
+	if( conexio_cmm920_lsi_h( ctx, 0x000100, CONEXIO_CMM920_SET_READING_WRITE, &value ) ) return 1;
+	if( conexio_cmm920_lsi_h( ctx, 0x000100, CONEXIO_CMM920_SET_READING_READ, &value ) ) return 2;
+	if( conexio_cmm920_set_timer_h( ctx, (unsigned short)( 100 + i ) ) ) return 3;
+
+	if( thread ){
+		// send and receive the echoed telegram through the receive thread
+		if( SendTelegram_h( ctx, payload, sizeof(payload), CONEXIO_CMM920_HOP_MULTI,
+			CONEXIO_CMM920_SENDDATA_MODE_NOACK_NORESP, &dest_id, &src_id, &dest_addr, &src_addr ) ) return 4;
+		length = 0;
+		if( RecvTelegram_h( ctx, recv, &length, CONEXIO_CMM920_HOP_MULTI, NULL, NULL, NULL,
+			&dest_id, &src_id, &dest_addr, &src_addr ) ) return 5;
+	}else{
+		// synchronous receive of a telegram from a remote node
+		if( cmm920_sim_telegram( 0, payload, sizeof(payload) ) ) return 6;
+		length = 0;
+		if( RecvTelegram_h( ctx, recv, &length, CONEXIO_CMM920_HOP_SINGLE, NULL, NULL, NULL,
+			NULL, NULL, NULL, NULL ) ) return 7;
+	}
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief Run the iterations and count the allocations
+	@return allocations in the counted iterations, Failed : -1
+	@~Japanese
+	@brief 繰り返し実行して確保回数を数える関数
+	@return 計測中の確保回数, 失敗 : -1
+**/
+static long _test_run( CONEXIO920HANDLE ctx, int thread )
+{
+	unsigned long start;
+	int i, ret;
+
+	for( i = 0; i < TEST_WARMUP + TEST_COUNT; i++ ){
+		if( i == TEST_WARMUP ) start = alloc_count;
+		ret = _test_iteration( ctx, thread, i );
+		if( ret ){
+			printf( "iteration %d failed at step %d\n", i, ret );
+			return -1;
+		}
+	}
+
+	return (long)( alloc_count - start );
+}
+
+int main( void )
+{
+	CMM920SIMCONFIG config;
+	CONEXIO920HANDLE ctx;
+	char name[1][CMM920_SIM_NAME_SIZE];
+	long allocs;
+	int fail = 0;
+
+	cmm920_sim_default_config( &config );
+	config.bitrate = 0;	// no airtime
+	config.uart_baud = 0;	// no UART time
+
+	if( cmm920_sim_start( 1, &config, name ) ){
+		printf( "simulator start failed\n" );
+		return 1;
+	}
+	ctx = conexio_cmm920_open( name[0] );
+	if( ctx == NULL ){
+		printf( "conexio_cmm920_open failed\n" );
+		cmm920_sim_stop();
+		return 1;
+	}
+	conexio_cmm920_set_crc_check_h( ctx, CONEXIO_CMM920_CRC_CHECK_ON );
+
+	allocs = _test_run( ctx, 0 );
+	printf( "synchronous path     : %ld allocations in %d iterations\n", allocs, TEST_COUNT );
+	if( allocs != 0 ) fail = 1;
+
+	conexio_cmm920_start_recv_thread_h( ctx, NULL, NULL );
+	allocs = _test_run( ctx, 1 );
+	printf( "receive thread path  : %ld allocations in %d iterations\n", allocs, TEST_COUNT );
+	if( allocs != 0 ) fail = 1;
+	conexio_cmm920_stop_recv_thread_h( ctx );
+
+	conexio_cmm920_close( ctx );
+	cmm920_sim_stop();
+
+	printf( "%s\n", fail ? "FAIL" : "PASS" );
+	return fail;
+}
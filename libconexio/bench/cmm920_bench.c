@@ -0,0 +1,202 @@
+/**
+	@file cmm920_bench.c
+	@~English
+	@brief libconexio CMM920 benchmark on the PTY module simulator
+	@par Reports command RTT, telegrams/sec and heap allocations per telegram.
+	@par usage : cmm920_bench [-n count] [-s size] [-b bitrate] [-u uart_baud] [-r resp_usec] [-l loss_ppm] [-e crc_error_ppm]
+	@~Japanese
+	@brief 疑似端末モジュールシミュレータ上の libconexio CMM920 ベンチマーク
+	@par コマンドの往復時間、1秒あたりの電文数、電文あたりのヒープ確保回数を表示します。
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "libconexio_CMM920.h"
+#include "cmm920_sim.h"
+#include "alloc_count.h"
+
+#define BENCH_PAYLOAD_MAX	400	///< maximum payload size
+#define BENCH_RECV_MAX	512	///< receive buffer size
+
+static long _bench_diff_usec( struct timespec *start, struct timespec *end )
+{
+	return ( end->tv_sec - start->tv_sec ) * 1000000L + ( end->tv_nsec - start->tv_nsec ) / 1000L;
+}
+
+static int _bench_cmp_long( const void *a, const void *b )
+{
+	long la = *(const long *)a, lb = *(const long *)b;
+	return ( la > lb ) - ( la < lb );
+}
+
+static void _bench_print_rtt( const char *title, long *rtt, int num, int fails )
+{
+	long long total = 0;
+	int i;
+
+	qsort( rtt, num, sizeof(long), _bench_cmp_long );
+	for( i = 0; i < num; i++ ) total += rtt[i];
+
+	printf( "%-28s n %5d  mean %6lld us  p50 %6ld us  p99 %6ld us  fail %d\n",
+		title, num, ( num > 0 ) ? total / num : 0LL,
+		( num > 0 ) ? rtt[num / 2] : 0L, ( num > 0 ) ? rtt[( num * 99 ) / 100] : 0L, fails );
+}
+
+/**
+	@~English
+	@brief Measure the round trip time of an uncached command ( LSI register read )
+	@~Japanese
+	@brief キャッシュされないコマンド ( LSI レジスタ読み出し ) の往復時間を測定する関数
+**/
+static int _bench_command( CONEXIO920HANDLE ctx, const char *title, int num )
+{
+	struct timespec t0, t1;
+	unsigned short value;
+	long *rtt;
+	int i, fails = 0;
+
+	rtt = (long *)malloc( sizeof(long) * num );
+	if( rtt == NULL ) return -1;
+
+	for( i = 0; i < num; i++ ){
+		clock_gettime( CLOCK_MONOTONIC, &t0 );
+		if( conexio_cmm920_lsi_h( ctx, 0x000100 + ( i & 0xFF ), CONEXIO_CMM920_SET_READING_READ, &value ) ) fails++;
+		clock_gettime( CLOCK_MONOTONIC, &t1 );
+		rtt[i] = _bench_diff_usec( &t0, &t1 );
+	}
+	_bench_print_rtt( title, rtt, num, fails );
+
+	free( rtt );
+	return fails;
+}
+
+/**
+	@~English
+	@brief Measure telegram round trips through the echoing simulator
+	@~Japanese
+	@brief 折り返すシミュレータを通した電文の往復を測定する関数
+**/
+static int _bench_telegram( CONEXIO920HANDLE ctx, int num, int size )
+{
+	BYTE payload[BENCH_PAYLOAD_MAX], recv[BENCH_RECV_MAX];
+	struct timespec t0, t1, ts, te;
+	CONEXIO920STAT stat;
+	unsigned long allocs;
+	long *rtt;
+	int i, j, length, ok = 0, lost = 0, bad = 0;
+	double sec;
+
+	rtt = (long *)malloc( sizeof(long) * num );
+	if( rtt == NULL ) return -1;
+
+	conexio_cmm920_reset_stat_h( ctx );
+	allocs = alloc_count;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+
+	for( i = 0; i < num; i++ ){
+		for( j = 0; j < size; j++ ) payload[j] = (BYTE)( i + j );
+
+		clock_gettime( CLOCK_MONOTONIC, &t0 );
+		if( SendTelegram_h( ctx, payload, size, CONEXIO_CMM920_HOP_SINGLE,
+			CONEXIO_CMM920_SENDDATA_MODE_NOACK_NORESP, NULL, NULL, NULL, NULL ) ){
+			lost++;
+			continue;
+		}
+		length = 0;
+		if( RecvTelegram_h( ctx, recv, &length, CONEXIO_CMM920_HOP_SINGLE,
+			NULL, NULL, NULL, NULL, NULL, NULL, NULL ) ){
+			lost++;
+			continue;
+		}
+		clock_gettime( CLOCK_MONOTONIC, &t1 );
+		rtt[ok++] = _bench_diff_usec( &t0, &t1 );
+		if( length - 4 != size || memcmp( recv, payload, size ) != 0 ) bad++;
+	}
+
+	clock_gettime( CLOCK_MONOTONIC, &te );
+	allocs = alloc_count - allocs;
+	sec = _bench_diff_usec( &ts, &te ) / 1e6;
+
+	_bench_print_rtt( "telegram round trip", rtt, ok, lost );
+	conexio_cmm920_get_stat_h( ctx, &stat );
+	printf( "telegrams/sec %.1f ( %d bytes, %d delivered, %d lost, %d corrupted )\n",
+		( sec > 0 ) ? ok / sec : 0.0, size, ok, lost, bad );
+	printf( "allocations per telegram %.3f ( %lu in %d round trips )\n",
+		(double)allocs / num, allocs, num );
+	printf( "library : frames sent %lu recv %lu, telegrams sent %lu recv %lu, crc errors %lu, timeouts %lu, pool peak %d\n",
+		stat.frames_sent, stat.frames_recv, stat.telegrams_sent, stat.telegrams_recv,
+		stat.crc_errors, stat.timeouts, stat.pool_peak );
+
+	free( rtt );
+	return bad + lost;
+}
+
+int main( int argc, char *argv[] )
+{
+	CMM920SIMCONFIG config;
+	CMM920SIMSTAT sim;
+	CONEXIO920HANDLE ctx;
+	char name[1][CMM920_SIM_NAME_SIZE];
+	int num = 500, size = 32;
+	int opt, ret = 0;
+
+	cmm920_sim_default_config( &config );
+
+	while( ( opt = getopt( argc, argv, "n:s:b:u:r:l:e:" ) ) != -1 ){
+		switch( opt ){
+		case 'n': num = atoi( optarg ); break;
+		case 's': size = atoi( optarg ); break;
+		case 'b': config.bitrate = atol( optarg ); break;
+		case 'u': config.uart_baud = atol( optarg ); break;
+		case 'r': config.resp_usec = atol( optarg ); break;
+		case 'l': config.loss_ppm = atol( optarg ); break;
+		case 'e': config.crc_error_ppm = atol( optarg ); break;
+		default:
+			fprintf( stderr, "usage : %s [-n count] [-s size] [-b bitrate] [-u uart_baud] [-r resp_usec]"
+				" [-l loss_ppm] [-e crc_error_ppm]\n", argv[0] );
+			return 2;
+		}
+	}
+	if( num <= 0 || size < 1 || size > BENCH_PAYLOAD_MAX ){
+		fprintf( stderr, "count must be > 0 and size 1..%d\n", BENCH_PAYLOAD_MAX );
+		return 2;
+	}
+
+	if( cmm920_sim_start( 1, &config, name ) ){
+		fprintf( stderr, "simulator start failed\n" );
+		return 1;
+	}
+	ctx = conexio_cmm920_open( name[0] );
+	if( ctx == NULL ){
+		fprintf( stderr, "conexio_cmm920_open failed\n" );
+		cmm920_sim_stop();
+		return 1;
+	}
+
+	printf( "bitrate %ld bps  uart %ld bps  response %ld us  loss %ld ppm  crc error %ld ppm\n",
+		config.bitrate, config.uart_baud, config.resp_usec, config.loss_ppm, config.crc_error_ppm );
+
+	if( _bench_command( ctx, "command rtt ( direct read )", num ) ) ret = 1;
+
+	conexio_cmm920_set_crc_check_h( ctx, CONEXIO_CMM920_CRC_CHECK_ON );
+	conexio_cmm920_start_recv_thread_h( ctx, NULL, NULL );
+
+	if( _bench_command( ctx, "command rtt ( recv thread )", num ) ) ret = 1;
+	if( _bench_telegram( ctx, num, size ) ) ret = 1;
+
+	conexio_cmm920_stop_recv_thread_h( ctx );
+	conexio_cmm920_close( ctx );
+
+	cmm920_sim_get_stat( &sim );
+	printf( "simulator : commands %lu, telegrams %lu, lost %lu, crc errors %lu, airtime %lld ms\n",
+		sim.commands, sim.telegrams, sim.lost, sim.crc_errors, sim.airtime_usec / 1000 );
+	cmm920_sim_stop();
+
+	// without injected errors every command and telegram must succeed
+	if( config.loss_ppm == 0 && config.crc_error_ppm == 0 && sim.lost == 0 ){
+		return ret;
+	}
+	return 0;
+}
@@ -0,0 +1,462 @@
+/**
+	@file cmm920_sim.c
+	@~English
+	@brief PTY-backed CMM920 module simulator
+	@par Speaks the DLE/STX frame protocol on the master side of pseudo terminals.
+	@par Answers mode/address/wireless/timer/auto ack/antenna/version/LSI/reset commands,
+	and carries telegrams with airtime per bit rate, losses and FCS errors.
+	@~Japanese
+	@brief 疑似端末を使った CMM920 モジュールシミュレータ
+	@par 疑似端末のマスタ側で DLE/STX フレームのプロトコルを処理します。
+	@par モード、アドレス、無線、タイマー、自動応答フレーム、アンテナ、バージョン、LSI、リセットの
+	コマンドに応答し、電文はビットレートに応じた送信時間、ロス、FCS エラーを加えて届けます。
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <pthread.h>
+#include "serialfunc.h"
+#include "cmm920_sim.h"
+
+#define CMM920_SIM_BUF_SIZE	4096	///< receive buffer size per module
+#define CMM920_SIM_FRAME_MAX	700	///< maximum frame size
+#define CMM920_SIM_PHY_OVERHEAD	12	///< preamble, SFD and PHR bytes per telegram
+#define CMM920_SIM_LSI_REG_NUM	( 1 << 17 )	///< number of LSI registers
+
+/// module state
+typedef struct __cmm920_sim_module__{
+	int master;	///< pseudo terminal master
+	BYTE buf[CMM920_SIM_BUF_SIZE];	///< received bytes
+	int length;	///< received length
+	BYTE config[256][16];	///< configuration per command
+	unsigned short lsi[CMM920_SIM_LSI_REG_NUM];	///< LSI registers
+} CMM920SIMMODULE;
+
+/// configuration length per command ( read response without the read flag )
+static const int cmm920_sim_config_length[256] = {
+	[CONEXIO_CMM920_SET_MODE] = 1,
+	[CONEXIO_CMM920_SET_ADDRESS] = 12,
+	[CONEXIO_CMM920_SET_WIRELESS] = 11,
+	[CONEXIO_CMM920_SET_TIMER] = 2,
+	[CONEXIO_CMM920_SET_ACK] = 3,
+	[CONEXIO_CMM920_SET_ANTENNA] = 1,
+	[CONEXIO_CMM920_SET_VERSION] = 2,
+};
+
+static CMM920SIMMODULE *sim_module[CMM920_SIM_PORT_MAX];
+static int sim_num;
+static CMM920SIMCONFIG sim_config;
+static CMM920SIMSTAT sim_stat;
+static pthread_t sim_thread;
+static volatile int sim_stop;
+static pthread_mutex_t sim_mutex = PTHREAD_MUTEX_INITIALIZER;	///< statistics and random numbers
+static pthread_mutex_t sim_write_mutex = PTHREAD_MUTEX_INITIALIZER;	///< frame writes
+
+/**
+	@~English
+	@brief Get the default configuration ( 100 kbps, 115200 baud, no loss, echo )
+	@param config : configuration
+	@~Japanese
+	@brief 既定の設定 ( 100kbps, 115200bps, ロスなし, 折り返し ) を取得する関数
+	@param config : 設定
+**/
+void cmm920_sim_default_config( PCMM920SIMCONFIG config )
+{
+	memset( config, 0, sizeof(CMM920SIMCONFIG) );
+	config->bitrate = 100000;
+	config->uart_baud = 115200;
+	config->echo = 1;
+	config->seed = 1;
+}
+
+static void _cmm920_sim_sleep_usec( long long usec )
+{
+	struct timespec ts;
+
+	if( usec <= 0 ) return;
+	ts.tv_sec = usec / 1000000LL;
+	ts.tv_nsec = ( usec % 1000000LL ) * 1000L;
+	while( nanosleep( &ts, &ts ) < 0 && errno == EINTR );
+}
+
+static int _cmm920_sim_chance( long ppm )
+{
+	if( ppm <= 0 ) return 0;
+	return ( rand_r( &sim_config.seed ) % 1000000L ) < ppm;
+}
+
+static long long _cmm920_sim_uart_usec( int length )
+{
+	if( sim_config.uart_baud <= 0 ) return 0;
+	return length * 10LL * 1000000LL / sim_config.uart_baud;	// start + 8 data + stop
+}
+
+/**
+	@~English
+	@brief Write a response frame to the host
+	@~Japanese
+	@brief ホストへ応答フレームを書き込む関数
+**/
+static void _cmm920_sim_put( CMM920SIMMODULE *mod, BYTE mode, BYTE command, const BYTE *data, int size )
+{
+	BYTE frame[CMM920_SIM_FRAME_MAX];
+	BYTE sum = 0;
+	int length = 0, pos = 0, ret, i;
+
+	frame[length++] = 0x10;
+	frame[length++] = 0x02;
+	frame[length++] = ( size + 5 ) >> 8;
+	frame[length++] = ( size + 5 ) & 0xFF;
+	frame[length++] = mode | CONEXIO_CMM920_RECVCOMMAND;
+	frame[length++] = command;
+	frame[length++] = 0;	// result
+	frame[length++] = 0;
+	memcpy( &frame[length], data, size );
+	length += size;
+	for( i = 2; i < length; i++ ) sum += frame[i];
+	frame[length++] = (BYTE)( ( sum ^ 0xFF ) + 1 );
+	frame[length++] = 0x10;
+	frame[length++] = 0x03;
+
+	_cmm920_sim_sleep_usec( _cmm920_sim_uart_usec( length ) );
+
+	pthread_mutex_lock( &sim_write_mutex );
+	while( pos < length ){
+		ret = write( mod->master, &frame[pos], length - pos );
+		if( ret < 0 ){
+			if( errno == EINTR || errno == EAGAIN ) continue;
+			break;
+		}
+		pos += ret;
+	}
+	pthread_mutex_unlock( &sim_write_mutex );
+}
+
+/**
+	@~English
+	@brief Deliver a telegram to the host
+	@param mod : receiving module
+	@param psdu : PSDU ( without FCS )
+	@param size : PSDU size
+	@param broken : 1 : break the FCS
+	@~Japanese
+	@brief ホストへ電文を届ける関数
+	@param mod : 受信するモジュール
+	@param psdu : PSDU ( FCS なし )
+	@param size : PSDU サイズ
+	@param broken : 1 : FCS を壊す
+**/
+static void _cmm920_sim_deliver( CMM920SIMMODULE *mod, const BYTE *psdu, int size, int broken )
+{
+	BYTE data[CMM920_SIM_FRAME_MAX];
+	unsigned int fcs;
+	int length = 0;
+
+	if( size < 0 || size + 11 > (int)sizeof(data) ) return;
+
+	fcs = ~conexio_cmm920_crc32( 0, psdu, size );	// CRC calculate inverse off
+	if( broken ) fcs ^= 0x00000001;
+
+	data[length++] = 0x01;	// receive enable
+	data[length++] = 0x33;	// rx channel
+	data[length++] = 0x40;	// rx power
+	data[length++] = ( size + 4 ) >> 8;	// phr
+	data[length++] = ( size + 4 ) & 0xFF;
+	memcpy( &data[length], psdu, size );
+	length += size;
+	data[length++] = fcs & 0xFF;
+	data[length++] = ( fcs >> 8 ) & 0xFF;
+	data[length++] = ( fcs >> 16 ) & 0xFF;
+	data[length++] = ( fcs >> 24 ) & 0xFF;
+	data[length++] = 0x50;	// rssi
+	data[length++] = 0x00;	// antenna
+
+	_cmm920_sim_put( mod, CONEXIO_CMM920_MODE_RUN, CONEXIO_CMM920_SENDDATA, data, length );
+}
+
+/**
+	@~English
+	@brief Send a telegram over the simulated air
+	@~Japanese
+	@brief 電文を模擬的に無線送信する関数
+**/
+static void _cmm920_sim_air( int port, const BYTE *psdu, int size )
+{
+	CMM920SIMMODULE *dest;
+	long long airtime = 0;
+	int lost, broken;
+
+	if( sim_config.bitrate > 0 ){
+		airtime = ( size + 4 + CMM920_SIM_PHY_OVERHEAD ) * 8LL * 1000000LL / sim_config.bitrate;
+	}
+	_cmm920_sim_sleep_usec( airtime );
+
+	dest = sim_module[( sim_config.echo || sim_num < 2 ) ? port : !port];
+
+	pthread_mutex_lock( &sim_mutex );
+	lost = _cmm920_sim_chance( sim_config.loss_ppm );
+	broken = !lost && _cmm920_sim_chance( sim_config.crc_error_ppm );
+	sim_stat.telegrams++;
+	sim_stat.airtime_usec += airtime;
+	if( lost ) sim_stat.lost++;
+	if( broken ) sim_stat.crc_errors++;
+	pthread_mutex_unlock( &sim_mutex );
+
+	if( !lost ) _cmm920_sim_deliver( dest, psdu, size, broken );
+}
+
+/**
+	@~English
+	@brief Process a command frame from the host
+	@~Japanese
+	@brief ホストからのコマンドフレームを処理する関数
+**/
+static void _cmm920_sim_command( int port, BYTE mode, BYTE command, BYTE *data, int size )
+{
+	CMM920SIMMODULE *mod = sim_module[port];
+	BYTE res[CMM920_SIM_FRAME_MAX];
+	unsigned int addr;
+	int length = 0;
+	int psdu;
+
+	pthread_mutex_lock( &sim_mutex );
+	sim_stat.commands++;
+	pthread_mutex_unlock( &sim_mutex );
+
+	_cmm920_sim_sleep_usec( sim_config.resp_usec );
+
+	if( mode == CONEXIO_CMM920_MODE_RUN && command == CONEXIO_CMM920_SENDDATA ){
+		// send mode + phr(2) + psdu
+		psdu = size - 3;
+		res[0] = 0;	// send result
+		_cmm920_sim_put( mod, mode, command, res, 1 );
+		if( psdu >= 0 ) _cmm920_sim_air( port, &data[3], psdu );
+		return;
+	}
+
+	if( mode == CONEXIO_CMM920_MODE_COMMON && command == CONEXIO_CMM920_SET_LSI && size >= 4 ){
+		// address(3) + read/write + value(2)
+		addr = ( ( data[0] << 16 ) | ( data[1] << 8 ) | data[2] ) & ( CMM920_SIM_LSI_REG_NUM - 1 );
+		memcpy( res, data, 4 );
+		if( data[3] == CONEXIO_CMM920_SET_READING_WRITE && size >= 6 ){
+			mod->lsi[addr] = ( data[4] << 8 ) | data[5];
+		}
+		res[4] = mod->lsi[addr] >> 8;
+		res[5] = mod->lsi[addr] & 0xFF;
+		_cmm920_sim_put( mod, mode, command, res, 6 );
+		return;
+	}
+
+	if( mode == CONEXIO_CMM920_MODE_COMMON && command == CONEXIO_CMM920_RESET ){
+		memset( mod->config, 0, sizeof(mod->config) );
+		_cmm920_sim_put( mod, mode, command, data, size );
+		return;
+	}
+
+	if( mode == CONEXIO_CMM920_MODE_COMMON && cmm920_sim_config_length[command] > 0 && size >= 1 ){
+		length = cmm920_sim_config_length[command];
+		if( data[0] == CONEXIO_CMM920_SET_READING_WRITE ){
+			memcpy( mod->config[command], &data[1], ( size - 1 < length ) ? size - 1 : length );
+			_cmm920_sim_put( mod, mode, command, data, size );
+		}else{
+			res[0] = CONEXIO_CMM920_SET_READING_READ;
+			memcpy( &res[1], mod->config[command], length );
+			_cmm920_sim_put( mod, mode, command, res, length + 1 );
+		}
+		return;
+	}
+
+	// other commands are acknowledged with the same data
+	_cmm920_sim_put( mod, mode, command, data, size );
+}
+
+/**
+	@~English
+	@brief Parse the received bytes of a module
+	@~Japanese
+	@brief モジュールの受信データを解析する関数
+**/
+static void _cmm920_sim_parse( int port )
+{
+	CMM920SIMMODULE *mod = sim_module[port];
+	int total;
+
+	while( mod->length >= 4 ){
+		if( mod->buf[0] != 0x10 || mod->buf[1] != 0x02 ){
+			memmove( mod->buf, &mod->buf[1], --mod->length );
+			continue;
+		}
+		// DLE STX size(2) [ command(2) result(2) data sum ] DLE ETX
+		total = 4 + ( ( mod->buf[2] << 8 ) | mod->buf[3] ) + 2;
+		if( total < 11 || total > CMM920_SIM_BUF_SIZE ){
+			memmove( mod->buf, &mod->buf[1], --mod->length );
+			continue;
+		}
+		if( mod->length < total ) break;
+
+		_cmm920_sim_sleep_usec( _cmm920_sim_uart_usec( total ) );
+		_cmm920_sim_command( port, mod->buf[4], mod->buf[5], &mod->buf[8], total - 11 );
+
+		memmove( mod->buf, &mod->buf[total], mod->length - total );
+		mod->length -= total;
+	}
+}
+
+static void* _cmm920_sim_thread( void *arg )
+{
+	struct pollfd pfd[CMM920_SIM_PORT_MAX];
+	int i, ret;
+
+	for( i = 0; i < sim_num; i++ ){
+		pfd[i].fd = sim_module[i]->master;
+		pfd[i].events = POLLIN;
+	}
+
+	while( !sim_stop ){
+		if( poll( pfd, sim_num, 10 ) <= 0 ) continue;
+		for( i = 0; i < sim_num; i++ ){
+			if( !( pfd[i].revents & POLLIN ) ) continue;
+			ret = read( sim_module[i]->master, &sim_module[i]->buf[sim_module[i]->length],
+				CMM920_SIM_BUF_SIZE - sim_module[i]->length );
+			if( ret <= 0 ) continue;
+			sim_module[i]->length += ret;
+			_cmm920_sim_parse( i );
+		}
+	}
+
+	return NULL;
+}
+
+/**
+	@~English
+	@brief Start the simulator
+	@param num : number of modules ( 1 or 2 )
+	@param config : configuration ( NULL : default )
+	@param name : slave device names to pass to conexio_cmm920_init / conexio_cmm920_open
+	@return Success : 0 , Failed : -1
+	@~Japanese
+	@brief シミュレータを開始する関数
+	@param num : モジュール数 ( 1 または 2 )
+	@param config : 設定 ( NULL : 既定値 )
+	@param name : conexio_cmm920_init / conexio_cmm920_open に渡すスレーブ側のデバイス名
+	@return 成功:  0 失敗 :  -1
+**/
+int cmm920_sim_start( int num, const CMM920SIMCONFIG *config, char name[][CMM920_SIM_NAME_SIZE] )
+{
+	int i;
+
+	if( num < 1 || num > CMM920_SIM_PORT_MAX || sim_num != 0 ) return -1;
+
+	if( config != NULL ) sim_config = *config;
+	else cmm920_sim_default_config( &sim_config );
+	memset( &sim_stat, 0, sizeof(sim_stat) );
+
+	for( i = 0; i < num; i++ ){
+		sim_module[i] = (CMM920SIMMODULE *)calloc( 1, sizeof(CMM920SIMMODULE) );
+		if( sim_module[i] == NULL ) break;
+		sim_module[i]->master = Serial_PortOpen_Pty( name[i], CMM920_SIM_NAME_SIZE );
+		if( sim_module[i]->master < 0 ){
+			free( sim_module[i] );
+			break;
+		}
+	}
+	if( i < num ){
+		while( --i >= 0 ){
+			close( sim_module[i]->master );
+			free( sim_module[i] );
+		}
+		return -1;
+	}
+
+	sim_num = num;
+	sim_stop = 0;
+	if( pthread_create( &sim_thread, NULL, _cmm920_sim_thread, NULL ) != 0 ){
+		sim_num = 0;
+		for( i = 0; i < num; i++ ){
+			close( sim_module[i]->master );
+			free( sim_module[i] );
+		}
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief Stop the simulator
+	@par Close the library side first.
+	@~Japanese
+	@brief シミュレータを停止する関数
+	@par ライブラリ側を先に終了してください。
+**/
+void cmm920_sim_stop( void )
+{
+	int i;
+
+	if( sim_num == 0 ) return;
+
+	sim_stop = 1;
+	pthread_join( sim_thread, NULL );
+
+	for( i = 0; i < sim_num; i++ ){
+		close( sim_module[i]->master );
+		free( sim_module[i] );
+		sim_module[i] = NULL;
+	}
+	sim_num = 0;
+}
+
+/**
+	@~English
+	@brief Generate a telegram to a module ( from a remote node )
+	@param port : receiving module
+	@param psdu : PSDU ( without FCS )
+	@param size : PSDU size
+	@return Success : 0 , Failed : -1
+	@par Losses and FCS errors are applied as well.
+	@~Japanese
+	@brief モジュールへ電文を発生させる関数 ( 他のノードからの電文 )
+	@param port : 受信するモジュール
+	@param psdu : PSDU ( FCS なし )
+	@param size : PSDU サイズ
+	@return 成功:  0 失敗 :  -1
+	@par ロスと FCS エラーも同じように加えます。
+**/
+int cmm920_sim_telegram( int port, const BYTE *psdu, int size )
+{
+	int lost, broken;
+
+	if( port < 0 || port >= sim_num ) return -1;
+
+	pthread_mutex_lock( &sim_mutex );
+	lost = _cmm920_sim_chance( sim_config.loss_ppm );
+	broken = !lost && _cmm920_sim_chance( sim_config.crc_error_ppm );
+	sim_stat.generated++;
+	if( lost ) sim_stat.lost++;
+	if( broken ) sim_stat.crc_errors++;
+	pthread_mutex_unlock( &sim_mutex );
+
+	if( !lost ) _cmm920_sim_deliver( sim_module[port], psdu, size, broken );
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief Get the simulator statistics
+	@param stat : statistics
+	@~Japanese
+	@brief シミュレータの統計を取得する関数
+	@param stat : 統計
+**/
+void cmm920_sim_get_stat( PCMM920SIMSTAT stat )
+{
+	pthread_mutex_lock( &sim_mutex );
+	*stat = sim_stat;
+	pthread_mutex_unlock( &sim_mutex );
+}
@@ -0,0 +1,53 @@
+/**
+	@file cmm920_sim.h
+	@~English
+	@brief PTY-backed CMM920 module simulator for benchmarks and tests
+	@~Japanese
+	@brief ベンチマーク・テスト用の疑似端末 CMM920 モジュールシミュレータ
+**/
+#ifndef __CMM920_SIM_H__
+#define __CMM920_SIM_H__
+
+#include "libconexio_CMM920.h"
+
+#define CMM920_SIM_PORT_MAX	2	///< maximum number of simulated modules
+#define CMM920_SIM_NAME_SIZE	64	///< slave device name size
+
+/**
+	@~English
+	@brief simulator configuration
+	@~Japanese
+	@brief シミュレータの設定
+**/
+typedef struct __cmm920_sim_config__{
+	long bitrate;	///< air bit rate (bps) ( 0 : no airtime )
+	long uart_baud;	///< emulated UART speed (bps) ( 0 : no UART time )
+	long resp_usec;	///< command processing time (usec)
+	long loss_ppm;	///< telegram loss rate (ppm)
+	long crc_error_ppm;	///< telegram FCS error rate (ppm)
+	int echo;	///< 1 : telegrams return to the sender, 0 : telegrams go to the other module
+	unsigned int seed;	///< random seed
+} CMM920SIMCONFIG, *PCMM920SIMCONFIG;
+
+/**
+	@~English
+	@brief simulator statistics
+	@~Japanese
+	@brief シミュレータの統計
+**/
+typedef struct __cmm920_sim_stat__{
+	unsigned long commands;	///< command frames
+	unsigned long telegrams;	///< telegrams sent over the air
+	unsigned long lost;	///< telegrams lost
+	unsigned long crc_errors;	///< telegrams delivered with a broken FCS
+	unsigned long generated;	///< telegrams generated by cmm920_sim_telegram
+	long long airtime_usec;	///< total airtime (usec)
+} CMM920SIMSTAT, *PCMM920SIMSTAT;
+
+extern void cmm920_sim_default_config( PCMM920SIMCONFIG config );
+extern int cmm920_sim_start( int num, const CMM920SIMCONFIG *config, char name[][CMM920_SIM_NAME_SIZE] );
+extern void cmm920_sim_stop( void );
+extern int cmm920_sim_telegram( int port, const BYTE *psdu, int size );
+extern void cmm920_sim_get_stat( PCMM920SIMSTAT stat );
+
+#endif
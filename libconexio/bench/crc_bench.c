@@ -0,0 +1,143 @@
+/**
+	@file crc_bench.c
+	@~English
+	@brief CRC-32 check and microbenchmark
+	@par Checks conexio_cmm920_crc32 against the "123456789" check value and a bitwise reference,
+	and reports the time per call and the throughput of the slice-by-8 and bitwise loops.
+	@par usage : crc_bench [-m megabytes]
+	@~Japanese
+	@brief CRC-32 の確認とマイクロベンチマーク
+	@par conexio_cmm920_crc32 を "123456789" のチェック値とビット単位の参照実装で確認し、
+	slice-by-8 とビット単位のループの1回あたりの時間とスループットを表示します。
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "libconexio_CMM920.h"
+
+#define BENCH_BUF_SIZE	65536	///< benchmark buffer size
+#define BENCH_CHECK_MAX	512	///< lengths compared with the reference
+
+static BYTE bench_buf[BENCH_BUF_SIZE];
+static volatile unsigned int bench_sink;
+
+static long _bench_diff_nsec( struct timespec *start, struct timespec *end )
+{
+	return ( end->tv_sec - start->tv_sec ) * 1000000000L + ( end->tv_nsec - start->tv_nsec );
+}
+
+/**
+	@~English
+	@brief Bitwise CRC-32 reference ( reflected 0xEDB88320 )
+	@~Japanese
+	@brief ビット単位の CRC-32 参照実装 ( 反転 0xEDB88320 )
+**/
+static unsigned int _bench_crc32_bitwise( unsigned int crc, const BYTE buf[], int size )
+{
+	int i, j;
+
+	crc = ~crc;
+	for( i = 0; i < size; i++ ){
+		crc ^= buf[i];
+		for( j = 0; j < 8; j++ ) crc = ( crc >> 1 ) ^ ( 0xEDB88320 & -( crc & 1 ) );
+	}
+
+	return ~crc;
+}
+
+/**
+	@~English
+	@brief Compare with the check value and the reference
+	@return number of mismatches
+	@~Japanese
+	@brief チェック値と参照実装で確認する関数
+	@return 不一致の数
+**/
+static int _bench_verify( void )
+{
+	const BYTE check[] = "123456789";
+	unsigned int crc, ref;
+	int size, split, errors = 0;
+
+	crc = conexio_cmm920_crc32( 0, check, 9 );
+	printf( "check value %08x ( expected cbf43926 )\n", crc );
+	if( crc != 0xCBF43926 ) errors++;
+
+	for( size = 0; size < BENCH_CHECK_MAX; size++ ){
+		ref = _bench_crc32_bitwise( 0, &bench_buf[size & 7], size );
+		if( conexio_cmm920_crc32( 0, &bench_buf[size & 7], size ) != ref ) errors++;
+
+		// 分割して続けて計算しても同じ値になること
+		split = size / 3;
+		crc = conexio_cmm920_crc32( 0, &bench_buf[size & 7], split );
+		crc = conexio_cmm920_crc32( crc, &bench_buf[( size & 7 ) + split], size - split );
+		if( crc != ref ) errors++;
+	}
+	printf( "lengths 0-%d ( aligned / unaligned / split ) : %d mismatches\n", BENCH_CHECK_MAX - 1, errors );
+
+	return errors;
+}
+
+/**
+	@~English
+	@brief Measure one buffer size
+	@~Japanese
+	@brief 1つのバッファサイズを測定する関数
+**/
+static void _bench_measure( int size, long total )
+{
+	struct timespec t0, t1;
+	long loops, i;
+	double fast, slow;
+
+	loops = total / size;
+	if( loops < 1 ) loops = 1;
+
+	clock_gettime( CLOCK_MONOTONIC, &t0 );
+	for( i = 0; i < loops; i++ ) bench_sink = conexio_cmm920_crc32( bench_sink, bench_buf, size );
+	clock_gettime( CLOCK_MONOTONIC, &t1 );
+	fast = (double)_bench_diff_nsec( &t0, &t1 ) / loops;
+
+	loops = loops / 16 + 1;
+	clock_gettime( CLOCK_MONOTONIC, &t0 );
+	for( i = 0; i < loops; i++ ) bench_sink = _bench_crc32_bitwise( bench_sink, bench_buf, size );
+	clock_gettime( CLOCK_MONOTONIC, &t1 );
+	slow = (double)_bench_diff_nsec( &t0, &t1 ) / loops;
+
+	printf( "%6d bytes  slice-by-8 %10.1f ns %8.1f MB/s   bitwise %10.1f ns %7.1f MB/s\n",
+		size, fast, size * 1e3 / fast, slow, size * 1e3 / slow );
+}
+
+int main( int argc, char *argv[] )
+{
+	static const int sizes[] = { 32, 127, 256, 4096, BENCH_BUF_SIZE };
+	long total = 64L * 1024 * 1024;
+	int opt, i;
+
+	while( ( opt = getopt( argc, argv, "m:" ) ) != -1 ){
+		switch( opt ){
+		case 'm': total = atol( optarg ) * 1024L * 1024L; break;
+		default:
+			fprintf( stderr, "usage : %s [-m megabytes]\n", argv[0] );
+			return 2;
+		}
+	}
+	if( total <= 0 ){
+		fprintf( stderr, "megabytes must be > 0\n" );
+		return 2;
+	}
+
+	srand( 1 );
+	for( i = 0; i < BENCH_BUF_SIZE; i++ ) bench_buf[i] = (BYTE)rand();
+
+	if( _bench_verify() ){
+		printf( "FAIL\n" );
+		return 1;
+	}
+
+	for( i = 0; i < (int)( sizeof(sizes) / sizeof(sizes[0]) ); i++ ) _bench_measure( sizes[i], total );
+
+	return 0;
+}
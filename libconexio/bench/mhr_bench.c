@@ -0,0 +1,190 @@
+/**
+	@file mhr_bench.c
+	@~English
+	@brief Multi hop header ( MHR ) check and microbenchmark
+	@par Checks that every supported address mode round trips through conexio_cmm920_mhr_encode and
+	conexio_cmm920_mhr_decode, and reports the header encode / decode time and the time to build and
+	parse a telegram with byte loop copies and with memcpy and the header view.
+	@par usage : mhr_bench [-n count] [-s payload_size]
+	@~Japanese
+	@brief マルチホップヘッダ ( MHR ) の確認とマイクロベンチマーク
+	@par 対応する全てのアドレスモードが conexio_cmm920_mhr_encode と conexio_cmm920_mhr_decode で
+	元に戻ることを確認し、ヘッダの作成・解析時間と、1バイトずつのコピーと memcpy およびヘッダビューで
+	電文を作成・解析する時間を表示します。
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "libconexio_CMM920.h"
+
+#define BENCH_PAYLOAD_MAX	400	///< maximum payload size
+#define BENCH_FRAME_SIZE	( 3 + 32 + BENCH_PAYLOAD_MAX + 4 )	///< send mode + size + header + payload + FCS
+
+static BYTE bench_frame[BENCH_FRAME_SIZE];
+static BYTE bench_buf[BENCH_FRAME_SIZE];
+static BYTE bench_payload[BENCH_PAYLOAD_MAX];
+static volatile long bench_sink;
+
+static long _bench_diff_nsec( struct timespec *start, struct timespec *end )
+{
+	return ( end->tv_sec - start->tv_sec ) * 1000000000L + ( end->tv_nsec - start->tv_nsec );
+}
+
+/**
+	@~English
+	@brief Round trip every address mode combination
+	@return number of mismatches
+	@~Japanese
+	@brief 全てのアドレスモードの組み合わせを往復させる関数
+	@return 不一致の数
+**/
+static int _bench_verify( void )
+{
+	static const long addr[] = { 0, 0x33, 0x3344 };
+	CONEXIO920MHRVIEW view;
+	unsigned short fc, dest_id, src_id;
+	BYTE mhr[32];
+	int comp, dm, sm, enc, dec, errors = 0;
+
+	for( comp = 0; comp < 2; comp++ ){
+		for( dm = CONEXIO_CMM920_MHR_FC_DESTADDRMODE_NONE; dm <= CONEXIO_CMM920_MHR_FC_DESTADDRMODE_64BIT; dm++ ){
+			for( sm = CONEXIO_CMM920_MHR_FC_SRCADDRMODE_NONE; sm <= CONEXIO_CMM920_MHR_FC_SRCADDRMODE_64BIT; sm++ ){
+				fc = CONEXIO_CMM920_MHR_FC( sm, 0, dm, 0, comp, 0, 0, 0, 1 );
+				memset( mhr, 0, sizeof(mhr) );
+				enc = conexio_cmm920_mhr_encode( mhr, fc, 0x1111, 0x2222,
+					( dm < 3 ) ? addr[dm] : 0, ( sm < 3 ) ? ( addr[sm] + 0x2222 ) & ( sm == 1 ? 0xFF : 0xFFFF ) : 0 );
+				if( dm == 3 || sm == 3 ){
+					// 64bit アドレスは未対応
+					if( enc != -1 ) errors++;
+					continue;
+				}
+
+				dec = conexio_cmm920_mhr_decode( mhr, enc + 5, &view );
+				dest_id = dm ? 0x1111 : 0;
+				src_id = ( sm && !comp ) ? 0x2222 : dest_id;
+				if( enc <= 0 || dec != enc || view.fc != fc || view.size != 5 || view.payload != &mhr[enc] ||
+					view.dest_id != dest_id || view.src_id != src_id ||
+					view.dest_addr != addr[dm] ||
+					view.src_addr != ( sm ? ( ( addr[sm] + 0x2222 ) & ( sm == 1 ? 0xFF : 0xFFFF ) ) : 0 ) ){
+					printf( "mismatch : panidcomp %d dest mode %d src mode %d ( encode %d decode %d )\n", comp, dm, sm, enc, dec );
+					errors++;
+				}
+			}
+		}
+	}
+	printf( "address mode combinations : %d mismatches\n", errors );
+
+	return errors;
+}
+
+/**
+	@~English
+	@brief Measure the header encode and decode
+	@~Japanese
+	@brief ヘッダの作成と解析を測定する関数
+**/
+static void _bench_header( long num )
+{
+	const unsigned short fc = CONEXIO_CMM920_MHR_FC( CONEXIO_CMM920_MHR_FC_SRCADDRMODE_16BIT, 0,
+		CONEXIO_CMM920_MHR_FC_DESTADDRMODE_16BIT, 0, 0, 0, 0, 0, 1 );
+	CONEXIO920MHRVIEW view;
+	struct timespec t0, t1, t2;
+	long i;
+
+	clock_gettime( CLOCK_MONOTONIC, &t0 );
+	for( i = 0; i < num; i++ ){
+		conexio_cmm920_mhr_encode( &bench_frame[3], fc, 0x1234, 0xABCD, i & 0xFFFF, 0x9ABC );
+		bench_sink += bench_frame[8];
+	}
+	clock_gettime( CLOCK_MONOTONIC, &t1 );
+	for( i = 0; i < num; i++ ){
+		bench_frame[8] = (BYTE)i;
+		conexio_cmm920_mhr_decode( &bench_frame[3], 0, &view );
+		bench_sink += view.dest_addr;
+	}
+	clock_gettime( CLOCK_MONOTONIC, &t2 );
+
+	printf( "header ( 16bit / 16bit )         encode %6.1f ns   decode %6.1f ns\n",
+		(double)_bench_diff_nsec( &t0, &t1 ) / num, (double)_bench_diff_nsec( &t1, &t2 ) / num );
+}
+
+/**
+	@~English
+	@brief Measure the telegram build and parse with the payload moves
+	@~Japanese
+	@brief ペイロードの移動を含む電文の作成と解析を測定する関数
+**/
+static void _bench_telegram( long num, int size )
+{
+	const unsigned short fc = CONEXIO_CMM920_MHR_FC( CONEXIO_CMM920_MHR_FC_SRCADDRMODE_16BIT, 0,
+		CONEXIO_CMM920_MHR_FC_DESTADDRMODE_16BIT, 0, 0, 0, 0, 0, 1 );
+	CONEXIO920MHRVIEW view;
+	struct timespec t0, t1, t2;
+	long n;
+	int off, len, i;
+
+	off = conexio_cmm920_mhr_layout( fc )->size;
+	len = off + size + 4;
+
+	// 1バイトずつコピーしてペイロードを先頭に詰める
+	clock_gettime( CLOCK_MONOTONIC, &t0 );
+	for( n = 0; n < num; n++ ){
+		conexio_cmm920_mhr_encode( &bench_frame[3], fc, 1, 2, 3, 4 );
+		for( i = 0; i < size; i++ ) bench_frame[3 + off + i] = bench_payload[i];
+		for( i = 0; i < len; i++ ) bench_buf[i] = bench_frame[3 + i];
+		conexio_cmm920_mhr_decode( bench_buf, len, &view );
+		for( i = off; i < len; i++ ) bench_buf[i - off] = bench_buf[i];
+		for( i = len - off; i < len; i++ ) bench_buf[i] = 0;
+		bench_sink += bench_buf[5];
+	}
+	clock_gettime( CLOCK_MONOTONIC, &t1 );
+
+	// memcpy / memmove とヘッダビュー
+	for( n = 0; n < num; n++ ){
+		conexio_cmm920_mhr_encode( &bench_frame[3], fc, 1, 2, 3, 4 );
+		memcpy( &bench_frame[3 + off], bench_payload, size );
+		memcpy( bench_buf, &bench_frame[3], len );
+		conexio_cmm920_mhr_decode( bench_buf, len, &view );
+		memmove( bench_buf, view.payload, view.size );
+		memset( &bench_buf[view.size], 0, off );
+		bench_sink += bench_buf[5];
+	}
+	clock_gettime( CLOCK_MONOTONIC, &t2 );
+
+	printf( "%3d byte telegram build + parse  byte loop %6.1f ns   memcpy + view %6.1f ns\n", size,
+		(double)_bench_diff_nsec( &t0, &t1 ) / num, (double)_bench_diff_nsec( &t1, &t2 ) / num );
+}
+
+int main( int argc, char *argv[] )
+{
+	long num = 5000000;
+	int size = 200, opt, i;
+
+	while( ( opt = getopt( argc, argv, "n:s:" ) ) != -1 ){
+		switch( opt ){
+		case 'n': num = atol( optarg ); break;
+		case 's': size = atoi( optarg ); break;
+		default:
+			fprintf( stderr, "usage : %s [-n count] [-s payload_size]\n", argv[0] );
+			return 2;
+		}
+	}
+	if( num <= 0 || size < 1 || size > BENCH_PAYLOAD_MAX ){
+		fprintf( stderr, "count must be > 0 and payload_size 1..%d\n", BENCH_PAYLOAD_MAX );
+		return 2;
+	}
+
+	for( i = 0; i < BENCH_PAYLOAD_MAX; i++ ) bench_payload[i] = (BYTE)i;
+
+	if( _bench_verify() ){
+		printf( "FAIL\n" );
+		return 1;
+	}
+
+	_bench_header( num );
+	_bench_telegram( num, size );
+
+	return 0;
+}
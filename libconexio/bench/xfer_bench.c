@@ -0,0 +1,152 @@
+/**
+	@file xfer_bench.c
+	@~English
+	@brief Fragmented transfer goodput over the simulated lossy link
+	@par Sends a payload from one simulated module to the other with conexio_cmm920_xfer_send_h
+	at 50 kbps and 100 kbps, with and without telegram loss, and reports the goodput.
+	@par usage : xfer_bench [-s size] [-w window] [-t timeout_msec] [-r retry] [-l loss_ppm]
+	@~Japanese
+	@brief 模擬的なロスのあるリンク上での分割転送の実効スループット
+	@par conexio_cmm920_xfer_send_h で一方の模擬モジュールから他方へデータを送り、50kbps と 100kbps、
+	電文ロスあり・なしでの実効スループットを表示します。
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "libconexio_CMM920.h"
+#include "cmm920_sim.h"
+
+#define BENCH_RECV_TIMEOUT_MSEC	10000	///< receiver timeout
+#define BENCH_LINGER_MSEC	100	///< receive timeout while waiting for the sender to finish
+
+static BYTE bench_src[CONEXIO_CMM920_XFER_SIZE_MAX];
+static BYTE bench_dst[CONEXIO_CMM920_XFER_SIZE_MAX];
+
+/// receiver thread information
+typedef struct __bench_receiver__{
+	CONEXIO920HANDLE ctx;
+	CONEXIO920XFER xfer;
+	int ret;
+	volatile int stop;
+} BENCH_RECEIVER;
+
+static void* _bench_recv_thread( void *arg )
+{
+	BENCH_RECEIVER *rx = (BENCH_RECEIVER *)arg;
+
+	rx->ret = conexio_cmm920_xfer_recv_h( rx->ctx, &rx->xfer, CONEXIO_CMM920_HOP_MULTI, BENCH_RECV_TIMEOUT_MSEC );
+
+	// 完了の確認応答が失われた場合に再送できるよう、送信側が終わるまで受信を続ける
+	while( !rx->stop ) conexio_cmm920_xfer_recv_h( rx->ctx, &rx->xfer, CONEXIO_CMM920_HOP_MULTI, BENCH_LINGER_MSEC );
+	return NULL;
+}
+
+/**
+	@~English
+	@brief Run one transfer
+	@return Success : 0 , Failed : otherwise 0
+	@~Japanese
+	@brief 1回の転送を行う関数
+	@return 成功:  0 失敗 :  0以外
+**/
+static int _bench_run( long bitrate, long loss_ppm, int size, int window, int timeout_msec, int retry )
+{
+	CMM920SIMCONFIG config;
+	CMM920SIMSTAT sim;
+	CONEXIO920XFERSTAT stat;
+	CONEXIO920HANDLE tx;
+	BENCH_RECEIVER rx;
+	pthread_t thread;
+	char name[2][CMM920_SIM_NAME_SIZE];
+	unsigned short dest_id = 0x1234, src_id = 0x1234;
+	long dest_addr = 2, src_addr = 1;
+	int ret, ok;
+
+	cmm920_sim_default_config( &config );
+	config.bitrate = bitrate;
+	config.loss_ppm = loss_ppm;
+	config.echo = 0;
+
+	if( cmm920_sim_start( 2, &config, name ) ) return -1;
+	tx = conexio_cmm920_open( name[0] );
+	rx.ctx = conexio_cmm920_open( name[1] );
+	if( tx == NULL || rx.ctx == NULL ){
+		if( tx != NULL ) conexio_cmm920_close( tx );
+		if( rx.ctx != NULL ) conexio_cmm920_close( rx.ctx );
+		cmm920_sim_stop();
+		return -1;
+	}
+
+	conexio_cmm920_xfer_init( &rx.xfer, bench_dst, sizeof(bench_dst) );
+	memset( bench_dst, 0, sizeof(bench_dst) );
+	rx.stop = 0;
+	pthread_create( &thread, NULL, _bench_recv_thread, &rx );
+	usleep( 20000 );
+
+	memset( &stat, 0, sizeof(stat) );
+	ret = conexio_cmm920_xfer_send_h( tx, bench_src, size, CONEXIO_CMM920_HOP_MULTI,
+		&dest_id, &src_id, &dest_addr, &src_addr, window, timeout_msec, retry, &stat );
+	rx.stop = 1;
+	pthread_join( thread, NULL );
+
+	ok = ( ret == 0 && rx.ret == 0 && rx.xfer.size == size && memcmp( bench_src, bench_dst, size ) == 0 );
+
+	conexio_cmm920_close( tx );
+	conexio_cmm920_close( rx.ctx );
+	cmm920_sim_get_stat( &sim );
+	cmm920_sim_stop();
+
+	printf( "%4ld kbps loss %4.1f%%  %s  %6.2f s  goodput %6.1f kbit/s ( %4.1f%% of air rate )"
+		"  fragments %lu sent %lu retransmit %lu timeout %lu  air lost %lu\n",
+		bitrate / 1000, loss_ppm / 10000.0, ok ? "ok  " : "FAIL",
+		stat.elapsed / 1e6, stat.goodput / 1000.0, 100.0 * stat.goodput / bitrate,
+		stat.fragments, stat.sent, stat.retransmit, stat.timeout, sim.lost );
+
+	return !ok;
+}
+
+int main( int argc, char *argv[] )
+{
+	static const long bitrate[] = { 50000, 100000 };
+	long loss[2] = { 0, 50000 };
+	int size = 16384, window = CONEXIO_CMM920_XFER_WINDOW_MAX, timeout_msec = 500, retry = 5;
+	int opt, i, j, ret, fail = 0;
+
+	while( ( opt = getopt( argc, argv, "s:w:t:r:l:" ) ) != -1 ){
+		switch( opt ){
+		case 's': size = atoi( optarg ); break;
+		case 'w': window = atoi( optarg ); break;
+		case 't': timeout_msec = atoi( optarg ); break;
+		case 'r': retry = atoi( optarg ); break;
+		case 'l': loss[1] = atol( optarg ); break;
+		default:
+			fprintf( stderr, "usage : %s [-s size] [-w window] [-t timeout_msec] [-r retry] [-l loss_ppm]\n", argv[0] );
+			return 2;
+		}
+	}
+	if( size <= 0 || size > CONEXIO_CMM920_XFER_SIZE_MAX ){
+		fprintf( stderr, "size must be 1..%d\n", CONEXIO_CMM920_XFER_SIZE_MAX );
+		return 2;
+	}
+
+	srand( 1 );
+	for( i = 0; i < size; i++ ) bench_src[i] = (BYTE)rand();
+
+	printf( "transfer %d bytes, window %d, ack timeout %d ms, retry %d\n", size, window, timeout_msec, retry );
+
+	for( i = 0; i < 2; i++ ){
+		for( j = 0; j < 2; j++ ){
+			ret = _bench_run( bitrate[i], loss[j], size, window, timeout_msec, retry );
+			if( ret < 0 ){
+				fprintf( stderr, "simulator start failed\n" );
+				return 1;
+			}
+			// a lossless transfer must always complete
+			if( ret && loss[j] == 0 ) fail = 1;
+		}
+	}
+
+	return fail;
+}
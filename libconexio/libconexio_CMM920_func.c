@@ -31,6 +31,25 @@
     update 2016.07.20 (1) Fixed Received Data divided into two.
 	update 2016.07.29 (1) Added Received Data Timeout Error.
 	update 2019.05.08 (1) Fixed freeConexioCMM920_packet. 
+	update 2026.10.19 (1) Changed RecvCommandAck to wait with poll() until a per-command deadline.
+	                  (2) Added command round trip time functions.
+	                  (3) Changed packet functions to use a static frame pool instead of malloc.
+	                  (4) Changed packet syslog dumps to the wire trace functions.
+	                  (5) Added receive thread functions.
+	                  (6) Added transmit queue functions.
+	                  (7) Moved module state into instance handles and added _h functions.
+	                  (8) Added configuration cache.
+	                  (9) Added LSI transaction and profile functions.
+	                  (10) Fixed _conexio_cmm920_send_recv sends LSI address on LSI read.
+	                  (11) Changed the fixed wait of _conexio_cmm920_send_recv to a learned response deadline.
+	                  (12) Added fragmented transfer functions.
+	                  (13) Added statistics functions.
+	                  (14) Added CRC-32 check of received telegrams.
+	                  (15) Fixed crc value of RecvTelegramSingleHop.
+	                  (16) Changed MHR functions to use precomputed header layouts.
+	                  (17) Added link quality functions and adaptive retry of the transmit queue.
+	                  (18) Fixed the transmit queue thread shares the send buffer between instances.
+	                  (19) Added airtime budget of telegrams and priority of the transmit queue.
 ***/
 
 #include <stdio.h>
@@ -39,6 +58,9 @@
 #include <termios.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
 #include <sys/ioctl.h>
 #include <time.h>
 #include <sys/time.h>
@@ -89,12 +111,540 @@
 
 /// @}
 
-int iWait;		// ウェイト時間
 
 
-static int global_seq_num = 0;
-static int iPort;
-static short global_getLastError = 0;
+
+#define CONEXIO_CMM920_DEFAULT_TIMEOUT_MSEC	1000	///< default response deadline
+#define CONEXIO_CMM920_BODY_TIMEOUT_MSEC	100	///< minimum time to receive the rest of a started frame
+#define CONEXIO_CMM920_WAIT_LEARN_NUM	4	///< number of responses before the learned deadline is used
+#define CONEXIO_CMM920_WAIT_MIN_MSEC	100	///< minimum learned deadline
+
+/// command list ( mode, command )
+static const BYTE conexio_cmm920_command_list[][2] = {
+	{ CONEXIO_CMM920_MODE_COMMON, CONEXIO_CMM920_RESET },
+	{ CONEXIO_CMM920_MODE_COMMON, CONEXIO_CMM920_SET_MODE },
+	{ CONEXIO_CMM920_MODE_COMMON, CONEXIO_CMM920_SET_WIRELESS },
+	{ CONEXIO_CMM920_MODE_COMMON, CONEXIO_CMM920_SET_ANTENNA },
+	{ CONEXIO_CMM920_MODE_COMMON, CONEXIO_CMM920_SET_ADDRESS },
+	{ CONEXIO_CMM920_MODE_COMMON, CONEXIO_CMM920_SET_ACK },
+	{ CONEXIO_CMM920_MODE_COMMON, CONEXIO_CMM920_SET_TIMER },
+	{ CONEXIO_CMM920_MODE_COMMON, CONEXIO_CMM920_SET_VERSION },
+	{ CONEXIO_CMM920_MODE_COMMON, CONEXIO_CMM920_SET_LSI },
+	{ CONEXIO_CMM920_MODE_RUN, CONEXIO_CMM920_SENDDATA },
+};
+
+#define CONEXIO_CMM920_COMMAND_NUM	( sizeof(conexio_cmm920_command_list) / sizeof(conexio_cmm920_command_list[0]) )
+
+#define CONEXIO_CMM920_CONFIG_DATA_MAX	16	///< maximum cached configuration data size
+
+
+#define CONEXIO_CMM920_FRAME_HEAD_SIZE	8	///< DLE STX size(2) command(2) result(2)
+#define CONEXIO_CMM920_FRAME_FOOT_SIZE	3	///< sum DLE ETX
+#define CONEXIO_CMM920_FRAME_DATA_MAX	512	///< maximum data size
+#define CONEXIO_CMM920_FRAME_SIZE	( CONEXIO_CMM920_FRAME_HEAD_SIZE + CONEXIO_CMM920_FRAME_DATA_MAX + CONEXIO_CMM920_FRAME_FOOT_SIZE )
+#define CONEXIO_CMM920_FRAME_POOL_NUM	8	///< number of frames in the pool ( shared by all instances )
+
+static BYTE global_frame_pool[CONEXIO_CMM920_FRAME_POOL_NUM][CONEXIO_CMM920_FRAME_SIZE];	///< frame pool
+static int global_frame_used[CONEXIO_CMM920_FRAME_POOL_NUM];	///< frame pool in use flag
+static int global_frame_in_use = 0;	///< number of frames in use
+static int global_frame_peak = 0;	///< maximum number of frames in use
+static unsigned long global_frame_get = 0;	///< number of frames taken from the pool
+static unsigned long global_frame_empty = 0;	///< number of pool allocation failures
+
+#define CONEXIO_CMM920_TRACE_RING_NUM	64	///< number of trace ring entries ( power of 2 )
+#define CONEXIO_CMM920_TRACE_DEFAULT_RATE	10	///< default text trace rate ( frames / sec )
+#define CONEXIO_CMM920_TRACE_LINE_BYTES	64	///< bytes per text trace line
+
+static int global_trace_level = CONEXIO_CMM920_TRACE_OFF;	///< trace level
+static int global_trace_rate = CONEXIO_CMM920_TRACE_DEFAULT_RATE;	///< text trace rate ( frames / sec )
+static unsigned long global_trace_seq = 0;	///< last trace sequence number
+static CONEXIO920TRACE global_trace_ring[CONEXIO_CMM920_TRACE_RING_NUM];	///< trace ring
+static long global_trace_window = 0;	///< text trace rate window ( sec )
+static int global_trace_window_count = 0;	///< text trace count in the window
+static unsigned long global_trace_suppressed = 0;	///< suppressed text trace count
+
+static const char conexio_cmm920_hex_table[] = "0123456789ABCDEF";
+
+#define CONEXIO_CMM920_CRC_SIZE	4	///< telegram CRC size ( FCS )
+#define CONEXIO_CMM920_CRC_POLY	0xEDB88320	///< CRC-32 polynomial ( reflected )
+
+#define CONEXIO_CMM920_MHR_ADDR_SIZE( mode )	( (mode) == 3 ? 8 : (mode) )	///< address size of address mode
+#define CONEXIO_CMM920_MHR_DEST_SIZE( dest )	( (dest) ? 2 + CONEXIO_CMM920_MHR_ADDR_SIZE( dest ) : 0 )	///< dest PAN ID + address size
+#define CONEXIO_CMM920_MHR_SRCID( src, comp )	( (src) && !(comp) )	///< source PAN ID is present
+
+/// MHR layout ( dest mode, source mode, PAN ID compression )
+#define CONEXIO_CMM920_MHR_LAYOUT( dest, src, comp )	{	\
+	(dest) != 3 && (src) != 3,	\
+	3 + CONEXIO_CMM920_MHR_DEST_SIZE( dest ) + ( (src) ? CONEXIO_CMM920_MHR_SRCID( src, comp ) * 2 + CONEXIO_CMM920_MHR_ADDR_SIZE( src ) : 0 ),	\
+	(dest) ? 3 : 0,	\
+	5,	\
+	CONEXIO_CMM920_MHR_ADDR_SIZE( dest ),	\
+	CONEXIO_CMM920_MHR_SRCID( src, comp ) ? 3 + CONEXIO_CMM920_MHR_DEST_SIZE( dest ) : 0,	\
+	3 + CONEXIO_CMM920_MHR_DEST_SIZE( dest ) + CONEXIO_CMM920_MHR_SRCID( src, comp ) * 2,	\
+	CONEXIO_CMM920_MHR_ADDR_SIZE( src )	\
+}
+
+/// MHR layout table ( index : dest mode + source mode * 4 + PAN ID compression * 16 )
+static const CONEXIO920MHRLAYOUT conexio_cmm920_mhr_layout_table[CONEXIO_CMM920_MHR_LAYOUT_NUM] = {
+	CONEXIO_CMM920_MHR_LAYOUT( 0, 0, 0 ), CONEXIO_CMM920_MHR_LAYOUT( 1, 0, 0 ), CONEXIO_CMM920_MHR_LAYOUT( 2, 0, 0 ), CONEXIO_CMM920_MHR_LAYOUT( 3, 0, 0 ),
+	CONEXIO_CMM920_MHR_LAYOUT( 0, 1, 0 ), CONEXIO_CMM920_MHR_LAYOUT( 1, 1, 0 ), CONEXIO_CMM920_MHR_LAYOUT( 2, 1, 0 ), CONEXIO_CMM920_MHR_LAYOUT( 3, 1, 0 ),
+	CONEXIO_CMM920_MHR_LAYOUT( 0, 2, 0 ), CONEXIO_CMM920_MHR_LAYOUT( 1, 2, 0 ), CONEXIO_CMM920_MHR_LAYOUT( 2, 2, 0 ), CONEXIO_CMM920_MHR_LAYOUT( 3, 2, 0 ),
+	CONEXIO_CMM920_MHR_LAYOUT( 0, 3, 0 ), CONEXIO_CMM920_MHR_LAYOUT( 1, 3, 0 ), CONEXIO_CMM920_MHR_LAYOUT( 2, 3, 0 ), CONEXIO_CMM920_MHR_LAYOUT( 3, 3, 0 ),
+	CONEXIO_CMM920_MHR_LAYOUT( 0, 0, 1 ), CONEXIO_CMM920_MHR_LAYOUT( 1, 0, 1 ), CONEXIO_CMM920_MHR_LAYOUT( 2, 0, 1 ), CONEXIO_CMM920_MHR_LAYOUT( 3, 0, 1 ),
+	CONEXIO_CMM920_MHR_LAYOUT( 0, 1, 1 ), CONEXIO_CMM920_MHR_LAYOUT( 1, 1, 1 ), CONEXIO_CMM920_MHR_LAYOUT( 2, 1, 1 ), CONEXIO_CMM920_MHR_LAYOUT( 3, 1, 1 ),
+	CONEXIO_CMM920_MHR_LAYOUT( 0, 2, 1 ), CONEXIO_CMM920_MHR_LAYOUT( 1, 2, 1 ), CONEXIO_CMM920_MHR_LAYOUT( 2, 2, 1 ), CONEXIO_CMM920_MHR_LAYOUT( 3, 2, 1 ),
+	CONEXIO_CMM920_MHR_LAYOUT( 0, 3, 1 ), CONEXIO_CMM920_MHR_LAYOUT( 1, 3, 1 ), CONEXIO_CMM920_MHR_LAYOUT( 2, 3, 1 ), CONEXIO_CMM920_MHR_LAYOUT( 3, 3, 1 ),
+};
+
+#define CONEXIO_CMM920_MHR_FC_DEFAULT	CONEXIO_CMM920_MHR_FC( CONEXIO_CMM920_MHR_FC_SRCADDRMODE_16BIT, 0x00, CONEXIO_CMM920_MHR_FC_DESTADDRMODE_16BIT, 0, 0, 0, 0, 0, 1 )	///< frame control of sent telegrams
+
+static unsigned int global_crc_table[8][256];	///< CRC-32 slice-by-8 table
+static pthread_once_t global_crc_once = PTHREAD_ONCE_INIT;	///< CRC-32 table initialize flag
+
+#define CONEXIO_CMM920_RECV_QUEUE_NUM	16	///< number of received telegram queue entries ( power of 2 )
+#define CONEXIO_CMM920_RECV_THREAD_POLL_MSEC	100	///< receive thread stop check interval
+
+
+#define CONEXIO_CMM920_TXQ_NUM	32	///< number of transmit queue entries
+#define CONEXIO_CMM920_TXQ_DEST_NUM	64	///< number of destinations for statistics
+#define CONEXIO_CMM920_TXQ_POLL_MSEC	10	///< transmit queue timeout check interval
+
+#define CONEXIO_CMM920_LINK_NUM	64	///< number of nodes in the link table
+#define CONEXIO_CMM920_LINK_LEARN_NUM	4	///< number of sends before the adaptive retry count and timeout are used
+#define CONEXIO_CMM920_LINK_TIMEOUT_MIN_MSEC	100	///< minimum adaptive response timeout
+#define CONEXIO_CMM920_LINK_RETRY_MIN	1	///< minimum adaptive retry count
+#define CONEXIO_CMM920_LINK_RETRY_MAX	8	///< maximum adaptive retry count
+#define CONEXIO_CMM920_LINK_TARGET_LOSS	10	///< target loss after all retries (1/1000)
+
+#define CONEXIO_CMM920_AIRTIME_SLOT_NUM	64	///< number of slots in the airtime budget window
+#define CONEXIO_CMM920_AIRTIME_PHY_SIZE	8	///< PHY overhead size ( preamble 4, SFD 2, PHR 2 )
+#define CONEXIO_CMM920_AIRTIME_DEFAULT_BITRATE	100000	///< bit rate until the wireless setting is read (bps)
+#define CONEXIO_CMM920_AIRTIME_DEFAULT_WINDOW_MSEC	3600000	///< default airtime budget window ( 1 hour )
+
+#define CONEXIO_CMM920_XFER_TYPE_DATA	0xD0	///< fragment
+#define CONEXIO_CMM920_XFER_TYPE_DATA_ACKREQ	0xD1	///< fragment with acknowledge request ( last fragment of a window )
+#define CONEXIO_CMM920_XFER_TYPE_ACK	0xDA	///< acknowledge ( header + bitmap )
+#define CONEXIO_CMM920_XFER_ACK_MAP	8	///< acknowledge bitmap size ( fragments from base to base + 63 )
+
+#define CONEXIO_CMM920_TXQ_FREE	0	///< entry is free
+#define CONEXIO_CMM920_TXQ_PENDING	1	///< entry is waiting to be sent
+#define CONEXIO_CMM920_TXQ_INFLIGHT	2	///< entry is sent and waiting for the response
+
+/// transmit queue entry
+typedef struct __conexioCMM920_txq_entry{
+	int state;	///< CONEXIO_CMM920_TXQ_FREE, PENDING or INFLIGHT
+	int id;	///< request id
+	unsigned long order;	///< queued order
+	int priority;	///< priority ( higher first )
+	int deferred;	///< send was deferred by the airtime budget
+	int send_mode;	///< send mode
+	unsigned short dest_id;	///< dest PAN ID
+	unsigned short src_id;	///< source PAN ID
+	long dest_addr;	///< dest address
+	long src_addr;	///< source address
+	BYTE seq_no;	///< MHR sequence number of the last send
+	int retry;	///< number of retries
+	long timeout;	///< response timeout of the last send (usec)
+	struct timespec send_time;	///< last send time
+	int size;	///< data size
+	BYTE data[CONEXIO_CMM920_FRAME_DATA_MAX];	///< data
+} CONEXIO920TXQENTRY, *PCONEXIO920TXQENTRY;
+
+/// instance context
+struct __conexioCMM920_context{
+	int iPort;	///< serial port
+	int seq_num;	///< MHR sequence number
+	short getLastError;	///< last error code
+
+	int timeout_msec[CONEXIO_CMM920_COMMAND_NUM];	///< response deadline per command ( 0 : learned )
+	CONEXIO920RTT rtt[CONEXIO_CMM920_COMMAND_NUM];	///< round trip time per command
+	CONEXIO920WAITPROFILE wait[CONEXIO_CMM920_COMMAND_NUM];	///< learned response wait per command
+	struct timespec send_time[CONEXIO_CMM920_COMMAND_NUM];	///< last send time per command
+	BYTE send_pending[CONEXIO_CMM920_COMMAND_NUM];	///< waiting for the response of last send
+
+	BYTE config[CONEXIO_CMM920_COMMAND_NUM][CONEXIO_CMM920_CONFIG_DATA_MAX];	///< cached configuration data per command ( without read/write flag )
+	BYTE config_valid[CONEXIO_CMM920_COMMAND_NUM];	///< cached configuration is valid
+	pthread_mutex_t config_mutex;	///< configuration cache mutex
+
+	pthread_t recv_thread;	///< receive thread
+	volatile int recv_thread_active;	///< receive thread is running
+	volatile int recv_thread_stop;	///< receive thread stop request
+	CONEXIO920RECVCALLBACK recv_callback;	///< telegram callback
+	void *recv_callback_arg;	///< telegram callback argument
+	BYTE recv_thread_frame[CONEXIO_CMM920_FRAME_SIZE];	///< receive thread frame
+	BYTE recv_queue[CONEXIO_CMM920_RECV_QUEUE_NUM][CONEXIO_CMM920_FRAME_SIZE];	///< telegram queue ( single producer, single consumer )
+	int recv_queue_length[CONEXIO_CMM920_RECV_QUEUE_NUM];	///< telegram queue frame length
+	volatile unsigned int recv_queue_head;	///< telegram queue read position
+	volatile unsigned int recv_queue_tail;	///< telegram queue write position
+	unsigned long recv_queue_drop;	///< dropped telegram count ( queue full )
+	BYTE recv_ack_frame[CONEXIO_CMM920_COMMAND_NUM + 1][CONEXIO_CMM920_FRAME_SIZE];	///< last received command acknowledge per command ( last : other commands )
+	int recv_ack_length[CONEXIO_CMM920_COMMAND_NUM + 1];	///< last received command acknowledge length per command ( 0 : none )
+	pthread_mutex_t recv_mutex;	///< receive thread mutex
+	pthread_mutex_t send_mutex;	///< send mutex ( frame encode, write and send bookkeeping )
+	pthread_cond_t recv_cond;	///< receive thread condition ( CLOCK_MONOTONIC )
+
+	pthread_t txq_thread;	///< transmit queue thread
+	volatile int txq_active;	///< transmit queue is running
+	volatile int txq_stop;	///< transmit queue stop request
+	int txq_window;	///< maximum number of in-flight telegrams
+	int txq_timeout_msec;	///< response timeout
+	int txq_retry;	///< maximum number of retries
+	CONEXIO920TXCALLBACK txq_callback;	///< completion callback
+	void *txq_callback_arg;	///< completion callback argument
+	int txq_next_id;	///< next request id
+	unsigned long txq_order;	///< next queued order
+	CONEXIO920TXQENTRY txq[CONEXIO_CMM920_TXQ_NUM];	///< transmit queue
+	CONEXIO920TXQSTAT txq_stat[CONEXIO_CMM920_TXQ_DEST_NUM];	///< statistics per destination
+	int txq_stat_num;	///< number of destinations in statistics
+	pthread_mutex_t txq_mutex;	///< transmit queue mutex
+	pthread_cond_t txq_cond;	///< transmit queue condition ( CLOCK_MONOTONIC )
+
+	CONEXIO920LINK link[CONEXIO_CMM920_LINK_NUM];	///< link quality per node
+	unsigned long link_used[CONEXIO_CMM920_LINK_NUM];	///< link table last used order
+	unsigned long link_order;	///< next link table used order
+	int link_num;	///< number of nodes in the link table
+	int link_adaptive;	///< CONEXIO_CMM920_LINK_ADAPTIVE_OFF or CONEXIO_CMM920_LINK_ADAPTIVE_ON
+	pthread_mutex_t link_mutex;	///< link table mutex
+
+	long airtime_bitrate;	///< bit rate (bps)
+	long airtime_window_msec;	///< airtime budget window (msec)
+	long airtime_budget_msec;	///< airtime budget in the window (msec) ( 0 : no limit )
+	long long airtime_slot_usec;	///< slot length (usec)
+	long long airtime_slot_no;	///< current slot number
+	long long airtime_slot[CONEXIO_CMM920_AIRTIME_SLOT_NUM + 1];	///< airtime per slot (usec) ( ring )
+	long long airtime_used;	///< airtime in the window (usec)
+	CONEXIO920AIRTIME airtime_stat;	///< airtime statistics ( sent, total_usec, rejected and deferred are used )
+	pthread_mutex_t airtime_mutex;	///< airtime mutex
+
+	BYTE xfer_id;	///< next fragmented transfer id
+
+	CONEXIO920STAT stat;	///< statistics ( frame pool members are not used )
+
+	int crc_check;	///< CONEXIO_CMM920_CRC_CHECK_OFF or CONEXIO_CMM920_CRC_CHECK_ON
+	BYTE crc_inverse;	///< LSI CRC calculate inverse setting
+};
+
+/// default instance ( functions without handle )
+static struct __conexioCMM920_context global_default_context = {
+	.recv_mutex = PTHREAD_MUTEX_INITIALIZER,
+	.send_mutex = PTHREAD_MUTEX_INITIALIZER,
+	.config_mutex = PTHREAD_MUTEX_INITIALIZER,
+	.txq_mutex = PTHREAD_MUTEX_INITIALIZER,
+	.txq_window = 1,
+	.txq_timeout_msec = CONEXIO_CMM920_DEFAULT_TIMEOUT_MSEC,
+	.link_adaptive = CONEXIO_CMM920_LINK_ADAPTIVE_ON,
+	.link_mutex = PTHREAD_MUTEX_INITIALIZER,
+	.airtime_bitrate = CONEXIO_CMM920_AIRTIME_DEFAULT_BITRATE,
+	.airtime_window_msec = CONEXIO_CMM920_AIRTIME_DEFAULT_WINDOW_MSEC,
+	.airtime_slot_usec = CONEXIO_CMM920_AIRTIME_DEFAULT_WINDOW_MSEC * 1000LL / CONEXIO_CMM920_AIRTIME_SLOT_NUM,
+	.airtime_mutex = PTHREAD_MUTEX_INITIALIZER,
+};
+
+/**
+	@~English
+	@brief Get the default instance handle used by the functions without a handle
+	@return default instance handle
+	@~Japanese
+	@brief ハンドルを持たない関数が使用する既定のインスタンスハンドルを取得する関数
+	@return 既定のインスタンスハンドル
+**/
+CONEXIO920HANDLE conexio_cmm920_default_handle( void )
+{
+	return &global_default_context;
+}
+
+
+/**
+	@~English
+	@brief get command table index function
+	@param mode : CMM920 mode
+	@param command : CMM920 command
+	@return Success: index , Failed : -1
+	@~Japanese
+	@brief コマンドテーブルの番号を取得する関数
+	@param mode : CMM920 モード
+	@param command : CMM920 コマンド
+	@return 成功:  番号 失敗 : -1
+**/
+static int _conexio_cmm920_command_index( BYTE mode, BYTE command )
+{
+	int i;
+
+	for( i = 0; i < (int)CONEXIO_CMM920_COMMAND_NUM; i++ ){
+		if( conexio_cmm920_command_list[i][0] == mode &&
+			conexio_cmm920_command_list[i][1] == command ){
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+	@~English
+	@brief Get the acknowledge slot of command
+	@param mode : CMM920 mode
+	@param command : CMM920 command
+	@return slot number ( commands not in the list share the last slot )
+	@~Japanese
+	@brief コマンドの応答を格納する番号を取得する関数
+	@param mode : CMM920 モード
+	@param command : CMM920 コマンド
+	@return 番号 ( 一覧にないコマンドは最後の番号を共有します )
+**/
+static int _conexio_cmm920_ack_index( BYTE mode, BYTE command )
+{
+	int index = _conexio_cmm920_command_index( mode, command );
+
+	return ( index >= 0 ) ? index : (int)CONEXIO_CMM920_COMMAND_NUM;
+}
+
+/**
+	@~English
+	@brief Get the configuration cache index of command
+	@param mode : CMM920 mode
+	@param command : CMM920 command
+	@return Success : index , Not cached : -1
+	@~Japanese
+	@brief 設定キャッシュの対象コマンドの番号を取得する関数
+	@param mode : CMM920 モード
+	@param command : CMM920 コマンド
+	@return 成功:  番号 キャッシュ対象外 : -1
+	@par 読み出しと書き込みで同じデータ形式を持つ設定コマンドのみキャッシュします。
+**/
+static int _conexio_cmm920_config_index( BYTE mode, BYTE command )
+{
+	if( mode != CONEXIO_CMM920_MODE_COMMON ) return -1;
+
+	switch( command ){
+	case CONEXIO_CMM920_SET_MODE:
+	case CONEXIO_CMM920_SET_WIRELESS:
+	case CONEXIO_CMM920_SET_ANTENNA:
+	case CONEXIO_CMM920_SET_ADDRESS:
+	case CONEXIO_CMM920_SET_ACK:
+	case CONEXIO_CMM920_SET_TIMER:
+		return _conexio_cmm920_command_index( mode, command );
+	}
+	return -1;
+}
+
+/**
+	@~English
+	@brief Read the configuration cache
+	@param ctx : instance handle
+	@param config : configuration cache index
+	@param data : data buffer
+	@param size : data size
+	@return cached : 1, not cached : 0
+	@~Japanese
+	@brief 設定キャッシュを読み出す関数
+	@param ctx : インスタンスハンドル
+	@param config : 設定キャッシュの番号
+	@param data : データバッファ
+	@param size : データサイズ
+	@return キャッシュあり : 1, キャッシュなし : 0
+**/
+static int _conexio_cmm920_config_get( CONEXIO920HANDLE ctx, int config, BYTE *data, int size )
+{
+	int valid;
+
+	pthread_mutex_lock( &ctx->config_mutex );
+	valid = ctx->config_valid[config];
+	if( valid ) memcpy( data, ctx->config[config], size );
+	pthread_mutex_unlock( &ctx->config_mutex );
+
+	return valid;
+}
+
+/**
+	@~English
+	@brief Write the configuration cache
+	@param ctx : instance handle
+	@param config : configuration cache index ( -1 : invalidate all )
+	@param data : data buffer ( NULL : invalidate )
+	@param size : data size
+	@~Japanese
+	@brief 設定キャッシュを更新する関数
+	@param ctx : インスタンスハンドル
+	@param config : 設定キャッシュの番号 ( -1 : 全て無効にする )
+	@param data : データバッファ ( NULL : 無効にする )
+	@param size : データサイズ
+**/
+static void _conexio_cmm920_config_set( CONEXIO920HANDLE ctx, int config, BYTE *data, int size )
+{
+	pthread_mutex_lock( &ctx->config_mutex );
+	if( config < 0 ){
+		memset( ctx->config_valid, 0, sizeof(ctx->config_valid) );
+	}else if( data == NULL ){
+		ctx->config_valid[config] = 0;
+	}else{
+		memcpy( ctx->config[config], data, size );
+		ctx->config_valid[config] = 1;
+	}
+	pthread_mutex_unlock( &ctx->config_mutex );
+}
+
+/**
+	@~English
+	@brief time difference function
+	@param start : start time
+	@param end : end time
+	@return time (usec)
+	@~Japanese
+	@brief 時刻の差を求める関数
+	@param start : 開始時刻
+	@param end : 終了時刻
+	@return 時間 (usec)
+**/
+static long _conexio_cmm920_diff_usec( struct timespec *start, struct timespec *end )
+{
+	return ( end->tv_sec - start->tv_sec ) * 1000000L +
+		( end->tv_nsec - start->tv_nsec ) / 1000L;
+}
+
+/**
+	@~English
+	@brief add time function
+	@param ts : time
+	@param msec : add time (msec)
+	@~Japanese
+	@brief 時刻に加算する関数
+	@param ts : 時刻
+	@param msec : 加算する時間 (msec)
+**/
+static void _conexio_cmm920_add_msec( struct timespec *ts, long msec )
+{
+	ts->tv_sec += msec / 1000;
+	ts->tv_nsec += ( msec % 1000 ) * 1000000L;
+	if( ts->tv_nsec >= 1000000000L ){
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000L;
+	}
+}
+
+/**
+	@~English
+	@brief Get the response deadline of command
+	@param ctx : instance handle
+	@param index : command index
+	@return deadline (usec)
+	@~Japanese
+	@brief コマンドの応答待ち期限を取得する関数
+	@param ctx : インスタンスハンドル
+	@param index : コマンド番号
+	@return 期限 (usec)
+	@par 設定されたタイムアウト時間を優先し、未設定なら学習した期限 ( 平均 + 4 × 偏差、最低でも平均の 2 倍 ) を使用します。
+	@par 学習前は初期値 ( CONEXIO_CMM920_DEFAULT_TIMEOUT_MSEC ) を使用し、学習した期限もこれを超えません。
+**/
+static long _conexio_cmm920_wait_deadline( CONEXIO920HANDLE ctx, int index )
+{
+	long usec, margin;
+	PCONEXIO920WAITPROFILE wait;
+
+	if( index < 0 ) return CONEXIO_CMM920_DEFAULT_TIMEOUT_MSEC * 1000L;
+
+	if( ctx->timeout_msec[index] > 0 ) return ctx->timeout_msec[index] * 1000L;
+
+	wait = &ctx->wait[index];
+	if( wait->samples < CONEXIO_CMM920_WAIT_LEARN_NUM ) return CONEXIO_CMM920_DEFAULT_TIMEOUT_MSEC * 1000L;
+
+	margin = wait->deviation * 4;
+	if( margin < wait->expected ) margin = wait->expected;
+	usec = wait->expected + margin;
+
+	if( usec < CONEXIO_CMM920_WAIT_MIN_MSEC * 1000L ) usec = CONEXIO_CMM920_WAIT_MIN_MSEC * 1000L;
+	if( usec > CONEXIO_CMM920_DEFAULT_TIMEOUT_MSEC * 1000L ) usec = CONEXIO_CMM920_DEFAULT_TIMEOUT_MSEC * 1000L;
+
+	return usec;
+}
+
+/**
+	@~English
+	@brief Learn the response wait of command
+	@param ctx : instance handle
+	@param index : command index
+	@param rtt : round trip time (usec) ( less than 0 : timeout )
+	@~Japanese
+	@brief コマンドの応答待ち時間を学習する関数
+	@param ctx : インスタンスハンドル
+	@param index : コマンド番号
+	@param rtt : 往復時間 (usec) ( 0未満 : タイムアウト )
+	@par 平均は 1/8 、偏差は 1/4 の重みの指数移動平均で更新します。
+	@par タイムアウトした場合は学習をやり直し、次回から初期値で待ちます。
+**/
+static void _conexio_cmm920_wait_learn( CONEXIO920HANDLE ctx, int index, long rtt )
+{
+	PCONEXIO920WAITPROFILE wait = &ctx->wait[index];
+	long diff;
+
+	if( rtt < 0 ){
+		wait->timeout++;
+		wait->samples = 0;
+		return;
+	}
+
+	if( wait->samples == 0 ){
+		wait->expected = rtt;
+		wait->deviation = rtt / 2;
+	}else{
+		diff = rtt - wait->expected;
+		if( diff < 0 ) diff = -diff;
+		wait->deviation += ( diff - wait->deviation ) / 4;
+		wait->expected += ( rtt - wait->expected ) / 8;
+	}
+	wait->samples++;
+}
+
+/**
+	@~English
+	@brief Serial read until deadline function
+	@param ctx : instance handle
+	@param buf : receive buffer
+	@param len : receive length
+	@param deadline : absolute deadline ( CLOCK_MONOTONIC )
+	@return received length ( less than len : timeout ), Failed : -1
+	@~Japanese
+	@brief 期限まで poll() で待ちながら受信する関数
+	@param ctx : インスタンスハンドル
+	@param buf : 受信バッファ
+	@param len : 受信サイズ
+	@param deadline : 期限 ( CLOCK_MONOTONIC )
+	@return 受信サイズ ( len 未満 : タイムアウト ), 失敗 : -1
+	@par 届いたデータはその時点で読み込みます。
+**/
+static int _conexio_cmm920_read_deadline( CONEXIO920HANDLE ctx, BYTE *buf, int len, struct timespec *deadline )
+{
+	struct pollfd pfd;
+	struct timespec now;
+	long remain;
+	int readlen = 0;
+	int nRead;
+
+	while( readlen < len ){
+		clock_gettime( CLOCK_MONOTONIC, &now );
+		remain = _conexio_cmm920_diff_usec( &now, deadline );
+		if( remain < 0 ) remain = 0;
+
+		pfd.fd = ctx->iPort;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		nRead = poll( &pfd, 1, (int)( ( remain + 999 ) / 1000 ) );
+		if( nRead < 0 ){
+			if( errno == EINTR ) continue;
+			return -1;
+		}
+		if( nRead == 0 ) break;	// timeout
+
+		nRead = Serial_GetString( ctx->iPort, &buf[readlen], len - readlen );
+		if( nRead < 0 ){
+			if( errno == EINTR || errno == EAGAIN ) continue;
+			return -1;
+		}
+		if( nRead == 0 && remain == 0 ) break;
+		readlen += nRead;
+	}
+
+	return readlen;
+}
 
 /**
 	@~English
@@ -233,9 +783,136 @@ void _conexio_cmm920_output_syslog_notice( char *msg )
 }
 
 
+/**
+	@~English
+	@brief hex string function
+	@param str : output string ( length * 3 + 1 bytes )
+	@param data : data
+	@param length : data length
+	@~Japanese
+	@brief データを16進文字列に変換する関数
+	@param str : 出力文字列 ( length * 3 + 1 バイト )
+	@param data : データ
+	@param length : データサイズ
+**/
+static void _conexio_cmm920_trace_hex( char *str, const BYTE *data, int length )
+{
+	int i;
+
+	for( i = 0; i < length; i++ ){
+		*str++ = conexio_cmm920_hex_table[data[i] >> 4];
+		*str++ = conexio_cmm920_hex_table[data[i] & 0x0F];
+		*str++ = ' ';
+	}
+	*str = '\0';
+}
+
+/**
+	@~English
+	@brief output trace entry to syslog function
+	@param trace : trace entry
+	@param data : frame data ( NULL : trace entry data )
+	@~Japanese
+	@brief トレースを syslog に出力する関数
+	@param trace : トレース
+	@param data : フレームデータ ( NULL : トレースのデータ )
+**/
+static void _conexio_cmm920_trace_syslog( PCONEXIO920TRACE trace, const BYTE *data )
+{
+	char line[CONEXIO_CMM920_TRACE_LINE_BYTES * 3 + 1];
+	int length = trace->length;
+	int i, n;
+
+	if( data == NULL ){
+		data = trace->data;
+		if( length > CONEXIO_CMM920_TRACE_DATA_MAX ) length = CONEXIO_CMM920_TRACE_DATA_MAX;
+	}
+
+	openlog(LIB_CONNEXIO_SYSLOG_NAME, LOG_PERROR|LOG_PID,LOG_LOCAL0);
+	syslog(LOG_NOTICE, "%s #%lu %ld.%06ld SIZE:%d\n",
+		( trace->dir == CONEXIO_CMM920_TRACE_DIR_SEND ? "[Sending Data]" : "[Receive Data]" ),
+		trace->seq, trace->sec, trace->usec, trace->length );
+	for( i = 0; i < length; i += n ){
+		n = length - i;
+		if( n > CONEXIO_CMM920_TRACE_LINE_BYTES ) n = CONEXIO_CMM920_TRACE_LINE_BYTES;
+		_conexio_cmm920_trace_hex( line, &data[i], n );
+		syslog(LOG_NOTICE, "%s\n", line);
+	}
+	closelog();
+}
+
+/**
+	@~English
+	@brief wire trace function
+	@param dir : CONEXIO_CMM920_TRACE_DIR_SEND or CONEXIO_CMM920_TRACE_DIR_RECV
+	@param frame : frame
+	@param length : frame length
+	@~Japanese
+	@brief 送受信フレームをトレースする関数
+	@param dir : CONEXIO_CMM920_TRACE_DIR_SEND or CONEXIO_CMM920_TRACE_DIR_RECV
+	@param frame : フレーム
+	@param length : フレームサイズ
+	@par リングバッファへの書き込みはロックを使用しません。
+**/
+static void _conexio_cmm920_trace( BYTE dir, const BYTE *frame, int length )
+{
+	PCONEXIO920TRACE trace;
+	struct timespec now;
+	unsigned long seq;
+	int copy;
+
+	if( global_trace_level == CONEXIO_CMM920_TRACE_OFF ) return;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+
+	seq = __sync_add_and_fetch( &global_trace_seq, 1 );
+	trace = &global_trace_ring[( seq - 1 ) & ( CONEXIO_CMM920_TRACE_RING_NUM - 1 )];
+
+	// 書き込み中は seq を 0 にして読み出し側に知らせる
+	trace->seq = 0;
+	__sync_synchronize();
+
+	copy = length;
+	if( copy > CONEXIO_CMM920_TRACE_DATA_MAX ) copy = CONEXIO_CMM920_TRACE_DATA_MAX;
+	trace->sec = now.tv_sec;
+	trace->usec = now.tv_nsec / 1000;
+	trace->dir = dir;
+	trace->length = length;
+	memcpy( trace->data, frame, copy );
+
+	__sync_synchronize();
+	trace->seq = seq;
+
+	if( global_trace_level < CONEXIO_CMM920_TRACE_TEXT ) return;
+
+	// text 出力は 1秒あたりのフレーム数で制限する
+	if( now.tv_sec != global_trace_window ){
+		if( global_trace_suppressed ){
+			char msg[64];
+			sprintf( msg, "[Trace] %lu frames suppressed", global_trace_suppressed );
+			_conexio_cmm920_output_syslog_notice( msg );
+			global_trace_suppressed = 0;
+		}
+		global_trace_window = now.tv_sec;
+		global_trace_window_count = 0;
+	}
+	if( global_trace_rate > 0 && global_trace_window_count >= global_trace_rate ){
+		global_trace_suppressed++;
+		return;
+	}
+	global_trace_window_count++;
+
+	{
+		CONEXIO920TRACE text = *trace;
+		text.seq = seq;
+		_conexio_cmm920_trace_syslog( &text, frame );
+	}
+}
+
 /**
 	@~English
 	@brief 920 Module send and Ack receive
+	@param ctx : instance handle
 	@param Data : Send Data
 	@param size : Send Size
 	@param mode : CMM920  mode
@@ -243,15 +920,18 @@ void _conexio_cmm920_output_syslog_notice( char *msg )
 	@return Success : 0 , Failed : From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief 920MHzモジュールに送信とAck受信を行う関数
+	@param ctx : インスタンスハンドル
 	@param Data : 送信データ
 	@param size : 送信サイズ
 	@param mode : CMM920 モード
 	@param command : CMM920 コマンド
 	@return 成功:  0 失敗 :  送信 エラー: -16～-31,　受信エラー : -32～
 **/
-int _conexio_cmm920_send_recv( BYTE Data[], int size ,int mode, int command ){
+static int _conexio_cmm920_send_recv( CONEXIO920HANDLE ctx, BYTE Data[], int size ,int mode, int command ){
 	int iRet, send_size = size;
 	int offset = 0; // 2016.01.15 (1) add
+	int config = -1, config_size = size - 1;
+	BYTE config_data[CONEXIO_CMM920_CONFIG_DATA_MAX];
 
 	// 2016.01.15 (1) start
 	if( mode == CONEXIO_CMM920_MODE_COMMON && 
@@ -262,18 +942,42 @@ int _conexio_cmm920_send_recv( BYTE Data[], int size ,int mode, int command ){
 	// 2016.01.15 (1) end
 
 	if( Data[offset] == CONEXIO_CMM920_SET_READING_READ ){
-		send_size = 1;
+		send_size = offset + 1;
 	}
 
-	iRet = SendCommand(	Data, send_size,	mode, command );
+	if( offset == 0 && config_size > 0 && config_size <= CONEXIO_CMM920_CONFIG_DATA_MAX ){
+		config = _conexio_cmm920_config_index( mode, command );
+	}
 
-	if( iRet < 0 )	return (-16 * 1) + iRet;
+	if( config >= 0 ){
+		if( Data[0] == CONEXIO_CMM920_SET_READING_READ ){
+			// read from the configuration cache
+			if( _conexio_cmm920_config_get( ctx, config, &Data[1], config_size ) ){
+				return 0;
+			}
+		}else{
+			// write through, Data is overwritten by the acknowledge
+			memcpy( config_data, &Data[1], config_size );
+			_conexio_cmm920_config_set( ctx, config, NULL, 0 );
+		}
+	}
 
-	usleep(iWait);
+	iRet = SendCommand_h( ctx,	Data, send_size,	mode, command );
 
+	if( iRet < 0 )	return (-16 * 1) + iRet;
+
+	// no fixed wait, RecvCommandAck waits until the learned deadline
 	//iRet = RecvCommandAck(Data, &send_size,	mode, command );
-	iRet = RecvCommandAck(Data, &size,	mode, command ); // 2016.01.15 (4)
+	iRet = RecvCommandAck_h(ctx, Data, &size,	mode, command ); // 2016.01.15 (4)
 	if( iRet < 0 )	return (-16 * 2) + iRet;
+
+	if( config >= 0 && iRet == 0 ){
+		if( send_size != 1 ){
+			_conexio_cmm920_config_set( ctx, config, config_data, config_size );
+		}else if( size > config_size ){
+			_conexio_cmm920_config_set( ctx, config, &Data[1], config_size );
+		}
+	}
 	
 	return iRet;
 }
@@ -281,14 +985,16 @@ int _conexio_cmm920_send_recv( BYTE Data[], int size ,int mode, int command ){
 /**
 	@~English
 	@brief CONEXIO 920MHz Initialize
+	@param ctx : instance handle
 	@param PortName : Serial port name
 	@return Success : 0 , Failed : otherwise 0
 	@~Japanese
 	@brief CONEXIO 920MHzモジュールの初期化
+	@param ctx : インスタンスハンドル
 	@param PortName : シリアル通信ポート名
 	@return 成功:  0 失敗 :  0以外
 **/
-int conexio_cmm920_init(char* PortName){
+int conexio_cmm920_init_h(CONEXIO920HANDLE ctx, char* PortName){
 
 	int iBaudrate = 115200;
 	int iLength = 8;
@@ -296,7 +1002,7 @@ int conexio_cmm920_init(char* PortName){
 	int iParity = 0;
 	int iRtsControl = 1; // RTS/CTS ON
 
-	iPort = Serial_PortOpen_Full(
+	ctx->iPort = Serial_PortOpen_Full(
 		PortName,
 		iBaudrate,
 		iLength,
@@ -307,28 +1013,128 @@ int conexio_cmm920_init(char* PortName){
 		iRtsControl
 	);
 
-	if(iPort < 0){
+	if(ctx->iPort < 0){
 		return 1;
 	}
 
-	iWait = 50000;
+	// the configuration cache is filled on the first read of each item
+	_conexio_cmm920_config_set( ctx, -1, NULL, 0 );
 
 	return 0;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_init_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_init_h を実行する関数
+**/
+int conexio_cmm920_init(char* PortName)
+{
+	return conexio_cmm920_init_h( &global_default_context, PortName );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Exit
+	@param ctx : instance handle
 	@return Success : 0 , Failed : otherwise 0
 	@~Japanese
 	@brief CONEXIO 920MHzモジュールの終了
+	@param ctx : インスタンスハンドル
 	@return 成功:  0 失敗 :  0以外
 **/
+int conexio_cmm920_exit_h(CONEXIO920HANDLE ctx)
+{
+	if(ctx->iPort == 0) return 0;
+
+	conexio_cmm920_txq_stop_h(ctx);
+	conexio_cmm920_stop_recv_thread_h(ctx);
+
+	Serial_PortClose(ctx->iPort);
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_exit_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_exit_h を実行する関数
+**/
 int conexio_cmm920_exit(void)
 {
-	if(iPort == 0) return 0;
+	return conexio_cmm920_exit_h( &global_default_context );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Open a new instance
+	@param PortName : Serial port name
+	@return Success : instance handle , Failed : NULL
+	@~Japanese
+	@brief CONEXIO 920MHzモジュールのインスタンスを生成して初期化する関数
+	@param PortName : シリアル通信ポート名
+	@return 成功:  インスタンスハンドル 失敗 :  NULL
+	@par 複数のモジュールを同時に使用する場合は、モジュール毎にインスタンスを生成し、 _h 関数にハンドルを渡してください。
+**/
+CONEXIO920HANDLE conexio_cmm920_open( char* PortName )
+{
+	CONEXIO920HANDLE ctx;
+
+	ctx = (CONEXIO920HANDLE)calloc( 1, sizeof(struct __conexioCMM920_context) );
+	if( ctx == (CONEXIO920HANDLE)NULL ) return (CONEXIO920HANDLE)NULL;
+
+	pthread_mutex_init( &ctx->recv_mutex, NULL );
+	pthread_mutex_init( &ctx->send_mutex, NULL );
+	pthread_mutex_init( &ctx->config_mutex, NULL );
+	pthread_mutex_init( &ctx->txq_mutex, NULL );
+	pthread_mutex_init( &ctx->link_mutex, NULL );
+	pthread_mutex_init( &ctx->airtime_mutex, NULL );
+	ctx->txq_window = 1;
+	ctx->txq_timeout_msec = CONEXIO_CMM920_DEFAULT_TIMEOUT_MSEC;
+	ctx->link_adaptive = CONEXIO_CMM920_LINK_ADAPTIVE_ON;
+	ctx->airtime_bitrate = CONEXIO_CMM920_AIRTIME_DEFAULT_BITRATE;
+	ctx->airtime_window_msec = CONEXIO_CMM920_AIRTIME_DEFAULT_WINDOW_MSEC;
+	ctx->airtime_slot_usec = CONEXIO_CMM920_AIRTIME_DEFAULT_WINDOW_MSEC * 1000LL / CONEXIO_CMM920_AIRTIME_SLOT_NUM;
+
+	if( conexio_cmm920_init_h( ctx, PortName ) != 0 ){
+		pthread_mutex_destroy( &ctx->recv_mutex );
+		pthread_mutex_destroy( &ctx->send_mutex );
+		pthread_mutex_destroy( &ctx->config_mutex );
+		pthread_mutex_destroy( &ctx->txq_mutex );
+		pthread_mutex_destroy( &ctx->link_mutex );
+		pthread_mutex_destroy( &ctx->airtime_mutex );
+		free( ctx );
+		return (CONEXIO920HANDLE)NULL;
+	}
+
+	return ctx;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Close an instance
+	@param ctx : instance handle
+	@return Success : 0 , Failed : otherwise 0
+	@~Japanese
+	@brief conexio_cmm920_open で生成したインスタンスを終了して解放する関数
+	@param ctx : インスタンスハンドル
+	@return 成功:  0 失敗 :  0以外
+**/
+int conexio_cmm920_close( CONEXIO920HANDLE ctx )
+{
+	if( ctx == (CONEXIO920HANDLE)NULL || ctx == &global_default_context ) return 1;
+
+	conexio_cmm920_exit_h( ctx );
 
-	Serial_PortClose(iPort);
+	pthread_mutex_destroy( &ctx->recv_mutex );
+	pthread_mutex_destroy( &ctx->send_mutex );
+	pthread_mutex_destroy( &ctx->config_mutex );
+	pthread_mutex_destroy( &ctx->txq_mutex );
+	pthread_mutex_destroy( &ctx->link_mutex );
+	pthread_mutex_destroy( &ctx->airtime_mutex );
+	free( ctx );
 
 	return 0;
 }
@@ -336,25 +1142,40 @@ int conexio_cmm920_exit(void)
 /**
 	@~English
 	@brief CONEXIO 920MHz GetLastError
+	@param ctx : instance handle
 	@return Last Error Number
 	@~Japanese
 	@brief CONEXIO 920MHzの GetLastError
+	@param ctx : インスタンスハンドル
 	@return 最後のエラー番号
 **/
-int conexio_cmm920_get_last_error(void){
+int conexio_cmm920_get_last_error_h(CONEXIO920HANDLE ctx){
 
-	return global_getLastError;
+	return ctx->getLastError;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_get_last_error_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_last_error_h を実行する関数
+**/
+int conexio_cmm920_get_last_error(void)
+{
+	return conexio_cmm920_get_last_error_h( &global_default_context );
 }
 
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Reset
+	@param ctx : instance handle
 	@return Success : 0 , Failed : From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の リセット
+	@param ctx : インスタンスハンドル
 	@return 成功:  0 失敗 :  送信 エラー: -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_reset(void)
+int conexio_cmm920_reset_h(CONEXIO920HANDLE ctx)
 {
 	int iRet;
 	DbgPrint("conexio_cmm920_reset A\n");
@@ -362,7 +1183,7 @@ int conexio_cmm920_reset(void)
 	BYTE Data[] = {0x01};
 	int Size = 1;
 
-	iRet = _conexio_cmm920_send_recv(
+	iRet = _conexio_cmm920_send_recv( ctx,
 		Data,
 		Size,
 		CONEXIO_CMM920_MODE_COMMON,
@@ -373,24 +1194,99 @@ int conexio_cmm920_reset(void)
 		DbgPrint("<conexio_cmm920_reset>:Sending Error\n");
 	}
 
+	// the module returns to the saved configuration
+	_conexio_cmm920_config_set( ctx, -1, NULL, 0 );
+
+	return iRet;
+
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_reset_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_reset_h を実行する関数
+**/
+int conexio_cmm920_reset(void)
+{
+	return conexio_cmm920_reset_h( &global_default_context );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Refresh the configuration cache
+	@param ctx : instance handle
+	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
+	@~Japanese
+	@brief 設定キャッシュをモジュールから読み直す関数
+	@param ctx : インスタンスハンドル
+	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
+	@par モード、アドレス、無線、タイマー、自動応答フレーム、アンテナの設定を読み出します。
+	@par 設定の読み出し関数はキャッシュから値を返し、書き込み関数は成功時にキャッシュを更新します。
+	@par キャッシュは各設定の最初の読み出し時に作成されるため、初期化時には読み出しません。
+	@par 他のプログラムからモジュールの設定を変更した場合、または起動時にまとめて読み出す場合に実行してください。
+**/
+int conexio_cmm920_refresh_config_h( CONEXIO920HANDLE ctx )
+{
+	int iRet;
+	int code = 0;
+	unsigned short panId = 0, shortAddr = 0, tim = 0, phr = 0;
+	unsigned short sendTim = 0, ackWaitTim = 0;
+	BYTE Addr[8];
+	BYTE bitrate = 0, channel = 0, power = 0, sendNum = 0, ackRetryNum = 0;
+	BYTE fc_upper = 0, antennaMode = 0;
+	char sendLv = 0, recvLv = 0;
+
+	_conexio_cmm920_config_set( ctx, -1, NULL, 0 );
+
+	iRet = conexio_cmm920_mode_h( ctx, CONEXIO_CMM920_SET_READING_READ, &code );
+	if( iRet ) return iRet;
+
+	iRet = conexio_cmm920_address_h( ctx, CONEXIO_CMM920_SET_READING_READ, &panId, Addr, &shortAddr );
+	if( iRet ) return iRet;
+
+	iRet = conexio_cmm920_wireless_h( ctx, CONEXIO_CMM920_SET_READING_READ, &bitrate, &channel, &power,
+		&sendLv, &recvLv, &sendTim, &sendNum, &ackRetryNum, &ackWaitTim );
+	if( iRet ) return iRet;
+
+	iRet = conexio_cmm920_timer_h( ctx, CONEXIO_CMM920_SET_READING_READ, &tim );
+	if( iRet ) return iRet;
+
+	iRet = conexio_cmm920_auto_ack_frame_h( ctx, CONEXIO_CMM920_SET_READING_READ, &phr, &fc_upper );
+	if( iRet ) return iRet;
+
+	iRet = conexio_cmm920_antenna_h( ctx, CONEXIO_CMM920_SET_READING_READ, &antennaMode );
+
 	return iRet;
+}
 
+/**
+	@~English
+	@brief conexio_cmm920_refresh_config_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_refresh_config_h を実行する関数
+**/
+int conexio_cmm920_refresh_config(void)
+{
+	return conexio_cmm920_refresh_config_h( &global_default_context );
 }
 
 // mode
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Mode function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param code : mode
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の モード関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param code : mode
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_mode(BYTE isWrite , int *code)
+int conexio_cmm920_mode_h(CONEXIO920HANDLE ctx, BYTE isWrite , int *code)
 {
 	int iRet;
 	BYTE Data[2];
@@ -412,7 +1308,7 @@ int conexio_cmm920_mode(BYTE isWrite , int *code)
 		case CONEXIO_CMM920_SET_MODE_TEST:
 			break;
 		case CONEXIO_CMM920_SET_MODE_STOP:
-			tcflush( iPort, TCIOFLUSH );
+			tcflush( ctx->iPort, TCIOFLUSH );
 			break;
 		default:
 			DbgPrint("<conexio_cmm920_mode>:Parameter Error\n");
@@ -421,7 +1317,7 @@ int conexio_cmm920_mode(BYTE isWrite , int *code)
 		Data[1] = *code;
 	}
 
-	iRet = _conexio_cmm920_send_recv(
+	iRet = _conexio_cmm920_send_recv( ctx,
 		Data,
 		Size,
 		CONEXIO_CMM920_MODE_COMMON,
@@ -446,10 +1342,22 @@ int conexio_cmm920_mode(BYTE isWrite , int *code)
 
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_mode_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_mode_h を実行する関数
+**/
+int conexio_cmm920_mode(BYTE isWrite , int *code)
+{
+	return conexio_cmm920_mode_h( &global_default_context, isWrite, code );
+}
+
 // Address
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Address function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param panId : PAN ID
 	@param Addr : Long Address
@@ -457,13 +1365,14 @@ int conexio_cmm920_mode(BYTE isWrite , int *code)
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の アドレス関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param panId : PAN ID
 	@param Addr : ロングアドレス
 	@param shortAddr : ショートアドレス
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_address(BYTE isWrite, unsigned short *panId, BYTE Addr[], unsigned short *shortAddr )
+int conexio_cmm920_address_h(CONEXIO920HANDLE ctx, BYTE isWrite, unsigned short *panId, BYTE Addr[], unsigned short *shortAddr )
 {
 	int iRet;
 	BYTE Data[13];
@@ -492,7 +1401,7 @@ int conexio_cmm920_address(BYTE isWrite, unsigned short *panId, BYTE Addr[], uns
 		// 2016.01.15 (3) end
 	}
 
-	iRet = _conexio_cmm920_send_recv(
+	iRet = _conexio_cmm920_send_recv( ctx,
 		Data,
 		Size,
 		CONEXIO_CMM920_MODE_COMMON,
@@ -521,10 +1430,22 @@ int conexio_cmm920_address(BYTE isWrite, unsigned short *panId, BYTE Addr[], uns
 
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_address_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_address_h を実行する関数
+**/
+int conexio_cmm920_address(BYTE isWrite, unsigned short *panId, BYTE Addr[], unsigned short *shortAddr )
+{
+	return conexio_cmm920_address_h( &global_default_context, isWrite, panId, Addr, shortAddr );
+}
+
 // Wireless ( bitrate ***kbps, channel **ch, Power **mW )
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Wireless function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param bitrate : bit rate
 	@param channel : channel
@@ -538,6 +1459,7 @@ int conexio_cmm920_address(BYTE isWrite, unsigned short *panId, BYTE Addr[], uns
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の 無線関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param bitrate : ビットレート
 	@param channel : チャネル
@@ -550,7 +1472,7 @@ int conexio_cmm920_address(BYTE isWrite, unsigned short *panId, BYTE Addr[], uns
 	@param ackWaitTim : ACK待ち時間
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_wireless(BYTE isWrite, BYTE *bitrate, BYTE *channel, BYTE *power, char *sendSenceLvl,
+int conexio_cmm920_wireless_h(CONEXIO920HANDLE ctx, BYTE isWrite, BYTE *bitrate, BYTE *channel, BYTE *power, char *sendSenceLvl,
 	 char *recvSenceLvl, unsigned short *sendSenceTim, BYTE *sendSenceNum, BYTE *ackRetryNum, unsigned short *ackWaitTim)
 {
 	int iRet;
@@ -590,7 +1512,7 @@ int conexio_cmm920_wireless(BYTE isWrite, BYTE *bitrate, BYTE *channel, BYTE *po
 		Data[11] = (*ackWaitTim & 0xFF );
 	}
 
-	iRet = _conexio_cmm920_send_recv(
+	iRet = _conexio_cmm920_send_recv( ctx,
 		Data,
 		Size,
 		CONEXIO_CMM920_MODE_COMMON,
@@ -625,25 +1547,44 @@ int conexio_cmm920_wireless(BYTE isWrite, BYTE *bitrate, BYTE *channel, BYTE *po
 			*ackRetryNum = Data[9];
 			*ackWaitTim = ( Data[10] << 8 ) | Data[11];
 		}
+
+		// 送信時間の計算に使うビットレート
+		pthread_mutex_lock( &ctx->airtime_mutex );
+		ctx->airtime_bitrate = ( *bitrate == CONEXIO_CMM920_SET_WIRELESS_BITRATE_50KBPS ) ? 50000 : 100000;
+		pthread_mutex_unlock( &ctx->airtime_mutex );
 	}
 
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_wireless_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_wireless_h を実行する関数
+**/
+int conexio_cmm920_wireless(BYTE isWrite, BYTE *bitrate, BYTE *channel, BYTE *power, char *sendSenceLvl,
+	 char *recvSenceLvl, unsigned short *sendSenceTim, BYTE *sendSenceNum, BYTE *ackRetryNum, unsigned short *ackWaitTim)
+{
+	return conexio_cmm920_wireless_h( &global_default_context, isWrite, bitrate, channel, power, sendSenceLvl, recvSenceLvl, sendSenceTim, sendSenceNum, ackRetryNum, ackWaitTim );
+}
+
 // timer 
 /**
 	@~English
 	@brief CONEXIO 920MHz Module timer function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param tim : time ( msec )
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の 時間関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param tim : 時間 (msec)
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_timer( BYTE isWrite, unsigned short *tim )
+int conexio_cmm920_timer_h( CONEXIO920HANDLE ctx, BYTE isWrite, unsigned short *tim )
 {
 
 	int iRet;
@@ -667,7 +1608,7 @@ int conexio_cmm920_timer( BYTE isWrite, unsigned short *tim )
 		Data[2] = (*tim & 0xFF );
 	}
 
-	iRet = _conexio_cmm920_send_recv(
+	iRet = _conexio_cmm920_send_recv( ctx,
 		Data,
 		Size,
 		CONEXIO_CMM920_MODE_COMMON,
@@ -691,22 +1632,35 @@ int conexio_cmm920_timer( BYTE isWrite, unsigned short *tim )
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_timer_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_timer_h を実行する関数
+**/
+int conexio_cmm920_timer( BYTE isWrite, unsigned short *tim )
+{
+	return conexio_cmm920_timer_h( &global_default_context, isWrite, tim );
+}
+
 // Auto Ack Frame
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Auto Acknowledge Frame function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param phr :
 	@param fc_upper :
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の オートACKフレーム 関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param phr :
 	@param fc_upper :
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_auto_ack_frame( BYTE isWrite, unsigned short *phr, unsigned char *fc_upper )
+int conexio_cmm920_auto_ack_frame_h( CONEXIO920HANDLE ctx, BYTE isWrite, unsigned short *phr, unsigned char *fc_upper )
 {
 
 	int iRet;
@@ -730,7 +1684,7 @@ int conexio_cmm920_auto_ack_frame( BYTE isWrite, unsigned short *phr, unsigned c
 		Data[3] = *fc_upper;
 	}
 
-	iRet = _conexio_cmm920_send_recv(
+	iRet = _conexio_cmm920_send_recv( ctx,
 		Data,
 		Size,
 		CONEXIO_CMM920_MODE_COMMON,
@@ -756,20 +1710,33 @@ int conexio_cmm920_auto_ack_frame( BYTE isWrite, unsigned short *phr, unsigned c
 
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_auto_ack_frame_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_auto_ack_frame_h を実行する関数
+**/
+int conexio_cmm920_auto_ack_frame( BYTE isWrite, unsigned short *phr, unsigned char *fc_upper )
+{
+	return conexio_cmm920_auto_ack_frame_h( &global_default_context, isWrite, phr, fc_upper );
+}
+
 // Antenna mode (Internal or External )
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Antenna mode function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param antennaMode :
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の アンテナモード 関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param antennaMode :
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_antenna( BYTE isWrite, BYTE *antennaMode )
+int conexio_cmm920_antenna_h( CONEXIO920HANDLE ctx, BYTE isWrite, BYTE *antennaMode )
 {
 	int iRet;
 	BYTE Data[2];
@@ -801,7 +1768,7 @@ int conexio_cmm920_antenna( BYTE isWrite, BYTE *antennaMode )
 		Data[1] = *antennaMode;
 	}
 
-	iRet = _conexio_cmm920_send_recv(
+	iRet = _conexio_cmm920_send_recv( ctx,
 		Data,
 		Size,
 		CONEXIO_CMM920_MODE_COMMON,
@@ -825,20 +1792,33 @@ int conexio_cmm920_antenna( BYTE isWrite, BYTE *antennaMode )
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_antenna_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_antenna_h を実行する関数
+**/
+int conexio_cmm920_antenna( BYTE isWrite, BYTE *antennaMode )
+{
+	return conexio_cmm920_antenna_h( &global_default_context, isWrite, antennaMode );
+}
+
 // Version Read
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Version Read function
+	@param ctx : instance handle
 	@param ver : module version
 	@param rev : module revision
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の バージョン読み込み 関数
+	@param ctx : インスタンスハンドル
 	@param ver : モジュールのバージョン
 	@param rev : モジュールのリビジョン
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_version(int *ver, int *rev)
+int conexio_cmm920_version_h(CONEXIO920HANDLE ctx, int *ver, int *rev)
 {
 	int iRet;
 	BYTE Data[3];
@@ -850,7 +1830,7 @@ int conexio_cmm920_version(int *ver, int *rev)
 
 	Data[0] = CONEXIO_CMM920_SET_READING_READ;
 
-	iRet = _conexio_cmm920_send_recv(
+	iRet = _conexio_cmm920_send_recv( ctx,
 		Data,
 		Size,
 		CONEXIO_CMM920_MODE_COMMON,
@@ -875,22 +1855,35 @@ int conexio_cmm920_version(int *ver, int *rev)
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_version_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_version_h を実行する関数
+**/
+int conexio_cmm920_version(int *ver, int *rev)
+{
+	return conexio_cmm920_version_h( &global_default_context, ver, rev );
+}
+
 // LSI set function ( basic )
 /**
 	@~English
 	@brief CONEXIO 920MHz Module LSI function
+	@param ctx : instance handle
 	@param lsi_addr : Address of LSI
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param value : value
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の LSI 関数
+	@param ctx : インスタンスハンドル
 	@param lsi_addr : LSIのアドレス
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param value : 値
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_lsi(unsigned long lsi_addr, int isWrite, unsigned short *value)
+int conexio_cmm920_lsi_h(CONEXIO920HANDLE ctx, unsigned long lsi_addr, int isWrite, unsigned short *value)
 {
 	int iRet;
 	BYTE Data[6];
@@ -914,7 +1907,7 @@ int conexio_cmm920_lsi(unsigned long lsi_addr, int isWrite, unsigned short *valu
 		Data[5] = (*value & 0xFF );
 	}
 
-	iRet = _conexio_cmm920_send_recv(
+	iRet = _conexio_cmm920_send_recv( ctx,
 		Data,
 		Size,
 		CONEXIO_CMM920_MODE_COMMON,
@@ -939,22 +1932,35 @@ int conexio_cmm920_lsi(unsigned long lsi_addr, int isWrite, unsigned short *valu
 
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_lsi_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_lsi_h を実行する関数
+**/
+int conexio_cmm920_lsi(unsigned long lsi_addr, int isWrite, unsigned short *value)
+{
+	return conexio_cmm920_lsi_h( &global_default_context, lsi_addr, isWrite, value );
+}
+
 // Lsi function ( extensions )
 
 // Data Preemble Bit Length
 /**
 	@~English
 	@brief CONEXIO 920MHz Module preamble bit length function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param length : data length
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のプリアンブルビットのデータ長 関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param length : データ長
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_lsi_data_preamble_bit_len(int isWrite, BYTE length)
+int conexio_cmm920_lsi_data_preamble_bit_len_h(CONEXIO920HANDLE ctx, int isWrite, BYTE length)
 {
 	unsigned long lsi_addr;
 	unsigned short value;
@@ -967,7 +1973,7 @@ int conexio_cmm920_lsi_data_preamble_bit_len(int isWrite, BYTE length)
 	lsi_addr = CONEXIO_CMM920_LSIADDRESS_PRELEN;
 	value = (unsigned short) length;
 
-	iRet = conexio_cmm920_lsi( lsi_addr, isWrite, &value );
+	iRet = conexio_cmm920_lsi_h( ctx, lsi_addr, isWrite, &value );
 
 	if( !iRet ){
 		if( isWrite == CONEXIO_CMM920_SET_READING_READ ){
@@ -980,20 +1986,33 @@ int conexio_cmm920_lsi_data_preamble_bit_len(int isWrite, BYTE length)
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_lsi_data_preamble_bit_len_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_lsi_data_preamble_bit_len_h を実行する関数
+**/
+int conexio_cmm920_lsi_data_preamble_bit_len(int isWrite, BYTE length)
+{
+	return conexio_cmm920_lsi_data_preamble_bit_len_h( &global_default_context, isWrite, length );
+}
+
 // Data Whitening < Enable / Disable >
 /**
 	@~English
 	@brief CONEXIO 920MHz Module data whitening function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.Enable 0.Disable
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のデータホワイトニング 関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.可能  0. 不可能
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_lsi_data_whitening( int isWrite, BYTE isEnable )
+int conexio_cmm920_lsi_data_whitening_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable )
 {
 	unsigned long lsi_addr;
 	unsigned short value;
@@ -1007,7 +2026,7 @@ int conexio_cmm920_lsi_data_whitening( int isWrite, BYTE isEnable )
 	lsi_addr = CONEXIO_CMM920_LSIADDRESS_WHITENING;
 	value = (unsigned short) isEnable;
 
-	iRet = conexio_cmm920_lsi( lsi_addr, isWrite, &value );
+	iRet = conexio_cmm920_lsi_h( ctx, lsi_addr, isWrite, &value );
 
 	if( !iRet ){
 		if( isWrite == CONEXIO_CMM920_SET_READING_READ ){
@@ -1020,20 +2039,33 @@ int conexio_cmm920_lsi_data_whitening( int isWrite, BYTE isEnable )
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_lsi_data_whitening_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_lsi_data_whitening_h を実行する関数
+**/
+int conexio_cmm920_lsi_data_whitening( int isWrite, BYTE isEnable )
+{
+	return conexio_cmm920_lsi_data_whitening_h( &global_default_context, isWrite, isEnable );
+}
+
 // Diversity <Enable / Disable>
 /**
 	@~English
 	@brief CONEXIO 920MHz Module diversity enable function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.Enable 0.Disable
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のダイバーシティ 関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.可能  0. 不可能
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_lsi_diversity_enable( int isWrite, BYTE isEnable )
+int conexio_cmm920_lsi_diversity_enable_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable )
 {
 	unsigned long lsi_addr;
 	unsigned short value;
@@ -1047,7 +2079,7 @@ int conexio_cmm920_lsi_diversity_enable( int isWrite, BYTE isEnable )
 	lsi_addr = CONEXIO_CMM920_LSIADDRESS_DIVER_ENABLE;
 	value = (unsigned short) isEnable;
 
-	iRet = conexio_cmm920_lsi( lsi_addr, isWrite, &value );
+	iRet = conexio_cmm920_lsi_h( ctx, lsi_addr, isWrite, &value );
 
 	if( !iRet ){
 		if( isWrite == CONEXIO_CMM920_SET_READING_READ ){
@@ -1060,21 +2092,34 @@ int conexio_cmm920_lsi_diversity_enable( int isWrite, BYTE isEnable )
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_lsi_diversity_enable_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_lsi_diversity_enable_h を実行する関数
+**/
+int conexio_cmm920_lsi_diversity_enable( int isWrite, BYTE isEnable )
+{
+	return conexio_cmm920_lsi_diversity_enable_h( &global_default_context, isWrite, isEnable );
+}
+
 
 // MHR <Enable / Disable>
 /**
 	@~English
 	@brief CONEXIO 920MHz Module MHR function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.Enable 0.Disable
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のMHR 関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.可能  0. 不可能
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_lsi_mhr_mode( int isWrite, BYTE isEnable )
+int conexio_cmm920_lsi_mhr_mode_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable )
 {
 	unsigned long lsi_addr;
 	unsigned short value;
@@ -1088,7 +2133,7 @@ int conexio_cmm920_lsi_mhr_mode( int isWrite, BYTE isEnable )
 	lsi_addr = CONEXIO_CMM920_LSIADDRESS_MHR_MODE;
 	value = (unsigned short) isEnable;
 
-	iRet = conexio_cmm920_lsi( lsi_addr, isWrite, &value );
+	iRet = conexio_cmm920_lsi_h( ctx, lsi_addr, isWrite, &value );
 
 	if( !iRet ){
 		if( isWrite == CONEXIO_CMM920_SET_READING_READ ){
@@ -1101,20 +2146,33 @@ int conexio_cmm920_lsi_mhr_mode( int isWrite, BYTE isEnable )
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_lsi_mhr_mode_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_lsi_mhr_mode_h を実行する関数
+**/
+int conexio_cmm920_lsi_mhr_mode( int isWrite, BYTE isEnable )
+{
+	return conexio_cmm920_lsi_mhr_mode_h( &global_default_context, isWrite, isEnable );
+}
+
 // CRC CALC INVERSE <Enable / Disable>
 /**
 	@~English
 	@brief CONEXIO 920MHz Module CRC Value calculate INVERSE function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.Enable 0.Disable
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のCRC値計算 反転 関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.可能  0. 不可能
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_lsi_crc_calc_inverse( int isWrite, BYTE isEnable )
+int conexio_cmm920_lsi_crc_calc_inverse_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable )
 {
 	unsigned long lsi_addr;
 	unsigned short value;
@@ -1128,12 +2186,13 @@ int conexio_cmm920_lsi_crc_calc_inverse( int isWrite, BYTE isEnable )
 	lsi_addr = CONEXIO_CMM920_LSIADDRESS_CRC_CALC_INVERSE;
 	value = (unsigned short) isEnable;
 
-	iRet = conexio_cmm920_lsi( lsi_addr, isWrite, &value );
+	iRet = conexio_cmm920_lsi_h( ctx, lsi_addr, isWrite, &value );
 
 	if( !iRet ){
 		if( isWrite == CONEXIO_CMM920_SET_READING_READ ){
 			isEnable = (BYTE)value;
 		}
+		ctx->crc_inverse = isEnable;
 	}else{
 		DbgPrint("<conexio_cmm920_lsi_crc_calc_inverse>:Error : %x\n", iRet );
 	}
@@ -1141,19 +2200,32 @@ int conexio_cmm920_lsi_crc_calc_inverse( int isWrite, BYTE isEnable )
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_lsi_crc_calc_inverse_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_lsi_crc_calc_inverse_h を実行する関数
+**/
+int conexio_cmm920_lsi_crc_calc_inverse( int isWrite, BYTE isEnable )
+{
+	return conexio_cmm920_lsi_crc_calc_inverse_h( &global_default_context, isWrite, isEnable );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Short PAN ID Filter function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.Enable 0.Disable
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のShort PAN ID フィルタ 関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.可能  0. 不可能
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_lsi_s_panid_filter( int isWrite, BYTE isEnable )
+int conexio_cmm920_lsi_s_panid_filter_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable )
 {
 	unsigned long lsi_addr;
 	unsigned short value;
@@ -1167,7 +2239,7 @@ int conexio_cmm920_lsi_s_panid_filter( int isWrite, BYTE isEnable )
 	lsi_addr = CONEXIO_CMM920_LSIADDRESS_FILTER_S_PANID;
 	value = (unsigned short) isEnable;
 
-	iRet = conexio_cmm920_lsi( lsi_addr, isWrite, &value );
+	iRet = conexio_cmm920_lsi_h( ctx, lsi_addr, isWrite, &value );
 
 	if( !iRet ){
 		if( isWrite == CONEXIO_CMM920_SET_READING_READ ){
@@ -1180,19 +2252,32 @@ int conexio_cmm920_lsi_s_panid_filter( int isWrite, BYTE isEnable )
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_lsi_s_panid_filter_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_lsi_s_panid_filter_h を実行する関数
+**/
+int conexio_cmm920_lsi_s_panid_filter( int isWrite, BYTE isEnable )
+{
+	return conexio_cmm920_lsi_s_panid_filter_h( &global_default_context, isWrite, isEnable );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module D PAN ID Filter function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.Enable 0.Disable
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のD PAN ID フィルタ 関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.可能  0. 不可能
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_lsi_d_panid_filter( int isWrite, BYTE isEnable )
+int conexio_cmm920_lsi_d_panid_filter_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable )
 {
 	unsigned long lsi_addr;
 	unsigned short value;
@@ -1206,7 +2291,7 @@ int conexio_cmm920_lsi_d_panid_filter( int isWrite, BYTE isEnable )
 	lsi_addr = CONEXIO_CMM920_LSIADDRESS_FILTER_D_PANID;
 	value = (unsigned short) isEnable;
 
-	iRet = conexio_cmm920_lsi( lsi_addr, isWrite, &value );
+	iRet = conexio_cmm920_lsi_h( ctx, lsi_addr, isWrite, &value );
 
 	if( !iRet ){
 		if( isWrite == CONEXIO_CMM920_SET_READING_READ ){
@@ -1219,19 +2304,32 @@ int conexio_cmm920_lsi_d_panid_filter( int isWrite, BYTE isEnable )
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_lsi_d_panid_filter_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_lsi_d_panid_filter_h を実行する関数
+**/
+int conexio_cmm920_lsi_d_panid_filter( int isWrite, BYTE isEnable )
+{
+	return conexio_cmm920_lsi_d_panid_filter_h( &global_default_context, isWrite, isEnable );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module D Address Filter function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.Enable 0.Disable
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のD Address ID フィルタ 関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param isEnable : 1.可能  0. 不可能
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_lsi_d_address_filter( int isWrite, BYTE isEnable )
+int conexio_cmm920_lsi_d_address_filter_h( CONEXIO920HANDLE ctx, int isWrite, BYTE isEnable )
 {
 	unsigned long lsi_addr;
 	unsigned short value;
@@ -1245,7 +2343,7 @@ int conexio_cmm920_lsi_d_address_filter( int isWrite, BYTE isEnable )
 	lsi_addr = CONEXIO_CMM920_LSIADDRESS_FILTER_D_ADDR;
 	value = (unsigned short) isEnable;
 
-	iRet = conexio_cmm920_lsi( lsi_addr, isWrite, &value );
+	iRet = conexio_cmm920_lsi_h( ctx, lsi_addr, isWrite, &value );
 
 	if( !iRet ){
 		if( isWrite == CONEXIO_CMM920_SET_READING_READ ){
@@ -1258,21 +2356,34 @@ int conexio_cmm920_lsi_d_address_filter( int isWrite, BYTE isEnable )
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_lsi_d_address_filter_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_lsi_d_address_filter_h を実行する関数
+**/
+int conexio_cmm920_lsi_d_address_filter( int isWrite, BYTE isEnable )
+{
+	return conexio_cmm920_lsi_d_address_filter_h( &global_default_context, isWrite, isEnable );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module data sfd function
+	@param ctx : instance handle
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param address : address
 	@param sfd_no :
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のData sfd 関数
+	@param ctx : インスタンスハンドル
 	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
 	@param address : アドレス
 	@param sfd_no :
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_lsi_data_sfd( int isWrite, unsigned short address, BYTE sfd_no )
+int conexio_cmm920_lsi_data_sfd_h( CONEXIO920HANDLE ctx, int isWrite, unsigned short address, BYTE sfd_no )
 {
 	unsigned long lsi_addr;
 	unsigned short value;
@@ -1281,7 +2392,7 @@ int conexio_cmm920_lsi_data_sfd( int isWrite, unsigned short address, BYTE sfd_n
 	lsi_addr = CONEXIO_CMM920_LSIADDRESS_SFD( sfd_no );
 	value = address;
 
-	iRet = conexio_cmm920_lsi( lsi_addr, isWrite, &value );
+	iRet = conexio_cmm920_lsi_h( ctx, lsi_addr, isWrite, &value );
 
 	if( !iRet ){
 		if( isWrite == CONEXIO_CMM920_SET_READING_READ ){
@@ -1294,49 +2405,269 @@ int conexio_cmm920_lsi_data_sfd( int isWrite, unsigned short address, BYTE sfd_n
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_lsi_data_sfd_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_lsi_data_sfd_h を実行する関数
+**/
+int conexio_cmm920_lsi_data_sfd( int isWrite, unsigned short address, BYTE sfd_no )
+{
+	return conexio_cmm920_lsi_data_sfd_h( &global_default_context, isWrite, address, sfd_no );
+}
+
+/// multi hop bring-up profile
+static const CONEXIO920LSIOP conexio_cmm920_lsi_profile_multi[] = {
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_MHR_MODE, CONEXIO_CMM920_SET_ENABLE, 0xFFFF, 0 },
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_CRC_CALC_INVERSE, CONEXIO_CMM920_SET_ENABLE, 0xFFFF, 0 },
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_FILTER_S_PANID, CONEXIO_CMM920_SET_ENABLE, 0xFFFF, 0 },
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_FILTER_D_PANID, CONEXIO_CMM920_SET_ENABLE, 0xFFFF, 0 },
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_FILTER_D_ADDR, CONEXIO_CMM920_SET_ENABLE, 0xFFFF, 0 },
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_PRELEN, CONEXIO_CMM920_PRELEN_MULTIHOP, 0xFFFF, 0 },
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_SFD( CONEXIO_CMM920_SFDNUM_0 ), CONEXIO_CMM920_SFD_MULTIHOP, 0xFFFF, 0 },
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_WHITENING, CONEXIO_CMM920_SET_DISABLE, 0xFFFF, 0 },	// 2016.01.15 (1)
+};
+
+/// single hop profile ( multi hop frame handling off )
+static const CONEXIO920LSIOP conexio_cmm920_lsi_profile_single[] = {
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_MHR_MODE, CONEXIO_CMM920_SET_DISABLE, 0xFFFF, 0 },
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_CRC_CALC_INVERSE, CONEXIO_CMM920_SET_DISABLE, 0xFFFF, 0 },
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_FILTER_S_PANID, CONEXIO_CMM920_SET_DISABLE, 0xFFFF, 0 },
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_FILTER_D_PANID, CONEXIO_CMM920_SET_DISABLE, 0xFFFF, 0 },
+	{ CONEXIO_CMM920_LSI_OP_WRITE, CONEXIO_CMM920_LSIADDRESS_FILTER_D_ADDR, CONEXIO_CMM920_SET_DISABLE, 0xFFFF, 0 },
+};
+
+#define CONEXIO_CMM920_LSI_PROFILE_MAX	16	///< maximum number of profile operations
+
+/**
+	@~English
+	@brief LSI register access without the fixed wait
+	@param ctx : instance handle
+	@param lsi_addr : LSI address
+	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
+	@param value : write value or read value
+	@return Success : 0 , Failed : From -16 to -31 Send Error, less than -32 : Receive Error, more than 0 : Result Error
+	@~Japanese
+	@brief 固定の待ち時間なしで LSI レジスタにアクセスする関数
+	@param ctx : インスタンスハンドル
+	@param lsi_addr : LSI アドレス
+	@param isWrite : CONEXIO_CMM920_SET_READING_READ or CONEXIO_CMM920_SET_READING_WRITE
+	@param value : 書き込み値 または 読み出し値
+	@return 成功:  0 失敗 :  送信 エラー: -16～-31,　受信エラー : -32～, 結果エラー : 1以上
+	@par 設定キャッシュを経由せずに LSI コマンドを送信し、応答を受信します。
+**/
+static int _conexio_cmm920_lsi_access( CONEXIO920HANDLE ctx, unsigned long lsi_addr, int isWrite, unsigned short *value )
+{
+	int iRet;
+	BYTE Data[6];
+	int Size = 6;
+
+	Data[0] = (lsi_addr & 0x00FF0000 ) >> 16;
+	Data[1] = (lsi_addr & 0x0000FF00 ) >> 8;
+	Data[2] = (lsi_addr & 0x000000FF );
+	Data[3] = isWrite;
+	Data[4] = (*value & 0xFF00 ) >> 8;
+	Data[5] = (*value & 0xFF );
+
+	iRet = SendCommand_h( ctx, Data, ( isWrite == CONEXIO_CMM920_SET_READING_WRITE ? 6 : 4 ),
+		CONEXIO_CMM920_MODE_COMMON, CONEXIO_CMM920_SET_LSI );
+	if( iRet < 0 )	return (-16 * 1) + iRet;
+
+	iRet = RecvCommandAck_h( ctx, Data, &Size, CONEXIO_CMM920_MODE_COMMON, CONEXIO_CMM920_SET_LSI );
+	if( iRet < 0 )	return (-16 * 2) + iRet;
+
+	if( iRet == 0 && isWrite == CONEXIO_CMM920_SET_READING_READ ){
+		*value = (Data[4] << 8) | Data[5];
+	}
+
+	return iRet;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module LSI register transaction function
+	@param ctx : instance handle
+	@param ops : operation list
+	@param num : number of operations
+	@param fail_index : index of the failed operation ( -1 : no failure ) (option)
+	@return Success : 0 , Failed : -1 : Parameter Error, -3 : Verify Error, From -16 to -31 Send Error, less than -32 : Receive Error, more than 0 : Result Error
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の LSI レジスタ一括設定 関数
+	@param ctx : インスタンスハンドル
+	@param ops : 操作リスト
+	@param num : 操作数
+	@param fail_index : 失敗した操作の番号 ( -1 : 失敗なし ) (オプション)
+	@return 成功:  0 失敗 :  パラメータエラー : -1, 照合エラー : -3, 送信 エラー: -16～-31,　受信エラー : -32～, 結果エラー : 1以上
+	@par 操作リストを先頭から順に実行し、最初に失敗した操作で中断します。
+	@par 各操作は応答を受信した時点で次の操作を送信します。
+	@par 読み出しと照合の操作は読み出した値を result に格納します。
+**/
+int conexio_cmm920_lsi_transaction_h( CONEXIO920HANDLE ctx, PCONEXIO920LSIOP ops, int num, int *fail_index )
+{
+	int i;
+	int iRet = 0;
+	unsigned short value;
+
+	if( fail_index != NULL ) *fail_index = -1;
+
+	if( ops == NULL || num < 0 ){
+		DbgPrint("<conexio_cmm920_lsi_transaction>:Parameter Error\n");
+		return -1;
+	}
+
+	for( i = 0; i < num; i++ ){
+		switch( ops[i].op ){
+		case CONEXIO_CMM920_LSI_OP_WRITE:
+			value = ops[i].value;
+			iRet = _conexio_cmm920_lsi_access( ctx, ops[i].lsi_addr, CONEXIO_CMM920_SET_READING_WRITE, &value );
+			break;
+		case CONEXIO_CMM920_LSI_OP_READ:
+		case CONEXIO_CMM920_LSI_OP_VERIFY:
+			value = 0;
+			iRet = _conexio_cmm920_lsi_access( ctx, ops[i].lsi_addr, CONEXIO_CMM920_SET_READING_READ, &value );
+			if( iRet == 0 ){
+				ops[i].result = value;
+				if( ops[i].op == CONEXIO_CMM920_LSI_OP_VERIFY &&
+					( value & ops[i].mask ) != ( ops[i].value & ops[i].mask ) ){
+					iRet = CONEXIO_CMM920_LSI_VERIFY_ERROR;
+				}
+			}
+			break;
+		default:
+			iRet = -1;
+			break;
+		}
+
+		if( iRet ){
+			DbgPrint("<conexio_cmm920_lsi_transaction>:Error : %x index : %d\n", iRet, i );
+			if( fail_index != NULL ) *fail_index = i;
+			break;
+		}
+	}
+
+	return iRet;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_lsi_transaction_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_lsi_transaction_h を実行する関数
+**/
+int conexio_cmm920_lsi_transaction( PCONEXIO920LSIOP ops, int num, int *fail_index )
+{
+	return conexio_cmm920_lsi_transaction_h( &global_default_context, ops, num, fail_index );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module LSI profile function
+	@param ctx : instance handle
+	@param hop : CONEXIO_CMM920_HOP_SINGLE or CONEXIO_CMM920_HOP_MULTI
+	@param fail_index : index of the failed operation ( -1 : no failure ) (option)
+	@return conexio_cmm920_lsi_transaction_h
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の LSI プロファイル設定 関数
+	@param ctx : インスタンスハンドル
+	@param hop : CONEXIO_CMM920_HOP_SINGLE or CONEXIO_CMM920_HOP_MULTI
+	@param fail_index : 失敗した操作の番号 ( -1 : 失敗なし ) (オプション)
+	@return conexio_cmm920_lsi_transaction_h の戻り値
+	@par シングルホップのプロファイルはマルチホップ用のフレーム処理とフィルタを無効にします。
+	@par プリアンブル長と SFD も既定値に戻す場合は conexio_cmm920_reset を使用してください。
+**/
+int conexio_cmm920_lsi_profile_h( CONEXIO920HANDLE ctx, BYTE hop, int *fail_index )
+{
+	CONEXIO920LSIOP ops[CONEXIO_CMM920_LSI_PROFILE_MAX];
+	int num;
+
+	if( hop == CONEXIO_CMM920_HOP_MULTI ){
+		num = sizeof(conexio_cmm920_lsi_profile_multi) / sizeof(conexio_cmm920_lsi_profile_multi[0]);
+		memcpy( ops, conexio_cmm920_lsi_profile_multi, sizeof(conexio_cmm920_lsi_profile_multi) );
+	}else{
+		num = sizeof(conexio_cmm920_lsi_profile_single) / sizeof(conexio_cmm920_lsi_profile_single[0]);
+		memcpy( ops, conexio_cmm920_lsi_profile_single, sizeof(conexio_cmm920_lsi_profile_single) );
+	}
+
+	return conexio_cmm920_lsi_transaction_h( ctx, ops, num, fail_index );
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_lsi_profile_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_lsi_profile_h を実行する関数
+**/
+int conexio_cmm920_lsi_profile( BYTE hop, int *fail_index )
+{
+	return conexio_cmm920_lsi_profile_h( &global_default_context, hop, fail_index );
+}
+
 // End Lsi Functions < Extension >
 
 //int conexio_cmm920_data_send_single(BYTE buf[], int size, int hop, int send_mode, BYTE r_buf[] ) //2016.01.11 (2)
 /**
 	@~English
 	@brief CONEXIO 920MHz Module data send single hop function
+	@param ctx : instance handle
 	@param buf : send data buffer
 	@param size : send data size
 	@param send_mode : send mode
 	@param r_buf : receive buffer (option)
-	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
+	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error, Airtime budget : -9
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のシングルホップ用 データ送信 関数
+	@param ctx : インスタンスハンドル
 	@param buf : 送信データバッファ
 	@param size : 送信データサイズ
 	@param send_mode : 送信モード
 	@param r_buf : 受信バッファ (オプション)
 	@warning ANTENNA MODE 1は、TELEC認証されてないので注意
-	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
+	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～, 送信時間の予算超過 : -9
 **/
-int conexio_cmm920_data_send_single(BYTE buf[], int size, int send_mode, BYTE r_buf[] )
+int conexio_cmm920_data_send_single_h(CONEXIO920HANDLE ctx, BYTE buf[], int size, int send_mode, BYTE r_buf[] )
 {
 	int iRet;
 	BYTE antenna_mode = 0;
+	int config;
+
+	// cached antenna mode ( the module is read only until the cache is filled )
+	config = _conexio_cmm920_config_index( CONEXIO_CMM920_MODE_COMMON, CONEXIO_CMM920_SET_ANTENNA );
+	if( !_conexio_cmm920_config_get( ctx, config, &antenna_mode, 1 ) ){
+		if( conexio_cmm920_antenna_h( ctx, CONEXIO_CMM920_SET_READING_READ, &antenna_mode ) )
+			antenna_mode = 0;
+	}
 
 	if( antenna_mode == CONEXIO_CMM920_SET_ANTENNA_01 ){
 		printf("WARNING : SETTING ANTENNA MODE 1 CANNOT SEND DATA.< TELEC VIOLATION >");
 		return 1;
 	}
 
-	iRet = SendTelegram(buf, size, CONEXIO_CMM920_HOP_SINGLE, send_mode , NULL, NULL, NULL, NULL );
+	iRet = SendTelegram_h(ctx, buf, size, CONEXIO_CMM920_HOP_SINGLE, send_mode , NULL, NULL, NULL, NULL );
 
-	if( r_buf != NULL )
+	// 送信時間の予算超過は送信していないため応答を待たない
+	if( r_buf != NULL && iRet != -9 )
 	{
-		iRet = RecvTelegram(r_buf, &size, CONEXIO_CMM920_HOP_SINGLE, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+		iRet = RecvTelegram_h(ctx, r_buf, &size, CONEXIO_CMM920_HOP_SINGLE, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 	}
 
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_data_send_single_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_data_send_single_h を実行する関数
+**/
+int conexio_cmm920_data_send_single(BYTE buf[], int size, int send_mode, BYTE r_buf[] )
+{
+	return conexio_cmm920_data_send_single_h( &global_default_context, buf, size, send_mode, r_buf );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module data send multi hop header function
+	@param ctx : instance handle
 	@param buf : send data buffer
 	@param size : send data size
 	@param send_mode : send mode
@@ -1345,9 +2676,10 @@ int conexio_cmm920_data_send_single(BYTE buf[], int size, int send_mode, BYTE r_
 	@param dest_addr : Dest Address
 	@param src_addr : Source Addres
 	@param r_buf : receive buffer (option)
-	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
+	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error, Airtime budget : -9
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のマルチホップヘッダ付き データ送信 関数
+	@param ctx : インスタンスハンドル
 	@param buf : 送信データバッファ
 	@param size : 送信データサイズ
 	@param send_mode : 送信モード
@@ -1356,25 +2688,38 @@ int conexio_cmm920_data_send_single(BYTE buf[], int size, int send_mode, BYTE r_
 	@param dest_addr : 送信先アドレス
 	@param src_addr : 送信元アドレス
 	@param r_buf : 受信バッファ (オプション)
-	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
+	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～, 送信時間の予算超過 : -9
 **/
-int conexio_cmm920_data_send_multi(BYTE buf[], int size, int send_mode, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr, BYTE r_buf[])
+int conexio_cmm920_data_send_multi_h(CONEXIO920HANDLE ctx, BYTE buf[], int size, int send_mode, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr, BYTE r_buf[])
 {
 	int iRet;
 
-	iRet = SendTelegram(buf, size, CONEXIO_CMM920_HOP_MULTI, send_mode , &dest_id, &src_id, &dest_addr, &src_addr );
+	iRet = SendTelegram_h(ctx, buf, size, CONEXIO_CMM920_HOP_MULTI, send_mode , &dest_id, &src_id, &dest_addr, &src_addr );
 
-	if( r_buf != NULL )
+	// 送信時間の予算超過は送信していないため応答を待たない
+	if( r_buf != NULL && iRet != -9 )
 	{
-		iRet = RecvTelegram(r_buf, &size, CONEXIO_CMM920_HOP_MULTI, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+		iRet = RecvTelegram_h(ctx, r_buf, &size, CONEXIO_CMM920_HOP_MULTI, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 	}
 
 	return iRet;
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_data_send_multi_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_data_send_multi_h を実行する関数
+**/
+int conexio_cmm920_data_send_multi(BYTE buf[], int size, int send_mode, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr, BYTE r_buf[])
+{
+	return conexio_cmm920_data_send_multi_h( &global_default_context, buf, size, send_mode, dest_id, src_id, dest_addr, src_addr, r_buf );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module data receive function
+	@param ctx : instance handle
 	@param buf : receive data buffer
 	@param size : receive data size
 	@param hop : hop mode
@@ -1384,6 +2729,7 @@ int conexio_cmm920_data_send_multi(BYTE buf[], int size, int send_mode, unsigned
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のデータ受信 関数
+	@param ctx : インスタンスハンドル
 	@param buf : 受信データバッファ
 	@param size : 受信データサイズ
 	@param hop : ホップモード
@@ -1392,22 +2738,35 @@ int conexio_cmm920_data_send_multi(BYTE buf[], int size, int send_mode, unsigned
 	@param crc_val: CRC値
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_data_recv(BYTE buf[], int *size, int hop, int *r_channel, int *rx_pwr, unsigned int *crc_val ){
+int conexio_cmm920_data_recv_h(CONEXIO920HANDLE ctx, BYTE buf[], int *size, int hop, int *r_channel, int *rx_pwr, unsigned int *crc_val ){
 
-	return RecvTelegram(buf, size, hop , r_channel, rx_pwr, crc_val, NULL, NULL, NULL, NULL );
+	return RecvTelegram_h(ctx, buf, size, hop , r_channel, rx_pwr, crc_val, NULL, NULL, NULL, NULL );
 }
 
 /**
 	@~English
-	@brief CONEXIO 920MHz Module data receive of single hop function
-	@param buf : receive data buffer
-	@param size : receive data size
-	@param r_channel : receive channel
-	@param rx_pwr : receive power
-	@param crc_val: crc value
+	@brief conexio_cmm920_data_recv_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_data_recv_h を実行する関数
+**/
+int conexio_cmm920_data_recv(BYTE buf[], int *size, int hop, int *r_channel, int *rx_pwr, unsigned int *crc_val )
+{
+	return conexio_cmm920_data_recv_h( &global_default_context, buf, size, hop, r_channel, rx_pwr, crc_val );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module data receive of single hop function
+	@param ctx : instance handle
+	@param buf : receive data buffer
+	@param size : receive data size
+	@param r_channel : receive channel
+	@param rx_pwr : receive power
+	@param crc_val: crc value
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のシングルホップ用データ受信 関数
+	@param ctx : インスタンスハンドル
 	@param buf : 受信データバッファ
 	@param size : 受信データサイズ
 	@param r_channel : 受信チャネル
@@ -1415,14 +2774,26 @@ int conexio_cmm920_data_recv(BYTE buf[], int *size, int hop, int *r_channel, int
 	@param crc_val: CRC値
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
+int conexio_cmm920_data_recv_single_h(CONEXIO920HANDLE ctx, BYTE buf[], int *size, int *r_channel, int *rx_pwr, unsigned int *crc_val )
+{
+	return RecvTelegram_h(ctx, buf, size, CONEXIO_CMM920_HOP_SINGLE ,r_channel, rx_pwr, crc_val, NULL, NULL, NULL, NULL );
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_data_recv_single_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_data_recv_single_h を実行する関数
+**/
 int conexio_cmm920_data_recv_single(BYTE buf[], int *size, int *r_channel, int *rx_pwr, unsigned int *crc_val )
 {
-	return RecvTelegram(buf, size, CONEXIO_CMM920_HOP_SINGLE ,r_channel, rx_pwr, crc_val, NULL, NULL, NULL, NULL );
+	return conexio_cmm920_data_recv_single_h( &global_default_context, buf, size, r_channel, rx_pwr, crc_val );
 }
 
 /**
 	@~English
 	@brief CONEXIO 920MHz Module data receive with multi hop header function
+	@param ctx : instance handle
 	@param buf : receive data buffer
 	@param size : receive data size
 	@param r_channel : receive channel
@@ -1435,6 +2806,7 @@ int conexio_cmm920_data_recv_single(BYTE buf[], int *size, int *r_channel, int *
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module のマルチホップヘッダ付きデータ受信 関数
+	@param ctx : インスタンスハンドル
 	@param buf : 受信データバッファ
 	@param size : 受信データサイズ
 	@param r_channel : 受信チャネル
@@ -1446,8 +2818,170 @@ int conexio_cmm920_data_recv_single(BYTE buf[], int *size, int *r_channel, int *
 	@param src_addr : 送信元アドレス
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_data_recv_multi(BYTE buf[], int *size, int *r_channel, int *rx_pwr, unsigned int *crc_val, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr ){
-	return RecvTelegram(buf, size, CONEXIO_CMM920_HOP_MULTI , r_channel, rx_pwr, crc_val, dest_id, src_id, dest_addr, src_addr );
+int conexio_cmm920_data_recv_multi_h(CONEXIO920HANDLE ctx, BYTE buf[], int *size, int *r_channel, int *rx_pwr, unsigned int *crc_val, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr ){
+	return RecvTelegram_h(ctx, buf, size, CONEXIO_CMM920_HOP_MULTI , r_channel, rx_pwr, crc_val, dest_id, src_id, dest_addr, src_addr );
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_data_recv_multi_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_data_recv_multi_h を実行する関数
+**/
+int conexio_cmm920_data_recv_multi(BYTE buf[], int *size, int *r_channel, int *rx_pwr, unsigned int *crc_val, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr )
+{
+	return conexio_cmm920_data_recv_multi_h( &global_default_context, buf, size, r_channel, rx_pwr, crc_val, dest_id, src_id, dest_addr, src_addr );
+}
+
+/**
+	@~English
+	@brief Get multi hop header layout function
+	@param fc : frame control
+	@return layout
+	@~Japanese
+	@brief マルチホップヘッダのレイアウトを取得する関数
+	@param fc : フレームコントロール
+	@return レイアウト
+	@par アドレスモードと PAN ID 圧縮の組み合わせごとに、コンパイル時に計算したオフセット表を返します。
+**/
+const CONEXIO920MHRLAYOUT* conexio_cmm920_mhr_layout( unsigned short fc )
+{
+	return &conexio_cmm920_mhr_layout_table[CONEXIO_CMM920_MHR_FC_DESTADDRMODE( fc ) +
+		CONEXIO_CMM920_MHR_FC_SRCADDRMODE( fc ) * 4 +
+		CONEXIO_CMM920_MHR_FC_PANIDCOMP( fc ) * 16];
+}
+
+/**
+	@~English
+	@brief write little endian address function
+	@param buf : buffer
+	@param value : value
+	@param size : size ( 0 to 2 )
+	@~Japanese
+	@brief アドレスをリトルエンディアンで書き込む関数
+	@param buf : バッファ
+	@param value : 値
+	@param size : サイズ ( 0 ～ 2 )
+**/
+static void _conexio_cmm920_mhr_put( BYTE *buf, long value, int size )
+{
+	if( size > 0 ) buf[0] = ( value & 0xFF );
+	if( size > 1 ) buf[1] = ( ( value & 0xFF00 ) >> 8 );
+}
+
+/**
+	@~English
+	@brief read little endian address function
+	@param buf : buffer
+	@param size : size ( 0 to 2 )
+	@return value
+	@~Japanese
+	@brief リトルエンディアンのアドレスを読み込む関数
+	@param buf : バッファ
+	@param size : サイズ ( 0 ～ 2 )
+	@return 値
+**/
+static long _conexio_cmm920_mhr_get( BYTE *buf, int size )
+{
+	if( size == 1 ) return buf[0];
+	if( size == 2 ) return ( buf[1] << 8 ) + buf[0];
+	return 0;
+}
+
+/**
+	@~English
+	@brief Encode multi hop header function
+	@param ctx : instance handle
+	@param mhr : header buffer ( frame control position in the send frame )
+	@param fc : frame control
+	@param dest_id : dest PAN ID
+	@param src_id : source PAN ID
+	@param dest_addr : Dest Address
+	@param src_addr : Source Address
+	@return Success : header size , Failed : -1 ( 64bit address )
+	@~Japanese
+	@brief マルチホップヘッダを作成する関数
+	@param ctx : インスタンスハンドル
+	@param mhr : ヘッダバッファ ( 送信フレーム内のフレームコントロールの位置 )
+	@param fc : フレームコントロール
+	@param dest_id : 送信先PAN　ID
+	@param src_id : 送信元 PAN ID
+	@param dest_addr : 送信先アドレス
+	@param src_addr : 送信元アドレス
+	@return 成功:  ヘッダサイズ 失敗 :  -1 ( 64bit アドレス )
+	@par シーケンス番号はインスタンスの番号を使用します。
+	@par レイアウトにない PAN ID やアドレスは書き込みません。
+**/
+int conexio_cmm920_mhr_encode_h( CONEXIO920HANDLE ctx, BYTE mhr[], unsigned short fc, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr )
+{
+	const CONEXIO920MHRLAYOUT *layout = conexio_cmm920_mhr_layout( fc );
+
+	if( !layout->valid ) return -1;
+
+	mhr[0] = ( fc & 0xFF );
+	mhr[1] = ( ( fc & 0xFF00 ) >> 8 );
+	mhr[2] = ctx->seq_num++;
+
+	if( layout->dest_id ) _conexio_cmm920_mhr_put( &mhr[layout->dest_id], dest_id, 2 );
+	_conexio_cmm920_mhr_put( &mhr[layout->dest_addr], dest_addr, layout->dest_addr_size );
+	if( layout->src_id ) _conexio_cmm920_mhr_put( &mhr[layout->src_id], src_id, 2 );
+	_conexio_cmm920_mhr_put( &mhr[layout->src_addr], src_addr, layout->src_addr_size );
+
+	return layout->size;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_mhr_encode_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_mhr_encode_h を実行する関数
+**/
+int conexio_cmm920_mhr_encode( BYTE mhr[], unsigned short fc, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr )
+{
+	return conexio_cmm920_mhr_encode_h( &global_default_context, mhr, fc, dest_id, src_id, dest_addr, src_addr );
+}
+
+/**
+	@~English
+	@brief Decode multi hop header function
+	@param buf : received data ( frame control position )
+	@param size : received data size ( 0 : not checked )
+	@param view : header view
+	@return Success : header size , Failed : -1 ( 64bit address or too short )
+	@~Japanese
+	@brief マルチホップヘッダを解析する関数
+	@param buf : 受信データ ( フレームコントロールの位置 )
+	@param size : 受信データサイズ ( 0 : チェックしない )
+	@param view : ヘッダビュー
+	@return 成功:  ヘッダサイズ 失敗 :  -1 ( 64bit アドレスまたはサイズ不足 )
+	@par データはコピーせず、 view->payload は buf の中のデータを指します。
+	@par PAN ID 圧縮の場合、 view->src_id は送信先PAN　ID になります。
+**/
+int conexio_cmm920_mhr_decode( BYTE buf[], int size, PCONEXIO920MHRVIEW view )
+{
+	const CONEXIO920MHRLAYOUT *layout;
+	unsigned short fc;
+
+	if( size != 0 && size < 3 ) return -1;
+
+	fc = ( buf[1] << 8 ) | buf[0];
+	layout = conexio_cmm920_mhr_layout( fc );
+	if( !layout->valid || ( size != 0 && size < layout->size ) ) return -1;
+
+	view->layout = layout;
+	view->fc = fc;
+	view->seq_no = buf[2];
+	view->dest_id = layout->dest_id ? ( buf[layout->dest_id + 1] << 8 ) + buf[layout->dest_id] : 0;
+	view->src_id = layout->src_id ? ( buf[layout->src_id + 1] << 8 ) + buf[layout->src_id] : view->dest_id;
+	view->dest_addr = _conexio_cmm920_mhr_get( &buf[layout->dest_addr], layout->dest_addr_size );
+	view->src_addr = _conexio_cmm920_mhr_get( &buf[layout->src_addr], layout->src_addr_size );
+	view->payload = &buf[layout->size];
+	view->size = ( size != 0 ) ? size - layout->size : 0;
+
+	DbgPrint("<conexio_cmm920_mhr_decode> fc:%x seq_no:%d dest_id : %x src_id : %x dest_addr :%lx src_addr : %lx \n ",
+		fc, view->seq_no, view->dest_id, view->src_id, view->dest_addr, view->src_addr);
+
+	return layout->size;
 }
 
 // 2016.01.11 (2) 
@@ -1472,37 +3006,20 @@ int conexio_cmm920_data_recv_multi(BYTE buf[], int *size, int *r_channel, int *r
 **/
 int calcMHR(int dest_mode, int src_mode, int version, int panidcomp , unsigned short *fc)
 {
-	int size = 3; // 2016.01.15 (2) change
+	const CONEXIO920MHRLAYOUT *layout;
 
 	*fc = CONEXIO_CMM920_MHR_FC(src_mode, version, dest_mode, 0, panidcomp, 0, 0, 0, 1);
 
-	if( version < 0x02 ){
-
-		switch( dest_mode ){
-		case CONEXIO_CMM920_MHR_FC_DESTADDRMODE_8BIT:
-			size += 3; // pan id (2 byte ) + addr (1 byte)
-			break;
-		case CONEXIO_CMM920_MHR_FC_DESTADDRMODE_16BIT:
-			size += 4; // pan id (2 byte ) + addr (2 byte)
-			break;
-		}
-
-		switch( src_mode ){
-		case CONEXIO_CMM920_MHR_FC_SRCADDRMODE_8BIT:
-			size += 3; // pan id (2 byte ) + addr (1 byte)
-			break;
-		case CONEXIO_CMM920_MHR_FC_SRCADDRMODE_16BIT:
-			size += 4; // pan id (2 byte ) + addr (2 byte)
-			break;
-		}
-	}
+	layout = conexio_cmm920_mhr_layout( *fc );
+	if( version >= 0x02 || !layout->valid ) return 3;	// fc(2byte) + seq number
 
-	return size;
+	return layout->size;
 }
 
 /**
 	@~English
 	@brief Add multi hop header function
+	@param ctx : instance handle
 	@param pktBuf : packet buffer
 	@param fc :
 	@param dest_id : dest PAN ID
@@ -1512,6 +3029,7 @@ int calcMHR(int dest_mode, int src_mode, int version, int panidcomp , unsigned s
 	@return Success : Data Offset
 	@~Japanese
 	@brief マルチホップヘッダ追加 関数
+	@param ctx : インスタンスハンドル
 	@param pktBuf : パケットバッファ
 	@param fc :
 	@param dest_id : 送信先PAN　ID
@@ -1520,60 +3038,28 @@ int calcMHR(int dest_mode, int src_mode, int version, int panidcomp , unsigned s
 	@param src_addr : 送信元アドレス
 	@return 成功:  データのオフセット
 **/
-int addMHR(BYTE pktBuf[] , unsigned short fc, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr)
+int addMHR_h(CONEXIO920HANDLE ctx, BYTE pktBuf[] , unsigned short fc, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr)
 {
-	unsigned int offset = 0;
-	unsigned int val_base_addr = 6; // 2016.01.15 (2)
-
-	pktBuf[3] = ( fc & 0xFF );
-	pktBuf[4] = ( ( fc & 0xFF00 ) >> 8 );
+	int size;
 
-	//seq number追加(仮)
-	pktBuf[5] = global_seq_num++; // 2016.01.15 (2)
-
-	if( dest_id != NULL ){
-		pktBuf[val_base_addr + offset] = ( *dest_id & 0xFF );
-		pktBuf[val_base_addr + 1 + offset] = ( ( *dest_id & 0xFF00 ) >> 8 );
-		offset += 2;
-	}
-	if( dest_addr != NULL ){
-		switch( CONEXIO_CMM920_MHR_FC_DESTADDRMODE( fc ) ){
-		case CONEXIO_CMM920_MHR_FC_DESTADDRMODE_NONE:
-			break;
-		case CONEXIO_CMM920_MHR_FC_DESTADDRMODE_8BIT:
-			pktBuf[val_base_addr + offset] = ( *dest_addr & 0xFF );
-			offset += 1;
-			break;
-		case CONEXIO_CMM920_MHR_FC_DESTADDRMODE_16BIT:
-			pktBuf[val_base_addr + offset] = ( *dest_addr & 0xFF );
-			pktBuf[val_base_addr + 1 + offset] = ( ( *dest_addr & 0xFF00 ) >> 8 );
-			offset += 2;
-			break;
-		}
-	}
-	if( src_id != NULL ){
-		pktBuf[val_base_addr + offset] = ( *src_id & 0xFF );
-		pktBuf[val_base_addr + 1 + offset] = ( ( *src_id & 0xFF00 ) >> 8 );
-		offset += 2;
-	}
+	// pktBuf[0] - pktBuf[2] : send mode + size(2byte)
+	size = conexio_cmm920_mhr_encode_h( ctx, &pktBuf[3], fc,
+		( dest_id != NULL ) ? *dest_id : 0, ( src_id != NULL ) ? *src_id : 0,
+		( dest_addr != NULL ) ? *dest_addr : 0, ( src_addr != NULL ) ? *src_addr : 0 );
+	if( size < 0 ) return 0;
 
-	if( src_addr != NULL ){
-		switch( CONEXIO_CMM920_MHR_FC_SRCADDRMODE( fc ) ){
-		case CONEXIO_CMM920_MHR_FC_SRCADDRMODE_NONE:
-			break;
-		case CONEXIO_CMM920_MHR_FC_SRCADDRMODE_8BIT:
-			pktBuf[val_base_addr + offset] = ( *src_addr & 0xFF );
-			offset += 1;
-			break;
-		case CONEXIO_CMM920_MHR_FC_SRCADDRMODE_16BIT:
-			pktBuf[val_base_addr + offset] = ( *src_addr & 0xFF );
-			pktBuf[val_base_addr + 1 + offset] = ( ( *src_addr & 0xFF00 ) >> 8 );
-			offset += 2;
-			break;
-		}
-	}
+	return size - 3;
+}
 
-	return offset;
+/**
+	@~English
+	@brief addMHR_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで addMHR_h を実行する関数
+**/
+int addMHR(BYTE pktBuf[] , unsigned short fc, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr)
+{
+	return addMHR_h( &global_default_context, pktBuf, fc, dest_id, src_id, dest_addr, src_addr );
 }
 /**
 	@~English
@@ -1599,805 +3085,3564 @@ int addMHR(BYTE pktBuf[] , unsigned short fc, unsigned short *dest_id, unsigned
 **/
 int parseMHR(BYTE dataBuf[] , unsigned short *pFc, BYTE *pSeq_no, unsigned short *pDest_id, unsigned short *pSrc_id, long *pDest_addr, long *pSrc_addr)
 {
-	unsigned int offset = 3;
-
-	unsigned short fc = 0;
-	BYTE seq_no = 0;
-	unsigned short dest_id = 0;
-	unsigned short src_id = 0;
-	long dest_addr = 0;
-	long src_addr = 0;
+	CONEXIO920MHRVIEW view;
+	int offset;
 
+	offset = conexio_cmm920_mhr_decode( dataBuf, 0, &view );
+	if( offset < 0 ) return -1;
 
-	fc = ( dataBuf[1] << 8 ) | dataBuf[0];
-	seq_no = dataBuf[2];
-	
-	{
-		dest_id = ( dataBuf[ offset + 1 ] << 8 ) + dataBuf[ offset ];
-		offset += 2;
-	}
-
-	{
-		switch( CONEXIO_CMM920_MHR_FC_DESTADDRMODE( fc ) ){
-		case CONEXIO_CMM920_MHR_FC_DESTADDRMODE_NONE:
-			break;
-		case CONEXIO_CMM920_MHR_FC_DESTADDRMODE_8BIT:
-			dest_addr = dataBuf[ offset ];
-			offset += 1;
-			break;
-		case CONEXIO_CMM920_MHR_FC_DESTADDRMODE_16BIT:
-			dest_addr = ( dataBuf[ offset + 1 ] << 8 ) + dataBuf[ offset ];
-			offset += 2;
-			break;
-		default : 
-			return -1;
-		}
-	}
+	if( pFc != NULL ) *pFc = view.fc;
+	if( pSeq_no != NULL )	*pSeq_no = view.seq_no;
+	if( pDest_addr != NULL ) *pDest_addr = view.dest_addr;
+	if( pDest_id != NULL )	*pDest_id = view.dest_id;
+	if( pSrc_addr != NULL ) *pSrc_addr = view.src_addr;
+	if( pSrc_id != NULL ) *pSrc_id = view.src_id;
 
-	{
-		src_id = ( dataBuf[ offset + 1 ] << 8 ) + dataBuf[ offset ];
-		offset += 2;
-	}
+	return offset;
+}
 
-	{
-		switch( CONEXIO_CMM920_MHR_FC_SRCADDRMODE( fc ) ){
-		case CONEXIO_CMM920_MHR_FC_SRCADDRMODE_NONE:
-			break;
-		case CONEXIO_CMM920_MHR_FC_SRCADDRMODE_8BIT:
-			src_addr = dataBuf[ offset ];
-			offset += 1;
-			break;
-		case CONEXIO_CMM920_MHR_FC_SRCADDRMODE_16BIT:
-			src_addr = ( dataBuf[ offset + 1 ] << 8 ) + dataBuf[ offset ];
-			offset += 2;
-			break;
-		default : 
-			return -1;			
+/**
+	@~English
+	@brief get frame from the pool function
+	@return Success : frame buffer , Failed : NULL ( all frames are used )
+	@~Japanese
+	@brief フレームプールからフレームを取得する関数
+	@return 成功:  フレームバッファ 失敗 :  NULL ( 空きなし )
+**/
+static BYTE* _conexio_cmm920_frame_get( void )
+{
+	int i;
+	int used, peak;
+
+	for( i = 0; i < CONEXIO_CMM920_FRAME_POOL_NUM; i++ ){
+		if( __sync_lock_test_and_set( &global_frame_used[i], 1 ) == 0 ){
+			__sync_fetch_and_add( &global_frame_get, 1 );
+			used = __sync_add_and_fetch( &global_frame_in_use, 1 );
+			do{
+				peak = global_frame_peak;
+			}while( used > peak && !__sync_bool_compare_and_swap( &global_frame_peak, peak, used ) );
+			return &global_frame_pool[i][0];
 		}
 	}
+	__sync_fetch_and_add( &global_frame_empty, 1 );
+	DbgAllocFreeCheck("<_conexio_cmm920_frame_get> Frame pool empty\n");
+	return (BYTE*)NULL;
+}
 
-	if( pFc != NULL ) *pFc = fc;
-	if( pSeq_no != NULL )	*pSeq_no = seq_no;
-	if( pDest_addr != NULL ) *pDest_addr = dest_addr;
-	if( pDest_id != NULL )	*pDest_id = dest_id;
-	if( pSrc_addr != NULL ) *pSrc_addr = src_addr;
-	if( pSrc_id != NULL ) *pSrc_id = src_id;
-
-	DbgPrint("<parseMHR> fc:%x seq_no:%d dest_id : %x src_id : %x dest_addr :%lx src_addr : %lx \n ",
-		fc, seq_no, dest_id, src_id, dest_addr, src_addr);
+/**
+	@~English
+	@brief return frame to the pool function
+	@param frame : frame buffer
+	@~Japanese
+	@brief フレームプールにフレームを返却する関数
+	@param frame : フレームバッファ
+**/
+static void _conexio_cmm920_frame_put( BYTE *frame )
+{
+	int i;
 
-	return (int)offset;
+	if( frame == (BYTE*)NULL ) return;
 
+	i = ( frame - &global_frame_pool[0][0] ) / CONEXIO_CMM920_FRAME_SIZE;
+	if( i >= 0 && i < CONEXIO_CMM920_FRAME_POOL_NUM ){
+		__sync_fetch_and_sub( &global_frame_in_use, 1 );
+		__sync_lock_release( &global_frame_used[i] );
+	}
 }
 
 /**
 	@~English
-	@brief CONEXIO 920MHz Module data send function
-	@param buf : send data buffer
-	@param size : send data size
-	@param hop : hop mode
-	@param send_mode : send mode
-	@param dest_id : dest PAN ID
-	@param src_id : source PAN ID
-	@param dest_addr : Dest Address
-	@param src_addr : Source Address
-	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
+	@brief encode frame in place function
+	@param frame : frame buffer ( data is already set after the header )
+	@param size : data size
+	@param mode : send mode
+	@param command : command
+	@return frame length
 	@~Japanese
-	@brief CONEXIO 920MHz　Module データ送信 関数
-	@param buf : 送信データバッファ
-	@param size : 送信データサイズ
-	@param hop : ホップ・モード
-	@param send_mode : 送信モード
-	@param dest_id : 送信先PAN　ID
-	@param src_id : 送信元 PAN ID
-	@param dest_addr : 送信先アドレス
-	@param src_addr : 送信元アドレス
-	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
+	@brief フレームのヘッダとフッタを書き込む関数
+	@param frame : フレームバッファ ( データはヘッダの後ろに設定済み )
+	@param size :　データサイズ
+	@param mode : 送信モード
+	@param command : コマンド
+	@return フレームサイズ
 **/
-int SendTelegram(BYTE buf[], int size, int hop, int send_mode, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr)
+static int _conexio_cmm920_frame_encode( BYTE *frame, int size, BYTE mode, BYTE command )
 {
+	BYTE sum;
+	int cnt;
 
-	BYTE*	pktBuf;
-	int pktSize;
-	int i, ret;
-	int offset = 0;
-	unsigned short fc = 0;
-	BYTE syslog_string[256];
+	/* header */
+	frame[0] = 0x10;	// DLE
+	frame[1] = 0x02;	// STX
+	frame[2] = (BYTE)((size + 5) >> 8);
+	frame[3] = (BYTE)((size + 5) % 256);
+	frame[4] = mode;
+	frame[5] = command;
+	frame[6] = 0x00;
+	frame[7] = 0x00;
 
-	if( hop == CONEXIO_CMM920_HOP_MULTI ){
-		offset = calcMHR(
-			CONEXIO_CMM920_MHR_FC_DESTADDRMODE_16BIT,
-			CONEXIO_CMM920_MHR_FC_SRCADDRMODE_16BIT,
-			0x00,
-			0x00,
-			&fc
-		);
+	/* check sum */
+	for( sum = 0, cnt = 2; cnt < size + CONEXIO_CMM920_FRAME_HEAD_SIZE; cnt++ )
+	{
+		sum += frame[cnt];
 	}
+	frame[size + CONEXIO_CMM920_FRAME_HEAD_SIZE] = (BYTE)((sum ^ 0xFF) + 1);
 
-	pktBuf = (BYTE*)malloc( (size + offset + 3) * sizeof(BYTE) );
-	pktSize = size + offset + 3;
+	/* footer */
+	frame[size + CONEXIO_CMM920_FRAME_HEAD_SIZE + 1] = 0x10;	// DLE
+	frame[size + CONEXIO_CMM920_FRAME_HEAD_SIZE + 2] = 0x03;	// ETX
 
-	switch( send_mode ){
-	case CONEXIO_CMM920_SENDDATA_MODE_NOACK_NORESP:
-	case CONEXIO_CMM920_SENDDATA_MODE_ACK_NORESP:
-	case CONEXIO_CMM920_SENDDATA_MODE_NOACK_RESP:
-	case CONEXIO_CMM920_SENDDATA_MODE_ACK_RESP:
-		break;
-	default:
-		return 0;
-	}
+	return size + CONEXIO_CMM920_FRAME_HEAD_SIZE + CONEXIO_CMM920_FRAME_FOOT_SIZE;
+}
 
+/**
+	@~English
+	@brief check received frame in place function
+	@param ctx : instance handle
+	@param frame : frame buffer
+	@param size : data size
+	@param mode : send mode
+	@param command : command
+	@return Success : 0 , Failed : Header error : 2 , packet size chack Error : 4, Packet footer error : 8, Myself command acknowledge Error : 16, Check Sum Error : 32
+	@~Japanese
+	@brief 受信フレームをチェックする関数
+	@param ctx : インスタンスハンドル
+	@param frame : フレームバッファ
+	@param size :　データサイズ
+	@param mode : 送信モード
+	@param command : コマンド
+	@return 成功:  0 失敗 :  ヘッダエラー : 2, パケットサイズチェックエラー: 4, パケットフッタエラー : 8 ,  ACK エラー :  16,  チェックサムエラー : 32
+	@par pktChkBYTEArray と同じチェックをバッファをコピーせずに行います。
+**/
+static int _conexio_cmm920_frame_check( CONEXIO920HANDLE ctx, BYTE *frame, int size, BYTE mode, BYTE command )
+{
+	BYTE sum;
+	int cnt;
+	int iRet = 0;
 
-	pktBuf[0] = send_mode;
-	pktBuf[1] = ( size + offset + 4 ) >> 8;
-	pktBuf[2] = ( size + offset + 4 ) % 256;
+	/*  Error Code */
+	ctx->getLastError = (frame[5] << 8) + frame[6];
 
-	if( hop == CONEXIO_CMM920_HOP_MULTI ){
-		addMHR(pktBuf, fc, dest_id, src_id, dest_addr, src_addr);
+	/* header Check */
+	if( frame[0] != 0x10 || frame[1] != 0x02 ){
+		DbgPrint("<_conexio_cmm920_frame_check> Header error\n");
+		iRet |= 2;
 	}
-
-	for( i = 0; i < size ; i ++ ){
-		pktBuf[3 + offset + i] = buf[i];
+	else if( size < 0 || size > CONEXIO_CMM920_FRAME_DATA_MAX ||
+			frame[2] != (BYTE)((size + 5) >> 8) ||
+			frame[3] != (BYTE)((size + 5) % 256) ){
+		DbgPrint("<_conexio_cmm920_frame_check> size check error\n");
+		iRet |= 4;
 	}
-
-	memset(&syslog_string[0], 0x00, 256);//Clear
-	sprintf(syslog_string,"[Send Teregram Application Buffer SIZE:%d] ", size);
-	for( i = 0; i < pktSize ; i ++ ){
-
-		if( (i % 65) == 0 ){ // 1行 207byte (69)以降切れるため
-			_conexio_cmm920_output_syslog_notice( syslog_string );
-			memset(&syslog_string[0], 0x00, 256 );
+	/* footer Check */
+	else if( frame[size + CONEXIO_CMM920_FRAME_HEAD_SIZE + 1] != 0x10 ||
+		frame[size + CONEXIO_CMM920_FRAME_HEAD_SIZE + 2] != 0x03 ){
+		DbgPrint("<_conexio_cmm920_frame_check> Footer Error\n");
+		iRet |= 8;
+	}else{
+		if( frame[4] != ( mode | CONEXIO_CMM920_RECVCOMMAND ) ||
+			frame[5] != command ){
+			DbgPrint("<_conexio_cmm920_frame_check> Myself command ack Error\n");
+			iRet |= 16;
 		}
 
-		sprintf(syslog_string,"%s%02X ",syslog_string, buf[i]);
-	}
-	_conexio_cmm920_output_syslog_notice( syslog_string );
-	memset(&syslog_string[0],0x00, 256); //Clear
-	for( i = 0; i < pktSize ; i ++ ){
-		if( (i % 65) == 0 && i != 0){ // 1行 207byte (69)以降切れるため
-			_conexio_cmm920_output_syslog_notice( syslog_string );
-			memset(&syslog_string[0], 0x00, 256 );
+		/* check sum Check */
+		for( sum = 0, cnt = 2; cnt < size + CONEXIO_CMM920_FRAME_HEAD_SIZE; cnt++ )
+		{
+			sum += frame[cnt];
+		}
+		if( frame[size + CONEXIO_CMM920_FRAME_HEAD_SIZE] != (BYTE)((sum ^ 0xFF) + 1) ){
+			DbgPrint("<_conexio_cmm920_frame_check> Check Sum Error\n");
+			iRet |= 32;
 		}
-		sprintf(syslog_string,"%s%02X ",syslog_string, pktBuf[i]);
 	}
-	_conexio_cmm920_output_syslog_notice( syslog_string );
 
-	sprintf(syslog_string,"[Send Teregram Packet SIZE:%d] ", pktSize);
-	for( i = 0; i < pktSize ; i ++ ){
+	return iRet;
+}
 
-		if( (i % 65) == 0 ){ // 1行 207byte (69)以降切れるため
-			_conexio_cmm920_output_syslog_notice( syslog_string );
-			memset(&syslog_string[0], 0x00, 256 );
-		}
+/**
+	@~English
+	@brief send frame function
+	@param ctx : instance handle
+	@param frame : frame buffer ( data is already set after the header )
+	@param size : data size
+	@param mode : send mode
+	@param command : command
+	@return Success : 0
+	@~Japanese
+	@brief フレームを送信する関数
+	@param ctx : インスタンスハンドル
+	@param frame : フレームバッファ ( データはヘッダの後ろに設定済み )
+	@param size :　データサイズ
+	@param mode : 送信モード
+	@param command : コマンド
+	@return 成功:  0
+	@par 複数のスレッドから同時に呼ばれてもフレームが混ざらないように、送信全体を排他します。
+**/
+static int _conexio_cmm920_send_frame( CONEXIO920HANDLE ctx, BYTE *frame, int size, BYTE mode, BYTE command )
+{
+	int length;
+	int index;
+
+	pthread_mutex_lock( &ctx->send_mutex );
+
+	length = _conexio_cmm920_frame_encode( frame, size, mode, command );
+
+	DbgPrint("Port %x, size :%d length :%d \n ",ctx->iPort, size, length);
+	if( ctx->recv_thread_active ){
+		// 受信スレッド動作中は受信データを捨てずに、このコマンドの前回の応答だけを消す
+		pthread_mutex_lock( &ctx->recv_mutex );
+		ctx->recv_ack_length[_conexio_cmm920_ack_index( mode, command )] = 0;
+		pthread_mutex_unlock( &ctx->recv_mutex );
+	}else{
+		tcflush( ctx->iPort, TCIFLUSH );
+	}
 
-		sprintf(syslog_string,"%s%02X ",syslog_string, pktBuf[i]);
+	index = _conexio_cmm920_command_index( mode, command );
+	if( index >= 0 ){
+		clock_gettime( CLOCK_MONOTONIC, &ctx->send_time[index] );
+		ctx->send_pending[index] = 1;
 	}
-	_conexio_cmm920_output_syslog_notice( syslog_string );
 
-	ret = (int)SendCommand(pktBuf, pktSize, CONEXIO_CMM920_MODE_RUN, CONEXIO_CMM920_SENDDATA);
+	Serial_PutString(ctx->iPort, frame, ( length * sizeof(BYTE) ) );
 
-	return ret;
+	ctx->stat.frames_sent++;
+	ctx->stat.bytes_sent += length;
+	if( mode == CONEXIO_CMM920_MODE_RUN && command == CONEXIO_CMM920_SENDDATA )
+		ctx->stat.telegrams_sent++;
+
+	_conexio_cmm920_trace( CONEXIO_CMM920_TRACE_DIR_SEND, frame, length );
+
+	pthread_mutex_unlock( &ctx->send_mutex );
 
+	return 0;
 }
 
 /**
 	@~English
-	@brief CONEXIO 920MHz Module data receive function
-	@param buf : receive data buffer
-	@param size : receive data size
-	@param hop : hop mode
-	@param r_channel : receive channel
-	@param rx_pwr : receive power
-	@param crc: crc value
-	@param dest_id : dest PAN ID
-	@param src_id : source PAN ID
-	@param dest_addr : Dest Address
-	@param src_addr : Source Addres
-	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
+	@brief telegram frame check function
+	@param frame : frame buffer
+	@param length : frame length
+	@return telegram : 1, other : 0
 	@~Japanese
-	@brief CONEXIO 920MHz　Module のデータ受信 関数
-	@param buf : 受信データバッファ
-	@param size : 受信データサイズ
-	@param hop : ホップ・モード
-	@param r_channel : 受信チャネル
-	@param rx_pwr : 受信強度
-	@param crc: CRC値
-	@param dest_id : 送信先PAN　ID
-	@param src_id : 送信元 PAN ID
-	@param dest_addr : 送信先アドレス
-	@param src_addr : 送信元アドレス
-	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
+	@brief 受信フレームが無線の受信データか判定する関数
+	@param frame : フレームバッファ
+	@param length : フレームサイズ
+	@return 受信データ : 1, それ以外 : 0
 **/
-int RecvTelegram(BYTE buf[], int *size , int hop, int *r_channel, int *rx_pwr, unsigned int *crc ,unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr)
+static int _conexio_cmm920_is_telegram( BYTE *frame, int length )
 {
-	int iRet = 0;	
-	int offset = 0;
-	int i;
-	int iSize = 0;
+	BYTE *data = &frame[CONEXIO_CMM920_FRAME_HEAD_SIZE];
+	int d_size = length - CONEXIO_CMM920_FRAME_HEAD_SIZE - CONEXIO_CMM920_FRAME_FOOT_SIZE;
 
+	if( frame[4] != ( CONEXIO_CMM920_MODE_RUN | CONEXIO_CMM920_RECVCOMMAND ) ||
+		frame[5] != CONEXIO_CMM920_SENDDATA ) return 0;
 
-	if( hop == CONEXIO_CMM920_HOP_SINGLE )	return RecvTelegramSingleHop(buf, size, r_channel, rx_pwr, crc);
+	// recv enable + rx_channel + rx_power + phr(2byte) + data
+	if( d_size < 5 || data[0] != 0x01 ) return 0;
+	if( 5 + data[3] * 256 + data[4] > d_size ) return 0;
 
-	iRet = RecvTelegramSingleHop(buf, &iSize, r_channel, rx_pwr, crc);
+	return 1;
+}
 
-	if( iRet == 0 ){
-		if( iSize > 0 ){
-			offset = parseMHR(	 buf, NULL, NULL, dest_id, src_id, dest_addr, src_addr );
-			if( offset >= 0 ){
-				for( i = offset; i < iSize; i ++ ){
-					buf[i - offset] = buf[i];
-					DbgPrint("%x", buf[i - offset]);
-				}
-				DbgPrint(":Length %d\n", iSize - offset );
-				memset( &buf[iSize - offset], 0x00, offset );
-				if( size != NULL )	*size = iSize - offset;
-			}
-		}else{
-			if( size != NULL )	*size = 0;
+/**
+	@~English
+	@brief CRC-32 table initialize function
+	@~Japanese
+	@brief CRC-32 のテーブルを作成する関数
+**/
+static void _conexio_cmm920_crc_table_init( void )
+{
+	unsigned int crc;
+	int i, j;
+
+	for( i = 0; i < 256; i++ ){
+		crc = i;
+		for( j = 0; j < 8; j++ )
+			crc = ( crc >> 1 ) ^ ( ( crc & 1 ) ? CONEXIO_CMM920_CRC_POLY : 0 );
+		global_crc_table[0][i] = crc;
+	}
+	for( i = 0; i < 256; i++ ){
+		crc = global_crc_table[0][i];
+		for( j = 1; j < 8; j++ ){
+			crc = global_crc_table[0][crc & 0xFF] ^ ( crc >> 8 );
+			global_crc_table[j][i] = crc;
 		}
 	}
+}
 
+/**
+	@~English
+	@brief CONEXIO 920MHz Module CRC-32 calculate function
+	@param crc : previous CRC value ( 0 : first call )
+	@param buf : data buffer
+	@param size : data size
+	@return CRC value
+	@~Japanese
+	@brief CRC-32 を計算する関数
+	@param crc : 前回の CRC値 ( 0 : 最初の呼び出し )
+	@param buf : データバッファ
+	@param size : データサイズ
+	@return CRC値
+	@par IEEE 802.15.4g の 32bit FCS と同じ CRC-32 ( 初期値 0xFFFFFFFF, 結果を反転 ) を 8 バイトずつ計算します。
+	@par 分割したデータは、前回の戻り値を crc に渡して続けて計算できます。
+**/
+unsigned int conexio_cmm920_crc32( unsigned int crc, const BYTE buf[], int size )
+{
+	unsigned int lo, hi;
+
+	pthread_once( &global_crc_once, _conexio_cmm920_crc_table_init );
+
+	crc = ~crc;
+	for( ; size >= 8; size -= 8, buf += 8 ){
+		lo = crc ^ ( buf[0] | ( buf[1] << 8 ) | ( buf[2] << 16 ) | ( (unsigned int)buf[3] << 24 ) );
+		hi = buf[4] | ( buf[5] << 8 ) | ( buf[6] << 16 ) | ( (unsigned int)buf[7] << 24 );
+		crc = global_crc_table[7][lo & 0xFF] ^ global_crc_table[6][( lo >> 8 ) & 0xFF] ^
+			global_crc_table[5][( lo >> 16 ) & 0xFF] ^ global_crc_table[4][lo >> 24] ^
+			global_crc_table[3][hi & 0xFF] ^ global_crc_table[2][( hi >> 8 ) & 0xFF] ^
+			global_crc_table[1][( hi >> 16 ) & 0xFF] ^ global_crc_table[0][hi >> 24];
+	}
+	for( ; size > 0; size--, buf++ )
+		crc = global_crc_table[0][( crc ^ *buf ) & 0xFF] ^ ( crc >> 8 );
 
-	return iRet;
-
+	return ~crc;
 }
 
-
 /**
 	@~English
-	@brief CONEXIO 920MHz Module data receive with single hop function
-	@param buf : receive data buffer
-	@param size : receive data size
-	@param r_channel : receive channel
-	@param rx_pwr : receive power
-	@param crc: crc value
-	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
+	@brief telegram CRC check function
+	@param ctx : instance handle
+	@param frame : frame buffer
+	@param length : frame length
+	@return OK ( or check is off ) : 0, CRC error : -1
 	@~Japanese
-	@brief CONEXIO 920MHz　Module のシングルホップ用データ受信 関数
-	@param buf : 受信データバッファ
-	@param size : 受信データサイズ
-	@param r_channel : 受信チャネル
-	@param rx_pwr : 受信強度
-	@param crc: CRC値
-	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
+	@brief 受信データの CRC をチェックする関数
+	@param ctx : インスタンスハンドル
+	@param frame : フレームバッファ
+	@param length : フレームサイズ
+	@return 正常 ( またはチェックなし ) : 0, CRC エラー : -1
+	@par FCS はリトルエンディアンで、CRC値計算反転が無効の場合は反転前の値と比較します。
 **/
-int RecvTelegramSingleHop(BYTE buf[], int *size , int *r_channel, int *rx_pwr , unsigned int *crc )
+static int _conexio_cmm920_crc_check( CONEXIO920HANDLE ctx, BYTE *frame, int length )
 {
+	BYTE *data = &frame[CONEXIO_CMM920_FRAME_HEAD_SIZE];
+	BYTE *fcs;
+	int d_size;
+	unsigned int crc;
 
-	BYTE*	pktBuf;
-	int pktSize;
-	int i, ret, d_size, crc_size;
-	int iRet;
-	int head_size = 5; //recv enable/disable + rx_channel + rx_power + phr(2byte)
-	int foot_size;
-
-	crc_size = 32;// crc ( bit length )
-	foot_size = 2 + (crc_size / 8); // crc + rssi + ant
-	if( size != NULL && *size != 0 ){
-		pktSize = *size + head_size + foot_size;
-		pktBuf = (BYTE*)malloc( pktSize * sizeof(BYTE) );
-		memset(pktBuf, 0, ( pktSize * sizeof(BYTE) ));	// 2016.01.08 (2)
-	}else{
-		pktSize = 0;
-		pktBuf = (BYTE*)malloc( ( 512 + head_size + foot_size ) * sizeof(BYTE) );
-		memset(pktBuf, 0, ( 512 + head_size + foot_size ) * sizeof(BYTE) ); // 2016.01.08 (2)	
-	}
-	// Data Received
-	iRet = RecvCommandAck(pktBuf, &pktSize, CONEXIO_CMM920_MODE_RUN, CONEXIO_CMM920_SENDDATA);
+	if( ctx->crc_check == CONEXIO_CMM920_CRC_CHECK_OFF ) return 0;
+	if( !_conexio_cmm920_is_telegram( frame, length ) ) return 0;
 
-	if( iRet ){
-		free(pktBuf); // 2016.01.08 (1)
-		return iRet;
+	d_size = data[3] * 256 + data[4] - CONEXIO_CMM920_CRC_SIZE;
+	if( d_size < 0 ){
+		ctx->stat.crc_errors++;
+		return -1;
 	}
 
+	crc = conexio_cmm920_crc32( 0, &data[5], d_size );
+	if( !ctx->crc_inverse ) crc = ~crc;
 
-	if( pktSize > 0 ){
-		if( pktBuf[0] == 0x01 ){
-			
-			if( pktSize >= 3 )	DbgRecvTelegramParam("pktBuf[2] = 0x%x\n", pktBuf[2]);
-
-			if( r_channel != NULL )
-				*r_channel = _calc_Hex2Bcd(pktBuf[1]);
-			if( rx_pwr != NULL ){
-				*rx_pwr = _conexio_cmm920_Hex2dBm(pktBuf[2]);
-				DbgRecvTelegramParam("*rx_pwr = 0x%x\n", *rx_pwr);
-			}
-			d_size = pktBuf[3] * 256 + pktBuf[4];
-
-			if( buf != NULL ){
-				if( d_size < pktSize ){ 
-					for( i = 0; i < d_size - (crc_size / 8) ; i ++ ){
-						buf[i] = pktBuf[head_size + i];
-					}
-				}
-			}
-			//crc, rx_rssi, rx_ant
-		
-			if( size != NULL ) *size = d_size; // 2016.01.08 (3)
-			// 2016.01.11 (3) start
-			if( crc != NULL ){
-				for( i = 0, *crc = 0; i < (crc_size / 8); i ++)
-					*crc |= (*crc << 8) | pktBuf[head_size + d_size - (crc_size / 8) + i];
-			}
-			// 2016.01.11 (3) end
-		}
+	fcs = &data[5 + d_size];
+	if( crc != ( fcs[0] | ( fcs[1] << 8 ) | ( fcs[2] << 16 ) | ( (unsigned int)fcs[3] << 24 ) ) ){
+		DbgPrint("<_conexio_cmm920_crc_check> CRC Error\n");
+		ctx->stat.crc_errors++;
+		return -1;
 	}
-	
-	free(pktBuf);// 2016.01.08 (1)
+
 	return 0;
 }
 
-// Send Command CMM920
 /**
 	@~English
-	@brief CONEXIO 920MHz Module command send function
-	@param buf : send data buffer
-	@param size : send data size
-	@param mode : send mode
-	@param command : command
-	@return Success : 0 , Failed : Packet memory allocation error : -1, Data memory allocation error : -2
+	@brief read frame function
+	@param ctx : instance handle
+	@param frame : frame buffer
+	@param length : frame length
+	@param deadline : absolute deadline ( CLOCK_MONOTONIC )
+	@return Success : 0 , Failed : Data size error ( or no data until the deadline ) : -2, Timeout : -7
 	@~Japanese
-	@brief CONEXIO 920MHz　Module のコマンドデータ受信 関数
-	@param buf : 送信データバッファ
-	@param size : 送信データサイズ
-	@param mode : 送信モード
-	@param command : コマンド
-	@return 成功:  0 失敗 :  パケットメモリ確保エラー:  -1, データメモリ確保エラー : -2
+	@brief フレームを読み込む関数
+	@param ctx : インスタンスハンドル
+	@param frame : フレームバッファ
+	@param length : フレームサイズ
+	@param deadline : 期限 ( CLOCK_MONOTONIC )
+	@return 成功:  0 失敗 :  データサイズエラー ( 期限までにデータなし ) : -2, タイムアウト : -7
+	@par DLE STX までのデータは読み飛ばします。
 **/
-int SendCommand(BYTE buf[], int size, BYTE mode, BYTE command )
+static int _conexio_cmm920_read_frame( CONEXIO920HANDLE ctx, BYTE *frame, int *length, struct timespec *deadline )
 {
-	BYTE *array;
-	int length = 0;
-	int i;
-	PCONEXIO920PACKET pac;
-	BYTE syslog_string[256];
-
-	memset(&syslog_string[0], 0x00, 256 );
-
-	pac = allocConexioCMM920_packet(pac, mode, command, 1);
-
-	if(pac == NULL) return -1;
-	pac->data = (BYTE*)malloc(sizeof(BYTE) * size);
-	if(pac->data == NULL)
-	{
-		printf("Memory allocation error\n");
-		free(pac);
-		return -2;
-	}else{
-		DbgAllocFreeCheck("<SendCommand> Alloc PAC data\n");
-
-		for (i = 0; i < size; i++)
-		{
-			pac->data[i] = buf[i];
+	int sync = 0;
+	int d_size;
+	int readlen;
+	struct timespec body_deadline;
+
+	// DLE STX の検出
+	while( sync < 2 ){
+		readlen = _conexio_cmm920_read_deadline( ctx, &frame[sync], 1, deadline );
+		if( readlen < 1 ){
+			return ( sync == 0 ) ? -2 : -7;
+		}
+		if( sync == 0 ){
+			if( frame[0] == 0x10 ) sync = 1;
+		}else{
+			if( frame[1] == 0x02 ) sync = 2;
+			else if( frame[1] != 0x10 ) sync = 0;
 		}
 	}
 
-	array = pktGetBYTEArray( pac, size , &length);
-	//length = pktGetLength(size);
-
-	DbgPrint("Port %x, size :%d length :%d \n ",iPort, size, length);
-	tcflush( iPort, TCIFLUSH );
-	Serial_PutString(iPort, array, ( length * sizeof(BYTE) ) );
-
-	DbgPrint("Send Data = ");
+	//size get
+	readlen = _conexio_cmm920_read_deadline( ctx, &frame[2], 2, deadline );
+	if( readlen < 2 ){
+		DbgPrint("<_conexio_cmm920_read_frame> TimeOut Receive Error.( header )\n");
+		return -7;
+	}
 
-	sprintf(syslog_string,"[Sending Data] ");
+	d_size = (frame[2] * 256 + frame[3]);
+	if( d_size < 5 || d_size > CONEXIO_CMM920_FRAME_DATA_MAX ){
+		ctx->stat.frame_errors++;
+		if (d_size < 5 )
+			DbgDataLength("<_conexio_cmm920_read_frame> Non Data Length \n");
+		else
+			DbgDataLength("<_conexio_cmm920_read_frame> Over Data Length \n");
+		return -2;
+	}
+	d_size -= 5; // ヘッダサイズを引いて実データサイズを求める
+	*length = d_size + CONEXIO_CMM920_FRAME_HEAD_SIZE + CONEXIO_CMM920_FRAME_FOOT_SIZE;
 
-	for (i = 0; i < length; i++)
-	{
+	// Get Data (without header)
+	// ヘッダ受信後は残りを受信する時間を最低限確保する
+	clock_gettime( CLOCK_MONOTONIC, &body_deadline );
+	_conexio_cmm920_add_msec( &body_deadline, CONEXIO_CMM920_BODY_TIMEOUT_MSEC );
+	if( _conexio_cmm920_diff_usec( deadline, &body_deadline ) < 0 )
+		body_deadline = *deadline;
 
-		if( (i % 65) == 0 ){ // 1行 207byte (69)以降切れるため
-			_conexio_cmm920_output_syslog_notice( syslog_string );
-			memset(&syslog_string[0], 0x00, 256 );
-		}
+	readlen = _conexio_cmm920_read_deadline( ctx, &frame[4], *length - 4, &body_deadline );
 
-		sprintf(syslog_string,"%s%02X ",syslog_string, array[i]);
-		DbgPrint("%02X", array[i]);
+	DbgPrint("Recvlen = %d\n", readlen);
 
+	if( readlen < (*length - 4) ){
+		DbgPrint("<_conexio_cmm920_read_frame> TimeOut Receive Error.\n");
+		ctx->stat.frame_errors++;
+		return -7;
 	}
 
-	DbgPrint("\n");
-
-	_conexio_cmm920_output_syslog_notice( syslog_string );
+	ctx->stat.frames_recv++;
+	ctx->stat.bytes_recv += *length;
+	if( _conexio_cmm920_is_telegram( frame, *length ) )
+		ctx->stat.telegrams_recv++;
 
-	// mallocで取得したメモリを解放する
-	free(array);
 	return 0;
 }
 
 /**
 	@~English
-	@brief CONEXIO 920MHz Module Receive Packet Check Function
-	@param pac : Receive CONEXIO Packet structure
-	@param array : Receive Data Array
-	@param size : Receive Data Array Size
-	@return Success : 0 , Failed : memory allocation error : 1, Header error : 2 , packet size chack Error : 4, Packet footer error : 8, Myself command acknowledge Error : 16, Check Sum Error : 32
+	@brief wait frame from the receive thread function
+	@param ctx : instance handle
+	@param frame : frame buffer
+	@param length : frame length
+	@param mode : Send Mode
+	@param command : Send Command
+	@param deadline : absolute deadline ( CLOCK_MONOTONIC )
+	@return Success : 0 , Failed : no data until the deadline : -2
 	@~Japanese
-	@brief CONEXIO 920MHz　Module の受信パケットのチェック 関数
-	@param pac : 受信パケットバッファ
-	@param array : 受信データ
-	@param size : 受信データサイズ
-	@return 成功:  0 失敗 :  メモリ確保エラー:  1, ヘッダエラー : 2, パケットサイズチェックエラー: 4, パケットフッタエラー : 8 ,  ACK エラー :  16,  チェックサムエラー : 32
+	@brief 受信スレッドからフレームを受け取る関数
+	@param ctx : インスタンスハンドル
+	@param frame : フレームバッファ
+	@param length : フレームサイズ
+	@param mode :　送信モード
+	@param command : 送信コマンド
+	@param deadline : 期限 ( CLOCK_MONOTONIC )
+	@return 成功:  0 失敗 :  期限までにデータなし : -2
+	@par データ送信コマンドの場合は受信データのキューから、それ以外はコマンドの応答を受け取ります。
 **/
-int pktChkBYTEArray(PCONEXIO920PACKET pac, BYTE *array, int size )
+static int _conexio_cmm920_wait_frame( CONEXIO920HANDLE ctx, BYTE *frame, int *length, BYTE mode, BYTE command, struct timespec *deadline )
 {
-	long cnt;
-	int HeadSize, FootSize, pktSizeOffset;
-	int iRet = 0;
-
-	HeadSize = 8;	//header size 8byte
-	FootSize = 3; //footer size 3byte
-	pktSizeOffset = 5;
+	unsigned int head;
+	int slot;
+	int iRet = -2;
 
-	if(array == NULL)
-	{
-		DbgPrint("<pktChkBYTEArray> Memory allocation error\n");
-		return 1;
-	}
-
-	/*  Error Code */
-	global_getLastError = (array[5] << 8) + array[6];
+	pthread_mutex_lock( &ctx->recv_mutex );
 
-	/* header Check */
-	if( array[0] != pac->dle || 
-		array[1] != pac->stx ){
-		DbgPrint("<pktChkBYTEArray> Header error\n");
-		iRet |= 2;
-	}
-	else	if( array[2] != (BYTE)((size + pktSizeOffset) >> 8) ||
-				array[3] != (BYTE)((size + pktSizeOffset) % 256) ){
-			DbgPrint("<pktChkBYTEArray> size check error\n");
-			iRet |= 4;
-	}
-	/* footer Check */
-	else if( array[size + HeadSize + 1] != pac->dle ||
-		array[size + HeadSize + 2] != pac->etx
-	){
-		DbgPrint("<pktChkBYTEArray> Footer Error (%x), (%x) \n", array[size + HeadSize + 1], array[size + HeadSize + 2]);
-		iRet |= 8;
-	}else{
-		if( array[4] != ( pac->command[0] | CONEXIO_CMM920_RECVCOMMAND ) ||
-				array[5] != pac->command[1]
-		){
-			DbgPrint("<pktChkBYTEArray> Myself command ack Error\n");
-			iRet |= 16;
-			if( array[4] == CONEXIO_CMM920_RECVCOMMAND && 
-				array[5] == 0xFF )
-			{
-				DbgPrint("<pktChkBYTEArray> unusual Command \n");
-			} 
+	if( mode == CONEXIO_CMM920_MODE_RUN && command == CONEXIO_CMM920_SENDDATA ){
+		while( ctx->recv_queue_head == ctx->recv_queue_tail ){
+			if( pthread_cond_timedwait( &ctx->recv_cond, &ctx->recv_mutex, deadline ) == ETIMEDOUT ) break;
 		}
-
-		/* check sum Check */
-		for(pac->sum = 0, cnt = 2; cnt < size + HeadSize; cnt++)
-		{
-			pac->sum += array[cnt];
+		head = ctx->recv_queue_head;
+		if( head != ctx->recv_queue_tail ){
+			__sync_synchronize();
+			*length = ctx->recv_queue_length[head & ( CONEXIO_CMM920_RECV_QUEUE_NUM - 1 )];
+			memcpy( frame, ctx->recv_queue[head & ( CONEXIO_CMM920_RECV_QUEUE_NUM - 1 )], *length );
+			__sync_synchronize();
+			ctx->recv_queue_head = head + 1;
+			iRet = 0;
 		}
-		if( array[size + HeadSize] != (BYTE)((pac->sum ^ 0xFF) + 1) ){
-			DbgPrint("<pktChkBYTEArray> Check Sum Error\n");
-			iRet |= 32;
+	}else{
+		slot = _conexio_cmm920_ack_index( mode, command );
+		while( ctx->recv_ack_length[slot] == 0 ||
+			ctx->recv_ack_frame[slot][4] != ( mode | CONEXIO_CMM920_RECVCOMMAND ) ||
+			ctx->recv_ack_frame[slot][5] != command ){
+			if( pthread_cond_timedwait( &ctx->recv_cond, &ctx->recv_mutex, deadline ) == ETIMEDOUT ) break;
 		}
-
-		for (cnt = 0; cnt < size; cnt ++)
-		{
-			pac->data[cnt] = array[cnt + HeadSize];
+		if( ctx->recv_ack_length[slot] != 0 &&
+			ctx->recv_ack_frame[slot][4] == ( mode | CONEXIO_CMM920_RECVCOMMAND ) &&
+			ctx->recv_ack_frame[slot][5] == command ){
+			*length = ctx->recv_ack_length[slot];
+			memcpy( frame, ctx->recv_ack_frame[slot], *length );
+			ctx->recv_ack_length[slot] = 0;
+			iRet = 0;
 		}
 	}
 
+	pthread_mutex_unlock( &ctx->recv_mutex );
+
 	return iRet;
 }
 
 /**
 	@~English
-	@brief CONEXIO 920MHz Module Receive Packet acknowledge Function
-	@param buf : Data Buffer
-	@param size : Data Size
+	@brief receive frame function
+	@param ctx : instance handle
+	@param frame : frame buffer
+	@param size : data size ( input : expected size ( 0 : any ) , output : received size )
 	@param mode : Send Mode ( Analyze Packet Check )
 	@param command : Send Command  ( Analyze Packet Check )
-	@return Success : 0 , Failed : Packet memory allocation error : -1, Data memory allocation error : -3, Analyze Packet memory allocation error : -4, Analyze Data memory allocation error : -5, Receive Packet Check Error : -6
+	@return Success : 0 , Failed : Data size error ( or no data until the deadline ) : -2, Receive Packet Check Error : -6, Timeout : -7
 	@~Japanese
-	@brief CONEXIO 920MHz　Module の受信パケットのチェック 関数
-	@param buf : 受信データバッファ
-	@param size : 受信データサイズ
+	@brief フレームを受信する関数
+	@param ctx : インスタンスハンドル
+	@param frame : フレームバッファ
+	@param size : データサイズ ( 入力 : 期待するサイズ ( 0 : 指定なし ), 出力 : 受信サイズ )
 	@param mode :　送信モード  ( パケット解析チェック用 )
 	@param command : 送信コマンド ( パケット解析チェック用 )
-	@return 成功:  0 失敗 :  パケットメモリ確保エラー:  -1, データサイズエラー : -2, データメモリ確保エラー : -3,  解析用パケットメモリ確保エラー:  -4,  解析用データメモリ確保エラー : -5,  受信パケットチェックエラー : -6
+	@return 成功:  0 失敗 :  データサイズエラー ( 期限までにデータなし ) : -2, 受信パケットチェックエラー : -6, タイムアウト : -7
+	@par 受信データはフレームバッファのヘッダの後ろに格納されます。
+	@par 受信スレッド動作中はスレッドが受信したフレームを受け取ります。
 **/
-int RecvCommandAck( BYTE *buf, int *size , BYTE mode, BYTE command )
+static int _conexio_cmm920_recv_frame( CONEXIO920HANDLE ctx, BYTE *frame, int *size, BYTE mode, BYTE command )
 {
-
-	BYTE *array;
-	BYTE head_data[4] = {0};
 	int length = 0;
-	int i;
 	int iRet = 0;
 	int d_size = 0;
-	int readlen = 0;	// 2016.07.20
-	int timeout	 = 1;	// 2016.07.29
-	PCONEXIO920PACKET pac;
-	BYTE syslog_string[256];
+	int index;
+	long timeout_usec;
+	struct timespec deadline;
 
-	memset(&syslog_string[0], 0x00, 256 );
+	// 期限の計算 ( 送信済みなら送信時刻から、そうでなければ現在時刻から )
+	index = _conexio_cmm920_command_index( mode, command );
 
-	pac = allocConexioCMM920_packet(pac, 0, 0, 0);
-	if(pac == NULL){
-		DbgPrint("<RecvCommandAck> Memory Null Allocate.\n");
-		return -1;
+	if( index >= 0 && ctx->send_pending[index] ){
+		deadline = ctx->send_time[index];
+		timeout_usec = _conexio_cmm920_wait_deadline( ctx, index );
+	}else{
+		clock_gettime( CLOCK_MONOTONIC, &deadline );
+		timeout_usec = CONEXIO_CMM920_DEFAULT_TIMEOUT_MSEC * 1000L;
+		if( index >= 0 && ctx->timeout_msec[index] > 0 )
+			timeout_usec = ctx->timeout_msec[index] * 1000L;
 	}
-	
-	memset(head_data, 0, sizeof( BYTE ) * 4 ); // 2016.01.08 (2)
+	_conexio_cmm920_add_msec( &deadline, timeout_usec / 1000 );
 
-	//size get
-	Serial_GetString(iPort, &head_data[0], 4 * sizeof(BYTE));
+	memset(frame, 0, sizeof( BYTE ) * 4 ); // 2016.01.08 (2)
 
-	d_size = (head_data[2] * 256 + head_data[3]);
-	if( d_size < 5 || d_size > 512 ){
-		if (d_size < 5 )
-			DbgDataLength("<RecvCommandAck> Non Data Length \n");
-		else if( d_size > 512 )
-			DbgDataLength("<RecvCommandAck> Over Data Length \n");
+	if( ctx->recv_thread_active ){
+		iRet = _conexio_cmm920_wait_frame( ctx, frame, &length, mode, command, &deadline );
+	}else{
+		iRet = _conexio_cmm920_read_frame( ctx, frame, &length, &deadline );
+		if( iRet == 0 )
+			_conexio_cmm920_trace( CONEXIO_CMM920_TRACE_DIR_RECV, frame, length );
+	}
 
-		freeConexioCMM920_packet(pac);// 2016.01.08 (1)
-//		free(pac);
-		return -2;
+	if( iRet ){
+		if( index >= 0 && ctx->send_pending[index] ){
+			ctx->rtt[index].timeout++;
+			ctx->stat.timeouts++;
+			_conexio_cmm920_wait_learn( ctx, index, -1 );
+			ctx->send_pending[index] = 0;
+		}
+		return iRet;
 	}
-	d_size -= 5; // ヘッダサイズを引いて実データサイズを求める
-	pac->data = (BYTE*)malloc(sizeof(BYTE) * (d_size) );
-	if(pac->data == NULL)
-	{
-		DbgPrint("<RecvCommandAck> Memory allocation error\n");
-		freeConexioCMM920_packet(pac);// 2016.01.08 (1)
-//		free(pac);
-		return -3;
+	d_size = length - CONEXIO_CMM920_FRAME_HEAD_SIZE - CONEXIO_CMM920_FRAME_FOOT_SIZE;
+
+	// 往復時間の記録
+	if( index >= 0 && ctx->send_pending[index] ){
+		struct timespec now;
+		long rtt;
+
+		clock_gettime( CLOCK_MONOTONIC, &now );
+		rtt = _conexio_cmm920_diff_usec( &ctx->send_time[index], &now );
+
+		ctx->rtt[index].last = rtt;
+		if( ctx->rtt[index].count == 0 || rtt < ctx->rtt[index].min )
+			ctx->rtt[index].min = rtt;
+		if( rtt > ctx->rtt[index].max )
+			ctx->rtt[index].max = rtt;
+		ctx->rtt[index].total += rtt;
+		ctx->rtt[index].count++;
+		_conexio_cmm920_wait_learn( ctx, index, rtt );
+		ctx->send_pending[index] = 0;
 	}
-	DbgAllocFreeCheck("<RecvCommandAck> Alloc PAC data\n");
-
-	array = pktGetBYTEArray(pac, d_size, &length);
-	//length = pktGetLength(size);
 
-	for( i = 0; i < 4 ; i ++)
-		array[i] = head_data[i];
+	if( (size != NULL) && (*size != 0) ){
+		iRet = _conexio_cmm920_frame_check( ctx, frame, *size, mode, command );
+	}else{
+		iRet = _conexio_cmm920_frame_check( ctx, frame, d_size, mode, command );
+	}
+	if( iRet ){
+		DbgPrint("<_conexio_cmm920_recv_frame> pkt Chk Error : %x\n", iRet );
+		if( iRet & ( 2 | 8 | 32 ) ) ctx->stat.frame_errors++;
+		return -6;
+	}
 
-	// Get Data (without header)
-	for( i = 0; i < 10; i++ ){
-		int nRead = Serial_GetString(iPort, &array[4 + readlen], (length - 4 - readlen) * sizeof(BYTE));
+	if(size != NULL)	*size = d_size;
 
-		if(nRead > 0){
-			readlen += nRead;
-		}
+	return 0;
+}
+
+/**
+	@~English
+	@brief get transmit queue statistics of destination function
+	@param ctx : instance handle
+	@param dest_addr : dest address
+	@return Success : statistics , Failed : NULL ( table full )
+	@~Japanese
+	@brief 送信キューの送信先ごとの統計を取得する関数
+	@param ctx : インスタンスハンドル
+	@param dest_addr : 送信先アドレス
+	@return 成功:  統計  失敗 :  NULL ( テーブルに空きなし )
+	@par ctx->txq_mutex をロックして呼び出してください。
+**/
+static PCONEXIO920TXQSTAT _conexio_cmm920_txq_stat( CONEXIO920HANDLE ctx, long dest_addr )
+{
+	int i;
+
+	for( i = 0; i < ctx->txq_stat_num; i++ ){
+		if( ctx->txq_stat[i].dest_addr == dest_addr ) return &ctx->txq_stat[i];
+	}
+	if( ctx->txq_stat_num >= CONEXIO_CMM920_TXQ_DEST_NUM ) return NULL;
 
-		DbgPrint("Recvlen = %d\n", readlen);
+	memset( &ctx->txq_stat[ctx->txq_stat_num], 0, sizeof(CONEXIO920TXQSTAT) );
+	ctx->txq_stat[ctx->txq_stat_num].dest_addr = dest_addr;
+	return &ctx->txq_stat[ctx->txq_stat_num++];
+}
 
-		if( readlen >= (length - 4) ){
-			timeout = 0;
-			break;
+/**
+	@~English
+	@brief get link table entry of node function
+	@param ctx : instance handle
+	@param addr : node address
+	@return link table entry
+	@~Japanese
+	@brief リンク表の通信相手のエントリを取得する関数
+	@param ctx : インスタンスハンドル
+	@param addr : 通信相手のアドレス
+	@return リンク表のエントリ
+	@par 表に空きがない場合は、最も長く使われていないエントリを再利用します。
+	@par ctx->link_mutex をロックして呼び出してください。
+**/
+static PCONEXIO920LINK _conexio_cmm920_link( CONEXIO920HANDLE ctx, long addr )
+{
+	int i, old = 0;
+
+	for( i = 0; i < ctx->link_num; i++ ){
+		if( ctx->link[i].addr == addr ){
+			ctx->link_used[i] = ctx->link_order++;
+			return &ctx->link[i];
 		}
-		usleep( 100 * 1000 );
+		if( ctx->link_used[i] < ctx->link_used[old] ) old = i;
 	}
-	
-	if( timeout ){
-		DbgPrint("<RecvCommandAck> TimeOut Receive Error.\n");
-		free(array);
-		return -7;
+	if( ctx->link_num < CONEXIO_CMM920_LINK_NUM ) old = ctx->link_num++;
+
+	memset( &ctx->link[old], 0, sizeof(CONEXIO920LINK) );
+	ctx->link[old].addr = addr;
+	ctx->link[old].retry = ctx->txq_retry;
+	ctx->link[old].timeout = ctx->txq_timeout_msec * 1000L;
+	ctx->link_used[old] = ctx->link_order++;
+	return &ctx->link[old];
+}
+
+/**
+	@~English
+	@brief update adaptive retry count and timeout of node function
+	@param ctx : instance handle
+	@param link : link table entry
+	@~Japanese
+	@brief 通信相手の再送回数と応答待ち時間を更新する関数
+	@param ctx : インスタンスハンドル
+	@param link : リンク表のエントリ
+	@par 再送回数は、全ての再送が失われる確率が CONEXIO_CMM920_LINK_TARGET_LOSS 以下になる回数です。
+	@par 応答待ち時間は 平均往復時間 + 偏差 * 4 で、 txq_start のタイムアウト時間を上限とします。
+**/
+static void _conexio_cmm920_link_adapt( CONEXIO920HANDLE ctx, PCONEXIO920LINK link )
+{
+	long loss = 1000;
+	int retry = -1;
+
+	if( link->sent < CONEXIO_CMM920_LINK_LEARN_NUM ){
+		link->retry = ctx->txq_retry;
+		link->timeout = ctx->txq_timeout_msec * 1000L;
+		return;
+	}
+
+	while( loss > CONEXIO_CMM920_LINK_TARGET_LOSS && retry < CONEXIO_CMM920_LINK_RETRY_MAX ){
+		loss = loss * link->loss_rate / 1000;
+		retry++;
+	}
+	if( retry < CONEXIO_CMM920_LINK_RETRY_MIN ) retry = CONEXIO_CMM920_LINK_RETRY_MIN;
+	link->retry = retry;
+
+	if( link->rtt_samples > 0 ){
+		link->timeout = link->rtt_avg + link->rtt_dev * 4;
+		if( link->timeout < CONEXIO_CMM920_LINK_TIMEOUT_MIN_MSEC * 1000L )
+			link->timeout = CONEXIO_CMM920_LINK_TIMEOUT_MIN_MSEC * 1000L;
+		if( link->timeout > ctx->txq_timeout_msec * 1000L )
+			link->timeout = ctx->txq_timeout_msec * 1000L;
 	}
+}
+
+/**
+	@~English
+	@brief record received telegram of node function
+	@param ctx : instance handle
+	@param addr : source address
+	@param channel : receive channel
+	@param rssi : receive power (dBm)
+	@~Japanese
+	@brief 通信相手からの受信を記録する関数
+	@param ctx : インスタンスハンドル
+	@param addr : 送信元アドレス
+	@param channel : 受信チャネル
+	@param rssi : 受信強度 (dBm)
+**/
+static void _conexio_cmm920_link_recv( CONEXIO920HANDLE ctx, long addr, int channel, int rssi )
+{
+	PCONEXIO920LINK link;
 
-	DbgPrint("Recv Data = ");
+	pthread_mutex_lock( &ctx->link_mutex );
 
-	sprintf(syslog_string,"[Receive Data] ");
-	for (i = 0; i < length; i++)
-	{
+	link = _conexio_cmm920_link( ctx, addr );
+	link->channel = channel;
+	link->rssi_last = rssi;
+	if( link->recv == 0 ) link->rssi_avg = rssi * 10;
+	else link->rssi_avg += ( rssi * 10 - link->rssi_avg ) / 8;
+	link->recv++;
 
-		if( (i % 65) == 0 ){ // 1行 207byte (69)以降切れるため
-			_conexio_cmm920_output_syslog_notice( syslog_string );
-			memset(&syslog_string[0], 0x00, 256 );
-		}
+	pthread_mutex_unlock( &ctx->link_mutex );
+}
+
+/**
+	@~English
+	@brief record send result of node function
+	@param ctx : instance handle
+	@param addr : dest address
+	@param rtt : round trip time (usec) ( -1 : no response )
+	@~Japanese
+	@brief 通信相手への送信結果を記録する関数
+	@param ctx : インスタンスハンドル
+	@param addr : 送信先アドレス
+	@param rtt : 往復時間 (usec) ( -1 : 応答なし )
+**/
+static void _conexio_cmm920_link_result( CONEXIO920HANDLE ctx, long addr, long rtt )
+{
+	PCONEXIO920LINK link;
+	long err;
 
-		sprintf(syslog_string,"%s%02X ",syslog_string, array[i]);
-		DbgPrint("%02X", array[i]);
+	pthread_mutex_lock( &ctx->link_mutex );
+
+	link = _conexio_cmm920_link( ctx, addr );
+	link->sent++;
+	if( rtt < 0 ){
+		link->lost++;
+		link->loss_rate += ( 1000 - link->loss_rate ) / 8;
+	}else{
+		link->loss_rate -= link->loss_rate / 8;
+		if( link->rtt_samples == 0 ){
+			link->rtt_avg = rtt;
+			link->rtt_dev = rtt / 2;
+		}else{
+			err = rtt - link->rtt_avg;
+			link->rtt_avg += err / 8;
+			link->rtt_dev += ( ( err < 0 ? -err : err ) - link->rtt_dev ) / 4;
+		}
+		link->rtt_samples++;
 	}
+	_conexio_cmm920_link_adapt( ctx, link );
+
+	pthread_mutex_unlock( &ctx->link_mutex );
+}
 
-	DbgPrint("\n");
+/**
+	@~English
+	@brief get retry count and timeout of node function
+	@param ctx : instance handle
+	@param addr : dest address
+	@param retry : retry count ( NULL : not used )
+	@param timeout : response timeout (usec) ( NULL : not used )
+	@~Japanese
+	@brief 通信相手の再送回数と応答待ち時間を取得する関数
+	@param ctx : インスタンスハンドル
+	@param addr : 送信先アドレス
+	@param retry : 再送回数 ( NULL : 未使用 )
+	@param timeout : 応答待ち時間 (usec) ( NULL : 未使用 )
+	@par 適応しない設定の場合は txq_start の値を返します。
+**/
+static void _conexio_cmm920_link_policy( CONEXIO920HANDLE ctx, long addr, int *retry, long *timeout )
+{
+	PCONEXIO920LINK link;
+
+	if( retry != NULL ) *retry = ctx->txq_retry;
+	if( timeout != NULL ) *timeout = ctx->txq_timeout_msec * 1000L;
+	if( ctx->link_adaptive != CONEXIO_CMM920_LINK_ADAPTIVE_ON ) return;
+
+	pthread_mutex_lock( &ctx->link_mutex );
+	link = _conexio_cmm920_link( ctx, addr );
+	if( retry != NULL ) *retry = link->retry;
+	if( timeout != NULL ) *timeout = link->timeout;
+	pthread_mutex_unlock( &ctx->link_mutex );
+}
 
-	_conexio_cmm920_output_syslog_notice( syslog_string );
+/**
+	@~English
+	@brief match received telegram with the transmit queue function
+	@param ctx : instance handle
+	@param frame : received frame
+	@param length : frame length
+	@return matched : 1, not matched : 0
+	@~Japanese
+	@brief 受信データと送信キューの応答待ちを照合する関数
+	@param ctx : インスタンスハンドル
+	@param frame : 受信フレーム
+	@param length : フレームサイズ
+	@return 一致 : 1, 不一致 : 0
+	@par 送信元アドレスが応答待ちの送信先と一致し、シーケンス番号も一致するものを優先します。
+	@par シーケンス番号が一致しない場合は、その送信先で最も古い応答待ちと一致したものとします。
+**/
+static int _conexio_cmm920_txq_match( CONEXIO920HANDLE ctx, BYTE *frame, int length )
+{
+	BYTE *data = &frame[CONEXIO_CMM920_FRAME_HEAD_SIZE];
+	PCONEXIO920TXQENTRY ent = NULL;
+	PCONEXIO920TXQSTAT stat;
+	CONEXIO920TXCALLBACK callback;
+	struct timespec now;
+	CONEXIO920MHRVIEW view;
+	BYTE seq_no;
+	long src_addr;
+	long rtt;
+	int d_size, t_size, i, id;
+
+	d_size = length - CONEXIO_CMM920_FRAME_HEAD_SIZE - CONEXIO_CMM920_FRAME_FOOT_SIZE;
+	if( d_size < 5 ) return 0;
+	t_size = data[3] * 256 + data[4];
+	if( t_size < 4 || 5 + t_size > d_size ) return 0;
+	if( conexio_cmm920_mhr_decode( &data[5], t_size - 4, &view ) < 0 ) return 0;
+	seq_no = view.seq_no;
+	src_addr = view.src_addr;
+
+	pthread_mutex_lock( &ctx->txq_mutex );
+
+	for( i = 0; i < CONEXIO_CMM920_TXQ_NUM; i++ ){
+		if( ctx->txq[i].state != CONEXIO_CMM920_TXQ_INFLIGHT ||
+			ctx->txq[i].dest_addr != src_addr ) continue;
+		if( ctx->txq[i].seq_no == seq_no ){
+			ent = &ctx->txq[i];
+			break;
+		}
+		if( ent == NULL || ctx->txq[i].order < ent->order ) ent = &ctx->txq[i];
+	}
 
+	if( ent == NULL ){
+		pthread_mutex_unlock( &ctx->txq_mutex );
+		return 0;
+	}
 
-	pac = allocConexioCMM920_packet(pac, mode, command, 1);
-	if(pac == NULL) {
-		DbgPrint("<RecvCommandAck> Memory Null Allocate.\n");
-		free(array);
-		return -4;
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	rtt = _conexio_cmm920_diff_usec( &ent->send_time, &now );
+	_conexio_cmm920_link_result( ctx, ent->dest_addr, rtt );
+	_conexio_cmm920_link_recv( ctx, src_addr, _calc_Hex2Bcd( data[1] ), _conexio_cmm920_Hex2dBm( data[2] ) );
+
+	stat = _conexio_cmm920_txq_stat( ctx, ent->dest_addr );
+	if( stat != NULL ){
+		stat->response++;
+		stat->rtt_last = rtt;
+		if( stat->response == 1 || rtt < stat->rtt_min ) stat->rtt_min = rtt;
+		if( rtt > stat->rtt_max ) stat->rtt_max = rtt;
+		stat->rtt_total += rtt;
+		stat->depth--;
 	}
-	pac->data = (BYTE*)malloc(sizeof(BYTE) * (d_size) );
-	DbgAllocFreeCheck("<RecvCommandAck> Alloc PAC data( check ) \n");
-	if(pac->data == NULL)
-	{
-		DbgPrint("<RecvCommandAck> Memory allocation error\n");
-		free(array);
-		free(pac);
-		return -5;
+
+	id = ent->id;
+	ent->state = CONEXIO_CMM920_TXQ_FREE;
+	callback = ctx->txq_callback;
+	pthread_cond_broadcast( &ctx->txq_cond );
+
+	pthread_mutex_unlock( &ctx->txq_mutex );
+
+	if( callback != NULL ){
+		callback( id, 0, view.payload, view.size, ctx->txq_callback_arg );
 	}
 
-	if(size != NULL){
-		DbgPrint("<RecvCommandAck> size not NULL\n");
-		if(*size != 0){
-			DbgPrint("<RecvCommandAck> *size not 0 : %d\n", *size );
+	return 1;
+}
+
+/**
+	@~English
+	@brief receive thread function
+	@param arg : not used
+	@return NULL
+	@~Japanese
+	@brief 受信スレッド関数
+	@param arg : 未使用
+	@return NULL
+	@par 受信データはコールバック関数またはキューへ、コマンドの応答は待っている呼び出し元へ渡します。
+**/
+static void* _conexio_cmm920_recv_thread( void *arg )
+{
+	CONEXIO920HANDLE ctx = (CONEXIO920HANDLE)arg;
+	BYTE *frame = ctx->recv_thread_frame;
+	BYTE *data;
+	struct timespec deadline;
+	unsigned int tail;
+	int length;
+	int d_size;
+	int slot;
+
+	while( !ctx->recv_thread_stop ){
+		clock_gettime( CLOCK_MONOTONIC, &deadline );
+		_conexio_cmm920_add_msec( &deadline, CONEXIO_CMM920_RECV_THREAD_POLL_MSEC );
+
+		if( _conexio_cmm920_read_frame( ctx, frame, &length, &deadline ) ) continue;
+
+		_conexio_cmm920_trace( CONEXIO_CMM920_TRACE_DIR_RECV, frame, length );
+
+		if( _conexio_cmm920_is_telegram( frame, length ) ){
+			if( _conexio_cmm920_crc_check( ctx, frame, length ) ) continue;
+
+			if( ctx->txq_active && _conexio_cmm920_txq_match( ctx, frame, length ) ) continue;
+
+			if( ctx->recv_callback != NULL ){
+				data = &frame[CONEXIO_CMM920_FRAME_HEAD_SIZE];
+				d_size = data[3] * 256 + data[4] - 4;	// without crc
+				if( d_size < 0 ) d_size = 0;
+				ctx->recv_callback( &data[5], d_size,
+					_calc_Hex2Bcd( data[1] ), _conexio_cmm920_Hex2dBm( data[2] ),
+					ctx->recv_callback_arg );
+				continue;
+			}
+
+			tail = ctx->recv_queue_tail;
+			if( tail - ctx->recv_queue_head >= CONEXIO_CMM920_RECV_QUEUE_NUM ){
+				ctx->recv_queue_drop++;
+				continue;
+			}
+			memcpy( ctx->recv_queue[tail & ( CONEXIO_CMM920_RECV_QUEUE_NUM - 1 )], frame, length );
+			ctx->recv_queue_length[tail & ( CONEXIO_CMM920_RECV_QUEUE_NUM - 1 )] = length;
+			__sync_synchronize();
+			ctx->recv_queue_tail = tail + 1;
+
+			pthread_mutex_lock( &ctx->recv_mutex );
+			pthread_cond_broadcast( &ctx->recv_cond );
+			pthread_mutex_unlock( &ctx->recv_mutex );
 		}else{
-			DbgPrint("<RecvCommandAck> size = 0 d_size %d\n", d_size );
+			// コマンド毎に保持し、別のコマンドの応答で上書きされないようにする
+			slot = _conexio_cmm920_ack_index( frame[4] & ~CONEXIO_CMM920_RECVCOMMAND, frame[5] );
+			pthread_mutex_lock( &ctx->recv_mutex );
+			memcpy( ctx->recv_ack_frame[slot], frame, length );
+			ctx->recv_ack_length[slot] = length;
+			pthread_cond_broadcast( &ctx->recv_cond );
+			pthread_mutex_unlock( &ctx->recv_mutex );
 		}
-	}else{
-		DbgPrint("<RecvCommandAck> size is NULL\n");
 	}
 
-	if( (size != NULL) && (*size != 0) ){
-		iRet = pktChkBYTEArray( pac, array , *size);
+	return NULL;
+}
+
+/**
+	@~English
+	@brief airtime of a telegram function
+	@param bitrate : bit rate (bps)
+	@param size : send data size ( without MHR )
+	@return airtime (usec)
+	@~Japanese
+	@brief 電文の送信時間を計算する関数
+	@param bitrate : ビットレート (bps)
+	@param size : 送信データサイズ ( MHR を除く )
+	@return 送信時間 (usec)
+	@par プリアンブル、SFD、PHR、MHR、FCS を含みます。シングルホップの MHR はモジュールが付加します。
+**/
+static long _conexio_cmm920_airtime( long bitrate, int size )
+{
+	long long bits;
+
+	bits = ( CONEXIO_CMM920_AIRTIME_PHY_SIZE + conexio_cmm920_mhr_layout( CONEXIO_CMM920_MHR_FC_DEFAULT )->size
+		+ size + CONEXIO_CMM920_CRC_SIZE ) * 8LL;
+
+	return (long)( ( bits * 1000000LL + bitrate - 1 ) / bitrate );
+}
+
+/**
+	@~English
+	@brief advance the airtime budget window function
+	@param ctx : instance handle
+	@param now : current time (usec)
+	@~Japanese
+	@brief 送信時間の予算の期間を進める関数
+	@param ctx : インスタンスハンドル
+	@param now : 現在時刻 (usec)
+	@par 期間を過ぎたスロットの送信時間を使用時間から除きます。airtime_mutex をロックして呼び出してください。
+**/
+static void _conexio_cmm920_airtime_advance( CONEXIO920HANDLE ctx, long long now )
+{
+	long long no = now / ctx->airtime_slot_usec;
+	long long n;
+	int i;
+
+	if( no - ctx->airtime_slot_no > CONEXIO_CMM920_AIRTIME_SLOT_NUM ){
+		memset( ctx->airtime_slot, 0, sizeof(ctx->airtime_slot) );
+		ctx->airtime_used = 0;
 	}else{
-		iRet = pktChkBYTEArray( pac, array , d_size);
-	}
-	if( iRet ){
-		DbgPrint("<RecvCommandAck> pkt Chk Error : %x\n", iRet );
-		// 2016.01.08 (2) start
-		free(array);
-		freeConexioCMM920_packet(pac);
-		//free(pac->data);
-		//free(pac);
-		// 2016.01.08 (2) end
-		return -6;
-		
+		for( n = ctx->airtime_slot_no + 1; n <= no; n++ ){
+			i = n % ( CONEXIO_CMM920_AIRTIME_SLOT_NUM + 1 );
+			ctx->airtime_used -= ctx->airtime_slot[i];
+			ctx->airtime_slot[i] = 0;
+		}
 	}
-	free(array);
+	ctx->airtime_slot_no = no;
+}
 
-	for( i = 0; i < d_size; i ++ ){
-		buf[i] = pac->data[i];
+/**
+	@~English
+	@brief airtime budget wait function
+	@param ctx : instance handle
+	@param need : airtime to send (usec)
+	@param now : current time (usec)
+	@return wait until the budget has the airtime (usec) ( 0 : now )
+	@~Japanese
+	@brief 送信時間の予算ができるまでの待ち時間を計算する関数
+	@param ctx : インスタンスハンドル
+	@param need : 送信する時間 (usec)
+	@param now : 現在時刻 (usec)
+	@return 予算ができるまでの待ち時間 (usec) ( 0 : すぐに送信可能 )
+	@par 古いスロットから期間を過ぎる時刻を順に調べます。予算より長い送信は期間内の使用時間が 0 になるまで待ちます。
+	@par airtime_mutex をロックし、_conexio_cmm920_airtime_advance の後に呼び出してください。
+**/
+static long long _conexio_cmm920_airtime_wait( CONEXIO920HANDLE ctx, long long need, long long now )
+{
+	long long budget = ctx->airtime_budget_msec * 1000LL;
+	long long used = ctx->airtime_used;
+	long long n;
+
+	if( budget <= 0 ) return 0;
+	if( need > budget ) need = budget;
+	if( used + need <= budget ) return 0;
+
+	for( n = ctx->airtime_slot_no - CONEXIO_CMM920_AIRTIME_SLOT_NUM; n < ctx->airtime_slot_no; n++ ){
+		if( n < 0 ) continue;
+		used -= ctx->airtime_slot[n % ( CONEXIO_CMM920_AIRTIME_SLOT_NUM + 1 )];
+		if( used + need <= budget ) break;
 	}
-	// 2016.01.08 (2) start
-	freeConexioCMM920_packet(pac);
-	//free(pac->data);
-	//free(pac);
-	// 2016.01.08 (2) end
 
-	if(size != NULL)	*size = d_size;
+	// スロット n は ( n + スロット数 + 1 ) 番目のスロットの開始で期間を過ぎる
+	return ( n + CONEXIO_CMM920_AIRTIME_SLOT_NUM + 1 ) * ctx->airtime_slot_usec - now;
+}
+
+/**
+	@~English
+	@brief current time function
+	@return monotonic time (usec)
+	@~Japanese
+	@brief 現在時刻を取得する関数
+	@return 単調増加時刻 (usec)
+**/
+static long long _conexio_cmm920_airtime_now( void )
+{
+	struct timespec now;
 
-	return 0;	
+	clock_gettime( CLOCK_MONOTONIC, &now );
 
+	return now.tv_sec * 1000000LL + now.tv_nsec / 1000;
 }
 
-// Allocate 920MHz Packet
 /**
 	@~English
-	@brief CONEXIO 920MHz Module Allocate Packet Function
-	@param pac : CONEXIO Packet structure
-	@param mode : Send Mode
-	@param com : Send Command
-	@param isSend : 1. Send Packet ( Initialize Data ) 0.Receive Check Packet (Packet Allocate only )
-	@return Success : Packet struture Failed : NULL
+	@brief check the airtime budget function
+	@param ctx : instance handle
+	@param size : send data size ( without MHR )
+	@param reserve : 1 : add the airtime when the budget has it, 0 : check only
+	@param defer : number of deferred telegrams to count when the budget does not have it
+	@return wait until the budget has the airtime (usec) ( 0 : now )
 	@~Japanese
-	@brief CONEXIO 920MHz　Module のパケット生成 関数
-	@param pac : パケットバッファ
-	@param mode :　送信モード
-	@param com : 送信コマンド
-	@param isSend : 1. 送信パケット（　初期化データ　)  0. 受信チェックパケット（パケット生成のみ )
-	@return 成功:  パケット 失敗 :  NULL
+	@brief 送信時間の予算を確認する関数
+	@param ctx : インスタンスハンドル
+	@param size : 送信データサイズ ( MHR を除く )
+	@param reserve : 1 : 予算があれば送信時間を加算する 0 : 確認のみ
+	@param defer : 予算がない場合に加算する送信延期の数
+	@return 予算ができるまでの待ち時間 (usec) ( 0 : すぐに送信可能 )
 **/
-PCONEXIO920PACKET allocConexioCMM920_packet(PCONEXIO920PACKET pac, BYTE mode, BYTE com, BYTE isSend )
+static long long _conexio_cmm920_airtime_check( CONEXIO920HANDLE ctx, int size, int reserve, int defer )
 {
-	pac = (PCONEXIO920PACKET)malloc(sizeof(CONEXIO920PACKET));
+	long long now = _conexio_cmm920_airtime_now();
+	long long wait;
+	long air;
+
+	pthread_mutex_lock( &ctx->airtime_mutex );
+
+	air = _conexio_cmm920_airtime( ctx->airtime_bitrate, size );
+	_conexio_cmm920_airtime_advance( ctx, now );
+	wait = _conexio_cmm920_airtime_wait( ctx, air, now );
+
+	if( wait > 0 ){
+		if( reserve ) ctx->airtime_stat.rejected++;
+		ctx->airtime_stat.deferred += defer;
+	}else if( reserve ){
+		ctx->airtime_slot[ctx->airtime_slot_no % ( CONEXIO_CMM920_AIRTIME_SLOT_NUM + 1 )] += air;
+		ctx->airtime_used += air;
+		ctx->airtime_stat.sent++;
+		ctx->airtime_stat.total_usec += air;
+	}
 
-	if(pac == (PCONEXIO920PACKET)NULL) return pac;
+	pthread_mutex_unlock( &ctx->airtime_mutex );
 
-	DbgAllocFreeCheck("<allocConexioCMM920_packet> Alloc PAC\n");
-	// if you send the packet, it set header and footer parameters. 
-	if( isSend ){
-		pac->dle = 0x10;
-		pac->stx = 0x02;
-		pac->size[0] = 0x00;
-		pac->size[1] = 0x00;
-		pac->command[0] = mode;
-		pac->command[1] = com;
-		pac->result = 0x00;
-		pac->resultCode = 0x00;
-		pac->etx = 0x03;
-	}
-	pac->data = (BYTE*)NULL; // 2016.01.15 (5)
-	return pac;
+	return wait;
 }
 
-// Free memory 920MHz packet
 /**
 	@~English
-	@brief CONEXIO 920MHz Module Free Packet Function
-	@param pac : CONEXIO Packet structure
+	@brief airtime of the transmit queue function
+	@param ctx : instance handle
+	@param bitrate : bit rate (bps)
+	@param priority : lowest priority to add
+	@return airtime of the telegrams waiting to be sent (usec)
 	@~Japanese
-	@brief CONEXIO 920MHz　Module のパケット解放 関数
-	@param pac : パケットバッファ
+	@brief 送信キューの送信時間を計算する関数
+	@param ctx : インスタンスハンドル
+	@param bitrate : ビットレート (bps)
+	@param priority : 加算する最低の優先度
+	@return 優先度以上の未送信データの送信時間 (usec)
 **/
-void freeConexioCMM920_packet(PCONEXIO920PACKET pac)
+static long long _conexio_cmm920_txq_airtime( CONEXIO920HANDLE ctx, long bitrate, int priority )
 {
-	if(pac != (PCONEXIO920PACKET)NULL ){	
-		if(pac->data != (BYTE *)NULL){
-			DbgAllocFreeCheck("<freeConexioCMM920_packet> Free PAC Data\n");
-			free(pac->data); 
-			pac->data = (BYTE *)NULL;//2016.01.15 (5)
-		}
+	long long air = 0;
+	int i;
 
-		DbgAllocFreeCheck("<freeConexioCMM920_packet> Free PAC \n");
-		free(pac);
-		pac = (PCONEXIO920PACKET)NULL;//2016.01.15 (5)
+	pthread_mutex_lock( &ctx->txq_mutex );
+	for( i = 0; i < CONEXIO_CMM920_TXQ_NUM && ctx->txq_active; i++ ){
+		if( ctx->txq[i].state == CONEXIO_CMM920_TXQ_PENDING && ctx->txq[i].priority >= priority ){
+			air += _conexio_cmm920_airtime( bitrate, ctx->txq[i].size );
+		}
 	}
+	pthread_mutex_unlock( &ctx->txq_mutex );
+
+	return air;
 }
 
-// Make 920MHz packet
 /**
 	@~English
-	@brief CONEXIO 920MHz Module Get Data Array from Packet
-	@param pac : CONEXIO Packet structure
-	@param size : Data Size
-	@param retSize : Byte Array Data Size
-	@par Create BYTE Array for seiral communication function.
-	@warning After running function, Free CONEXIO Packet structure.
-	@return Success : BYTE Array Failed : NULL
+	@brief CONEXIO 920MHz Module data send function ( with sequence number )
+	@param ctx : instance handle
+	@param seq_no : MHR sequence number of the sent telegram ( multi hop only , NULL : not used )
+	@par Other parameters and return values are the same as SendTelegram.
 	@~Japanese
-	@brief CONEXIO 920MHz　Module のパケットをBYTE配列取得 関数
-	@param pac : パケットバッファ
-	@param size :　データサイズ
-	@param retSize : BYTE配列サイズ
-	@par シリアル通信用のBYTE配列を作成します。
-	@warning 関数実行後、パケットが解放されます。
-	@return 成功:  バイト配列  失敗 :  NULL
+	@brief CONEXIO 920MHz　Module データ送信 関数 ( シーケンス番号取得付き )
+	@param ctx : インスタンスハンドル
+	@param seq_no : 送信したデータの MHR シーケンス番号 ( マルチホップのみ , NULL : 未使用 )
+	@par その他の引数と戻り値は SendTelegram と同じです。
 **/
-BYTE* pktGetBYTEArray( PCONEXIO920PACKET pac, int size , int *retSize)
+static int _conexio_cmm920_send_telegram(CONEXIO920HANDLE ctx, BYTE buf[], int size, int hop, int send_mode, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr, BYTE *seq_no)
 {
-	BYTE* retArray;
-	long cnt;
-	int HeadSize, FootSize, pktSizeOffset;
 
-	HeadSize = 8;	//header size 8byte
-	pktSizeOffset	= 5;
-	FootSize = 3; //footer 3byte(locked)
+	BYTE*	frame;
+	BYTE*	pktBuf;
+	int pktSize;
+	int ret;
+	int offset = 0;
 
-	// malloc packet size 
-	retArray = (BYTE *)malloc(sizeof(BYTE) * (HeadSize + FootSize + size ));
-	if(retArray == (BYTE*)NULL)
-	{
-		DbgPrint("<pktGetBYTEArray> Memory allocation error\n");
-		return (BYTE*)NULL;
+	if( hop == CONEXIO_CMM920_HOP_MULTI ){
+		offset = conexio_cmm920_mhr_layout( CONEXIO_CMM920_MHR_FC_DEFAULT )->size;
 	}
 
-	*retSize = HeadSize + FootSize + size;
+	pktSize = size + offset + 3;
+	if( size < 0 || pktSize > CONEXIO_CMM920_FRAME_DATA_MAX ) return -1;
 
-	/* header */
-	retArray[0] = pac->dle;
-	retArray[1] = pac->stx;
-	retArray[2] = (BYTE)((size + pktSizeOffset) >> 8);
-	retArray[3] = (BYTE)((size + pktSizeOffset) % 256);
-	retArray[4] = pac->command[0];
-	retArray[5] = pac->command[1];
-	retArray[6] = pac->result;
-	retArray[7] = pac->resultCode;
+	switch( send_mode ){
+	case CONEXIO_CMM920_SENDDATA_MODE_NOACK_NORESP:
+	case CONEXIO_CMM920_SENDDATA_MODE_ACK_NORESP:
+	case CONEXIO_CMM920_SENDDATA_MODE_NOACK_RESP:
+	case CONEXIO_CMM920_SENDDATA_MODE_ACK_RESP:
+		break;
+	default:
+		return 0;
+	}
 
-	/* Data */
-	for(cnt = 0; cnt < size; cnt++)
-	{
-		retArray[HeadSize + cnt] = pac->data[cnt];
+	// フレームのデータ部に直接作成する
+	frame = _conexio_cmm920_frame_get();
+	if( frame == (BYTE*)NULL ) return -17;
+
+	// 送信できるフレームがある場合だけ送信時間を予約する
+	if( _conexio_cmm920_airtime_check( ctx, size, 1, 0 ) > 0 ){
+		_conexio_cmm920_frame_put( frame );
+		return -9;
 	}
+	pktBuf = &frame[CONEXIO_CMM920_FRAME_HEAD_SIZE];
 
-	/* check sum */
-	for(pac->sum = 0, cnt = 2; cnt < size + HeadSize; cnt++)
-	{
-		pac->sum += retArray[cnt];
+
+	pktBuf[0] = send_mode;
+	pktBuf[1] = ( size + offset + 4 ) >> 8;
+	pktBuf[2] = ( size + offset + 4 ) % 256;
+
+	// ヘッダは送信フレームに直接書き込む
+	if( hop == CONEXIO_CMM920_HOP_MULTI ){
+		conexio_cmm920_mhr_encode_h( ctx, &pktBuf[3], CONEXIO_CMM920_MHR_FC_DEFAULT,
+			( dest_id != NULL ) ? *dest_id : 0, ( src_id != NULL ) ? *src_id : 0,
+			( dest_addr != NULL ) ? *dest_addr : 0, ( src_addr != NULL ) ? *src_addr : 0 );
+		if( seq_no != NULL ) *seq_no = pktBuf[5];
 	}
-	retArray[size + HeadSize] = (BYTE)((pac->sum ^ 0xFF) + 1);
 
-	/* footer */
-	retArray[size + HeadSize + 1] = pac->dle;
-	retArray[size + HeadSize + 2] = pac->etx;
+	memcpy( &pktBuf[3 + offset], buf, size );
 
+	ret = _conexio_cmm920_send_frame(ctx, frame, pktSize, CONEXIO_CMM920_MODE_RUN, CONEXIO_CMM920_SENDDATA);
 
-	/* free memory packet */
-	freeConexioCMM920_packet(pac);
+	_conexio_cmm920_frame_put( frame );
+
+	return ret;
 
-	return retArray;
 }
 
+/**
+	@~English
+	@brief CONEXIO 920MHz Module data send function
+	@param ctx : instance handle
+	@param buf : send data buffer
+	@param size : send data size
+	@param hop : hop mode
+	@param send_mode : send mode
+	@param dest_id : dest PAN ID
+	@param src_id : source PAN ID
+	@param dest_addr : Dest Address
+	@param src_addr : Source Address
+	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error, Airtime budget : -9
+	@~Japanese
+	@brief CONEXIO 920MHz　Module データ送信 関数
+	@param ctx : インスタンスハンドル
+	@param buf : 送信データバッファ
+	@param size : 送信データサイズ
+	@param hop : ホップ・モード
+	@param send_mode : 送信モード
+	@param dest_id : 送信先PAN　ID
+	@param src_id : 送信元 PAN ID
+	@param dest_addr : 送信先アドレス
+	@param src_addr : 送信元アドレス
+	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～, 送信時間の予算超過 : -9
+	@par conexio_cmm920_set_airtime_budget の予算を超える場合は送信しません。
+**/
+int SendTelegram_h(CONEXIO920HANDLE ctx, BYTE buf[], int size, int hop, int send_mode, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr)
+{
+	return _conexio_cmm920_send_telegram(ctx, buf, size, hop, send_mode, dest_id, src_id, dest_addr, src_addr, NULL);
+}
+
+/**
+	@~English
+	@brief SendTelegram_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで SendTelegram_h を実行する関数
+**/
+int SendTelegram(BYTE buf[], int size, int hop, int send_mode, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr)
+{
+	return SendTelegram_h( &global_default_context, buf, size, hop, send_mode, dest_id, src_id, dest_addr, src_addr );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module data receive function
+	@param ctx : instance handle
+	@param buf : receive data buffer
+	@param size : receive data size
+	@param hop : hop mode
+	@param r_channel : receive channel
+	@param rx_pwr : receive power
+	@param crc: crc value
+	@param dest_id : dest PAN ID
+	@param src_id : source PAN ID
+	@param dest_addr : Dest Address
+	@param src_addr : Source Addres
+	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
+	@~Japanese
+	@brief CONEXIO 920MHz　Module のデータ受信 関数
+	@param ctx : インスタンスハンドル
+	@param buf : 受信データバッファ
+	@param size : 受信データサイズ
+	@param hop : ホップ・モード
+	@param r_channel : 受信チャネル
+	@param rx_pwr : 受信強度
+	@param crc: CRC値
+	@param dest_id : 送信先PAN　ID
+	@param src_id : 送信元 PAN ID
+	@param dest_addr : 送信先アドレス
+	@param src_addr : 送信元アドレス
+	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
+**/
+int RecvTelegram_h(CONEXIO920HANDLE ctx, BYTE buf[], int *size , int hop, int *r_channel, int *rx_pwr, unsigned int *crc ,unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr)
+{
+	CONEXIO920MHRVIEW view;
+	int iRet = 0;	
+	int offset = 0;
+	int iSize = 0;
+	int channel = 0, power = 0;
+
+
+	if( hop == CONEXIO_CMM920_HOP_SINGLE )	return RecvTelegramSingleHop_h(ctx, buf, size, r_channel, rx_pwr, crc);
+
+	iRet = RecvTelegramSingleHop_h(ctx, buf, &iSize, &channel, &power, crc);
+
+	if( iRet == 0 ){
+		if( r_channel != NULL ) *r_channel = channel;
+		if( rx_pwr != NULL ) *rx_pwr = power;
+		if( iSize > 0 ){
+			offset = conexio_cmm920_mhr_decode( buf, iSize, &view );
+			if( offset >= 0 ){
+				_conexio_cmm920_link_recv( ctx, view.src_addr, channel, power );
+				if( dest_id != NULL ) *dest_id = view.dest_id;
+				if( src_id != NULL ) *src_id = view.src_id;
+				if( dest_addr != NULL ) *dest_addr = view.dest_addr;
+				if( src_addr != NULL ) *src_addr = view.src_addr;
+				memmove( buf, view.payload, view.size );
+				DbgPrint(":Length %d\n", iSize - offset );
+				memset( &buf[iSize - offset], 0x00, offset );
+				if( size != NULL )	*size = iSize - offset;
+			}
+		}else{
+			if( size != NULL )	*size = 0;
+		}
+	}
+
+
+	return iRet;
+
+}
+
+/**
+	@~English
+	@brief RecvTelegram_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで RecvTelegram_h を実行する関数
+**/
+int RecvTelegram(BYTE buf[], int *size , int hop, int *r_channel, int *rx_pwr, unsigned int *crc ,unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr)
+{
+	return RecvTelegram_h( &global_default_context, buf, size, hop, r_channel, rx_pwr, crc, dest_id, src_id, dest_addr, src_addr );
+}
+
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module data receive with single hop function
+	@param ctx : instance handle
+	@param buf : receive data buffer
+	@param size : receive data size
+	@param r_channel : receive channel
+	@param rx_pwr : receive power
+	@param crc: crc value
+	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error, CRC Error : -8
+	@~Japanese
+	@brief CONEXIO 920MHz　Module のシングルホップ用データ受信 関数
+	@param ctx : インスタンスハンドル
+	@param buf : 受信データバッファ
+	@param size : 受信データサイズ
+	@param r_channel : 受信チャネル
+	@param rx_pwr : 受信強度
+	@param crc: CRC値
+	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～, CRC エラー : -8
+	@par CRC チェックが有効な場合、 CRC エラーの受信データは破棄します。
+**/
+int RecvTelegramSingleHop_h(CONEXIO920HANDLE ctx, BYTE buf[], int *size , int *r_channel, int *rx_pwr , unsigned int *crc )
+{
+
+	BYTE*	frame;
+	BYTE*	pktBuf;
+	int pktSize;
+	int i, d_size, crc_size;
+	int iRet;
+	int head_size = 5; //recv enable/disable + rx_channel + rx_power + phr(2byte)
+	int foot_size;
+
+	crc_size = 32;// crc ( bit length )
+	foot_size = 2 + (crc_size / 8); // crc + rssi + ant
+	if( size != NULL && *size != 0 ){
+		pktSize = *size + head_size + foot_size;
+	}else{
+		pktSize = 0;
+	}
+
+	frame = _conexio_cmm920_frame_get();
+	if( frame == (BYTE*)NULL ) return -1;
+	pktBuf = &frame[CONEXIO_CMM920_FRAME_HEAD_SIZE];
+
+	// Data Received
+	iRet = _conexio_cmm920_recv_frame(ctx, frame, &pktSize, CONEXIO_CMM920_MODE_RUN, CONEXIO_CMM920_SENDDATA);
+
+	if( iRet ){
+		_conexio_cmm920_frame_put( frame );
+		return iRet;
+	}
+
+	// 受信スレッド動作中はスレッドでチェック済み
+	if( !ctx->recv_thread_active &&
+		_conexio_cmm920_crc_check( ctx, frame, pktSize + CONEXIO_CMM920_FRAME_HEAD_SIZE + CONEXIO_CMM920_FRAME_FOOT_SIZE ) ){
+		_conexio_cmm920_frame_put( frame );
+		return -8;
+	}
+
+	if( pktSize > 0 ){
+		if( pktBuf[0] == 0x01 ){
+			
+			if( pktSize >= 3 )	DbgRecvTelegramParam("pktBuf[2] = 0x%x\n", pktBuf[2]);
+
+			if( r_channel != NULL )
+				*r_channel = _calc_Hex2Bcd(pktBuf[1]);
+			if( rx_pwr != NULL ){
+				*rx_pwr = _conexio_cmm920_Hex2dBm(pktBuf[2]);
+				DbgRecvTelegramParam("*rx_pwr = 0x%x\n", *rx_pwr);
+			}
+			d_size = pktBuf[3] * 256 + pktBuf[4];
+
+			if( buf != NULL ){
+				if( d_size < pktSize ){ 
+					for( i = 0; i < d_size - (crc_size / 8) ; i ++ ){
+						buf[i] = pktBuf[head_size + i];
+					}
+				}
+			}
+			//crc, rx_rssi, rx_ant
+		
+			if( size != NULL ) *size = d_size; // 2016.01.08 (3)
+			// 2016.01.11 (3) start
+			if( crc != NULL ){
+				for( i = 0, *crc = 0; i < (crc_size / 8); i ++)
+					*crc = (*crc << 8) | pktBuf[head_size + d_size - (crc_size / 8) + i];
+			}
+			// 2016.01.11 (3) end
+		}
+	}
+	
+	_conexio_cmm920_frame_put( frame );
+	return 0;
+}
+
+/**
+	@~English
+	@brief RecvTelegramSingleHop_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで RecvTelegramSingleHop_h を実行する関数
+**/
+int RecvTelegramSingleHop(BYTE buf[], int *size , int *r_channel, int *rx_pwr , unsigned int *crc )
+{
+	return RecvTelegramSingleHop_h( &global_default_context, buf, size, r_channel, rx_pwr, crc );
+}
+
+// Send Command CMM920
+/**
+	@~English
+	@brief CONEXIO 920MHz Module command send function
+	@param ctx : instance handle
+	@param buf : send data buffer
+	@param size : send data size
+	@param mode : send mode
+	@param command : command
+	@return Success : 0 , Failed : Frame pool empty : -1, Data size error : -2
+	@~Japanese
+	@brief CONEXIO 920MHz　Module のコマンドデータ受信 関数
+	@param ctx : インスタンスハンドル
+	@param buf : 送信データバッファ
+	@param size : 送信データサイズ
+	@param mode : 送信モード
+	@param command : コマンド
+	@return 成功:  0 失敗 :  フレームの空きなし:  -1, データサイズエラー : -2
+**/
+int SendCommand_h(CONEXIO920HANDLE ctx, BYTE buf[], int size, BYTE mode, BYTE command )
+{
+	BYTE *frame;
+	int iRet;
+
+	if( size < 0 || size > CONEXIO_CMM920_FRAME_DATA_MAX ) return -2;
+
+	frame = _conexio_cmm920_frame_get();
+	if( frame == (BYTE*)NULL ) return -1;
+
+	memcpy( &frame[CONEXIO_CMM920_FRAME_HEAD_SIZE], buf, size );
+
+	iRet = _conexio_cmm920_send_frame( ctx, frame, size, mode, command );
+
+	_conexio_cmm920_frame_put( frame );
+
+	return iRet;
+}
+
+/**
+	@~English
+	@brief SendCommand_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで SendCommand_h を実行する関数
+**/
+int SendCommand(BYTE buf[], int size, BYTE mode, BYTE command )
+{
+	return SendCommand_h( &global_default_context, buf, size, mode, command );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Receive Packet Check Function
+	@param pac : Receive CONEXIO Packet structure
+	@param array : Receive Data Array
+	@param size : Receive Data Array Size
+	@return Success : 0 , Failed : memory allocation error : 1, Header error : 2 , packet size chack Error : 4, Packet footer error : 8, Myself command acknowledge Error : 16, Check Sum Error : 32
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の受信パケットのチェック 関数
+	@param pac : 受信パケットバッファ
+	@param array : 受信データ
+	@param size : 受信データサイズ
+	@return 成功:  0 失敗 :  メモリ確保エラー:  1, ヘッダエラー : 2, パケットサイズチェックエラー: 4, パケットフッタエラー : 8 ,  ACK エラー :  16,  チェックサムエラー : 32
+**/
+int pktChkBYTEArray(PCONEXIO920PACKET pac, BYTE *array, int size )
+{
+	long cnt;
+	int HeadSize, FootSize, pktSizeOffset;
+	int iRet = 0;
+
+	HeadSize = 8;	//header size 8byte
+	FootSize = 3; //footer size 3byte
+	pktSizeOffset = 5;
+
+	if(array == NULL)
+	{
+		DbgPrint("<pktChkBYTEArray> Memory allocation error\n");
+		return 1;
+	}
+
+	/*  Error Code */
+	global_default_context.getLastError = (array[5] << 8) + array[6];
+
+	/* header Check */
+	if( array[0] != pac->dle || 
+		array[1] != pac->stx ){
+		DbgPrint("<pktChkBYTEArray> Header error\n");
+		iRet |= 2;
+	}
+	else	if( array[2] != (BYTE)((size + pktSizeOffset) >> 8) ||
+				array[3] != (BYTE)((size + pktSizeOffset) % 256) ){
+			DbgPrint("<pktChkBYTEArray> size check error\n");
+			iRet |= 4;
+	}
+	/* footer Check */
+	else if( array[size + HeadSize + 1] != pac->dle ||
+		array[size + HeadSize + 2] != pac->etx
+	){
+		DbgPrint("<pktChkBYTEArray> Footer Error (%x), (%x) \n", array[size + HeadSize + 1], array[size + HeadSize + 2]);
+		iRet |= 8;
+	}else{
+		if( array[4] != ( pac->command[0] | CONEXIO_CMM920_RECVCOMMAND ) ||
+				array[5] != pac->command[1]
+		){
+			DbgPrint("<pktChkBYTEArray> Myself command ack Error\n");
+			iRet |= 16;
+			if( array[4] == CONEXIO_CMM920_RECVCOMMAND && 
+				array[5] == 0xFF )
+			{
+				DbgPrint("<pktChkBYTEArray> unusual Command \n");
+			} 
+		}
+
+		/* check sum Check */
+		for(pac->sum = 0, cnt = 2; cnt < size + HeadSize; cnt++)
+		{
+			pac->sum += array[cnt];
+		}
+		if( array[size + HeadSize] != (BYTE)((pac->sum ^ 0xFF) + 1) ){
+			DbgPrint("<pktChkBYTEArray> Check Sum Error\n");
+			iRet |= 32;
+		}
+
+		for (cnt = 0; cnt < size; cnt ++)
+		{
+			pac->data[cnt] = array[cnt + HeadSize];
+		}
+	}
+
+	return iRet;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Receive Packet acknowledge Function
+	@param ctx : instance handle
+	@param buf : Data Buffer
+	@param size : Data Size
+	@param mode : Send Mode ( Analyze Packet Check )
+	@param command : Send Command  ( Analyze Packet Check )
+	@return Success : 0 , Failed : Frame pool empty : -1, Data size error ( or no data until the deadline ) : -2, Receive Packet Check Error : -6, Timeout : -7
+	@par The deadline is the last send time of the command plus its timeout ( conexio_cmm920_set_timeout ).
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の受信パケットのチェック 関数
+	@param ctx : インスタンスハンドル
+	@param buf : 受信データバッファ
+	@param size : 受信データサイズ
+	@param mode :　送信モード  ( パケット解析チェック用 )
+	@param command : 送信コマンド ( パケット解析チェック用 )
+	@return 成功:  0 失敗 :  フレームの空きなし:  -1, データサイズエラー ( 期限までにデータなし ) : -2, 受信パケットチェックエラー : -6, タイムアウト : -7
+	@par 期限はコマンドの最終送信時刻にタイムアウト時間 ( conexio_cmm920_set_timeout ) を加えた時刻です。
+**/
+int RecvCommandAck_h( CONEXIO920HANDLE ctx, BYTE *buf, int *size , BYTE mode, BYTE command )
+{
+	BYTE *frame;
+	int d_size = 0;
+	int iRet;
+
+	frame = _conexio_cmm920_frame_get();
+	if( frame == (BYTE*)NULL ){
+		DbgPrint("<RecvCommandAck> Frame pool empty.\n");
+		return -1;
+	}
+
+	if( size != NULL ) d_size = *size;
+
+	iRet = _conexio_cmm920_recv_frame( ctx, frame, &d_size, mode, command );
+	if( iRet == 0 ){
+		memcpy( buf, &frame[CONEXIO_CMM920_FRAME_HEAD_SIZE], d_size );
+		if(size != NULL)	*size = d_size;
+	}
+
+	_conexio_cmm920_frame_put( frame );
+
+	return iRet;
+}
+
+/**
+	@~English
+	@brief RecvCommandAck_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで RecvCommandAck_h を実行する関数
+**/
+int RecvCommandAck( BYTE *buf, int *size , BYTE mode, BYTE command )
+{
+	return RecvCommandAck_h( &global_default_context, buf, size, mode, command );
+}
+
+// Allocate 920MHz Packet
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Allocate Packet Function
+	@param pac : CONEXIO Packet structure
+	@param mode : Send Mode
+	@param com : Send Command
+	@param isSend : 1. Send Packet ( Initialize Data ) 0.Receive Check Packet (Packet Allocate only )
+	@return Success : Packet struture Failed : NULL
+	@~Japanese
+	@brief CONEXIO 920MHz　Module のパケット生成 関数
+	@param pac : パケットバッファ
+	@param mode :　送信モード
+	@param com : 送信コマンド
+	@param isSend : 1. 送信パケット（　初期化データ　)  0. 受信チェックパケット（パケット生成のみ )
+	@return 成功:  パケット 失敗 :  NULL
+**/
+PCONEXIO920PACKET allocConexioCMM920_packet(PCONEXIO920PACKET pac, BYTE mode, BYTE com, BYTE isSend )
+{
+	pac = (PCONEXIO920PACKET)malloc(sizeof(CONEXIO920PACKET));
+
+	if(pac == (PCONEXIO920PACKET)NULL) return pac;
+
+	DbgAllocFreeCheck("<allocConexioCMM920_packet> Alloc PAC\n");
+	// if you send the packet, it set header and footer parameters. 
+	if( isSend ){
+		pac->dle = 0x10;
+		pac->stx = 0x02;
+		pac->size[0] = 0x00;
+		pac->size[1] = 0x00;
+		pac->command[0] = mode;
+		pac->command[1] = com;
+		pac->result = 0x00;
+		pac->resultCode = 0x00;
+		pac->etx = 0x03;
+	}
+	pac->data = (BYTE*)NULL; // 2016.01.15 (5)
+	return pac;
+}
+
+// Free memory 920MHz packet
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Free Packet Function
+	@param pac : CONEXIO Packet structure
+	@~Japanese
+	@brief CONEXIO 920MHz　Module のパケット解放 関数
+	@param pac : パケットバッファ
+**/
+void freeConexioCMM920_packet(PCONEXIO920PACKET pac)
+{
+	if(pac != (PCONEXIO920PACKET)NULL ){	
+		if(pac->data != (BYTE *)NULL){
+			DbgAllocFreeCheck("<freeConexioCMM920_packet> Free PAC Data\n");
+			free(pac->data); 
+			pac->data = (BYTE *)NULL;//2016.01.15 (5)
+		}
+
+		DbgAllocFreeCheck("<freeConexioCMM920_packet> Free PAC \n");
+		free(pac);
+		pac = (PCONEXIO920PACKET)NULL;//2016.01.15 (5)
+	}
+}
+
+// Make 920MHz packet
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Data Array from Packet
+	@param pac : CONEXIO Packet structure
+	@param size : Data Size
+	@param retSize : Byte Array Data Size
+	@par Create BYTE Array for seiral communication function.
+	@warning After running function, Free CONEXIO Packet structure.
+	@return Success : BYTE Array Failed : NULL
+	@~Japanese
+	@brief CONEXIO 920MHz　Module のパケットをBYTE配列取得 関数
+	@param pac : パケットバッファ
+	@param size :　データサイズ
+	@param retSize : BYTE配列サイズ
+	@par シリアル通信用のBYTE配列を作成します。
+	@warning 関数実行後、パケットが解放されます。
+	@return 成功:  バイト配列  失敗 :  NULL
+**/
+BYTE* pktGetBYTEArray( PCONEXIO920PACKET pac, int size , int *retSize)
+{
+	BYTE* retArray;
+	long cnt;
+	int HeadSize, FootSize, pktSizeOffset;
+
+	HeadSize = 8;	//header size 8byte
+	pktSizeOffset	= 5;
+	FootSize = 3; //footer 3byte(locked)
+
+	// malloc packet size 
+	retArray = (BYTE *)malloc(sizeof(BYTE) * (HeadSize + FootSize + size ));
+	if(retArray == (BYTE*)NULL)
+	{
+		DbgPrint("<pktGetBYTEArray> Memory allocation error\n");
+		return (BYTE*)NULL;
+	}
+
+	*retSize = HeadSize + FootSize + size;
+
+	/* header */
+	retArray[0] = pac->dle;
+	retArray[1] = pac->stx;
+	retArray[2] = (BYTE)((size + pktSizeOffset) >> 8);
+	retArray[3] = (BYTE)((size + pktSizeOffset) % 256);
+	retArray[4] = pac->command[0];
+	retArray[5] = pac->command[1];
+	retArray[6] = pac->result;
+	retArray[7] = pac->resultCode;
+
+	/* Data */
+	for(cnt = 0; cnt < size; cnt++)
+	{
+		retArray[HeadSize + cnt] = pac->data[cnt];
+	}
+
+	/* check sum */
+	for(pac->sum = 0, cnt = 2; cnt < size + HeadSize; cnt++)
+	{
+		pac->sum += retArray[cnt];
+	}
+	retArray[size + HeadSize] = (BYTE)((pac->sum ^ 0xFF) + 1);
+
+	/* footer */
+	retArray[size + HeadSize + 1] = pac->dle;
+	retArray[size + HeadSize + 2] = pac->etx;
+
+
+	/* free memory packet */
+	freeConexioCMM920_packet(pac);
+
+	return retArray;
+}
+
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Set Response Timeout Function
+	@param ctx : instance handle
+	@param mode : CMM920 mode
+	@param command : CMM920 command
+	@param msec : timeout (msec) ( 0 : learned deadline )
+	@return Success : 0 , Failed : -1 ( unknown command )
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の応答待ちタイムアウト時間を設定する関数
+	@param ctx : インスタンスハンドル
+	@param mode : CMM920 モード
+	@param command : CMM920 コマンド
+	@param msec : タイムアウト時間 (msec) ( 0 : 学習した期限 )
+	@return 成功:  0 失敗 :  -1 ( 不明なコマンド )
+**/
+int conexio_cmm920_set_timeout_h( CONEXIO920HANDLE ctx, BYTE mode, BYTE command, int msec )
+{
+	int index = _conexio_cmm920_command_index( mode, command );
+
+	if( index < 0 || msec < 0 ) return -1;
+
+	ctx->timeout_msec[index] = msec;
+	return 0;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_set_timeout_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_timeout_h を実行する関数
+**/
+int conexio_cmm920_set_timeout( BYTE mode, BYTE command, int msec )
+{
+	return conexio_cmm920_set_timeout_h( &global_default_context, mode, command, msec );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Response Timeout Function
+	@param ctx : instance handle
+	@param mode : CMM920 mode
+	@param command : CMM920 command
+	@param msec : timeout (msec)
+	@return Success : 0 , Failed : -1 ( unknown command )
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の応答待ちタイムアウト時間を取得する関数
+	@param ctx : インスタンスハンドル
+	@param mode : CMM920 モード
+	@param command : CMM920 コマンド
+	@param msec : タイムアウト時間 (msec)
+	@return 成功:  0 失敗 :  -1 ( 不明なコマンド )
+**/
+int conexio_cmm920_get_timeout_h( CONEXIO920HANDLE ctx, BYTE mode, BYTE command, int *msec )
+{
+	int index = _conexio_cmm920_command_index( mode, command );
+
+	if( index < 0 || msec == NULL ) return -1;
+
+	if( ctx->timeout_msec[index] > 0 )
+		*msec = ctx->timeout_msec[index];
+	else
+		*msec = CONEXIO_CMM920_DEFAULT_TIMEOUT_MSEC;
+	return 0;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_get_timeout_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_timeout_h を実行する関数
+**/
+int conexio_cmm920_get_timeout( BYTE mode, BYTE command, int *msec )
+{
+	return conexio_cmm920_get_timeout_h( &global_default_context, mode, command, msec );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Command Round Trip Time Function
+	@param ctx : instance handle
+	@param mode : CMM920 mode
+	@param command : CMM920 command
+	@param rtt : round trip time structure
+	@return Success : 0 , Failed : -1 ( unknown command )
+	@~Japanese
+	@brief CONEXIO 920MHz　Module のコマンド往復時間を取得する関数
+	@param ctx : インスタンスハンドル
+	@param mode : CMM920 モード
+	@param command : CMM920 コマンド
+	@param rtt : 往復時間構造体
+	@return 成功:  0 失敗 :  -1 ( 不明なコマンド )
+	@par 送信から応答パケット受信完了までの時間を記録します。
+**/
+int conexio_cmm920_get_command_rtt_h( CONEXIO920HANDLE ctx, BYTE mode, BYTE command, PCONEXIO920RTT rtt )
+{
+	int index = _conexio_cmm920_command_index( mode, command );
+
+	if( index < 0 || rtt == NULL ) return -1;
+
+	*rtt = ctx->rtt[index];
+	return 0;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_get_command_rtt_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_command_rtt_h を実行する関数
+**/
+int conexio_cmm920_get_command_rtt( BYTE mode, BYTE command, PCONEXIO920RTT rtt )
+{
+	return conexio_cmm920_get_command_rtt_h( &global_default_context, mode, command, rtt );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Reset Command Round Trip Time Function
+	@param ctx : instance handle
+	@~Japanese
+	@brief CONEXIO 920MHz　Module のコマンド往復時間をクリアする関数
+	@param ctx : インスタンスハンドル
+**/
+void conexio_cmm920_reset_command_rtt_h( CONEXIO920HANDLE ctx )
+{
+	memset( ctx->rtt, 0, sizeof(ctx->rtt) );
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_reset_command_rtt_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_reset_command_rtt_h を実行する関数
+**/
+void conexio_cmm920_reset_command_rtt( void )
+{
+	conexio_cmm920_reset_command_rtt_h( &global_default_context );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Learned Response Wait Function
+	@param ctx : instance handle
+	@param profile : learned response wait structure array
+	@param num : number of array elements
+	@return number of commands
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の学習した応答待ち時間を取得する関数
+	@param ctx : インスタンスハンドル
+	@param profile : 応答待ち時間構造体の配列
+	@param num : 配列の要素数
+	@return コマンド数
+	@par コマンド毎に、平均往復時間、偏差、現在の応答待ち期限を格納します。
+	@par 戻り値が num より大きい場合、 num 個まで格納します。
+**/
+int conexio_cmm920_get_wait_profile_h( CONEXIO920HANDLE ctx, PCONEXIO920WAITPROFILE profile, int num )
+{
+	int i;
+
+	for( i = 0; i < (int)CONEXIO_CMM920_COMMAND_NUM && i < num; i++ ){
+		profile[i] = ctx->wait[i];
+		profile[i].mode = conexio_cmm920_command_list[i][0];
+		profile[i].command = conexio_cmm920_command_list[i][1];
+		profile[i].deadline = _conexio_cmm920_wait_deadline( ctx, i );
+	}
+
+	return (int)CONEXIO_CMM920_COMMAND_NUM;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_get_wait_profile_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_wait_profile_h を実行する関数
+**/
+int conexio_cmm920_get_wait_profile( PCONEXIO920WAITPROFILE profile, int num )
+{
+	return conexio_cmm920_get_wait_profile_h( &global_default_context, profile, num );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Statistics Function
+	@param ctx : instance handle
+	@param stat : statistics structure
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の統計を取得する関数
+	@param ctx : インスタンスハンドル
+	@param stat : 統計構造体
+	@par 送受信フレーム数、バイト数、無線データ数、エラー数はインスタンスごとに、フレームプールの使用状況は全インスタンスの合計を格納します。
+	@par 受信スレッド動作中は、スレッドが更新中の値を読むことがあります。
+**/
+void conexio_cmm920_get_stat_h( CONEXIO920HANDLE ctx, PCONEXIO920STAT stat )
+{
+	if( stat == NULL ) return;
+
+	*stat = ctx->stat;
+	stat->recv_drop = ctx->recv_queue_drop;
+	stat->pool_get = global_frame_get;
+	stat->pool_empty = global_frame_empty;
+	stat->pool_peak = global_frame_peak;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_get_stat_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_stat_h を実行する関数
+**/
+void conexio_cmm920_get_stat( PCONEXIO920STAT stat )
+{
+	conexio_cmm920_get_stat_h( &global_default_context, stat );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Set Received Telegram CRC Check Function
+	@param ctx : instance handle
+	@param mode : CONEXIO_CMM920_CRC_CHECK_OFF or CONEXIO_CMM920_CRC_CHECK_ON
+	@return Success : 0 , Failed : -1 : Parameter Error, less than -16 : CRC calculate inverse read error
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の受信データの CRC チェックを設定する関数
+	@param ctx : インスタンスハンドル
+	@param mode : CONEXIO_CMM920_CRC_CHECK_OFF or CONEXIO_CMM920_CRC_CHECK_ON
+	@return 成功:  0 失敗 :  パラメータエラー : -1,  CRC値計算反転の読み込みエラー : -16～
+	@par 有効にすると、モジュールの CRC値計算反転の設定を読み込み、受信データの CRC をソフトウェアで検証します。
+	@par CRC エラーの受信データはアプリケーションに渡さずに破棄し、統計の crc_errors に数えます。
+	@par 以後 conexio_cmm920_lsi_crc_calc_inverse で設定を変更した場合は、その設定で検証します。
+**/
+int conexio_cmm920_set_crc_check_h( CONEXIO920HANDLE ctx, int mode )
+{
+	unsigned short value = 0;
+	int iRet;
+
+	if( mode != CONEXIO_CMM920_CRC_CHECK_OFF && mode != CONEXIO_CMM920_CRC_CHECK_ON ) return -1;
+
+	if( mode == CONEXIO_CMM920_CRC_CHECK_ON ){
+		iRet = conexio_cmm920_lsi_h( ctx, CONEXIO_CMM920_LSIADDRESS_CRC_CALC_INVERSE, CONEXIO_CMM920_SET_READING_READ, &value );
+		if( iRet ) return iRet;
+		ctx->crc_inverse = ( value != 0 );
+	}
+
+	ctx->crc_check = mode;
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_set_crc_check_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_crc_check_h を実行する関数
+**/
+int conexio_cmm920_set_crc_check( int mode )
+{
+	return conexio_cmm920_set_crc_check_h( &global_default_context, mode );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Reset Statistics Function
+	@param ctx : instance handle
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の統計をクリアする関数
+	@param ctx : インスタンスハンドル
+	@par フレームプールの統計は全インスタンスで共有のため、他のインスタンスの値もクリアされます。
+**/
+void conexio_cmm920_reset_stat_h( CONEXIO920HANDLE ctx )
+{
+	memset( &ctx->stat, 0, sizeof(ctx->stat) );
+	ctx->recv_queue_drop = 0;
+	global_frame_get = 0;
+	global_frame_empty = 0;
+	global_frame_peak = global_frame_in_use;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_reset_stat_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_reset_stat_h を実行する関数
+**/
+void conexio_cmm920_reset_stat( void )
+{
+	conexio_cmm920_reset_stat_h( &global_default_context );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Set Wire Trace Level Function
+	@param level : CONEXIO_CMM920_TRACE_OFF, CONEXIO_CMM920_TRACE_RING or CONEXIO_CMM920_TRACE_TEXT
+	@return Success : 0 , Failed : -1
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の送受信トレースのレベルを設定する関数
+	@param level : CONEXIO_CMM920_TRACE_OFF, CONEXIO_CMM920_TRACE_RING or CONEXIO_CMM920_TRACE_TEXT
+	@return 成功:  0 失敗 :  -1
+	@par OFF : トレースなし, RING : リングバッファに記録, TEXT : リングバッファに記録し、syslog にも出力 ( 回数制限あり )
+**/
+int conexio_cmm920_set_trace( int level )
+{
+	if( level < CONEXIO_CMM920_TRACE_OFF || level > CONEXIO_CMM920_TRACE_TEXT ) return -1;
+
+	global_trace_level = level;
+	return 0;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Wire Trace Level Function
+	@return trace level
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の送受信トレースのレベルを取得する関数
+	@return トレースレベル
+**/
+int conexio_cmm920_get_trace( void )
+{
+	return global_trace_level;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Set Text Trace Rate Function
+	@param rate : maximum frames per second ( 0 : unlimited )
+	@return Success : 0 , Failed : -1
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の syslog トレースの上限を設定する関数
+	@param rate : 1秒あたりの最大フレーム数 ( 0 : 制限なし )
+	@return 成功:  0 失敗 :  -1
+**/
+int conexio_cmm920_set_trace_rate( int rate )
+{
+	if( rate < 0 ) return -1;
+
+	global_trace_rate = rate;
+	return 0;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Read Trace Ring Function
+	@param trace : trace buffer
+	@param num : number of trace buffer
+	@return number of traces ( older first )
+	@~Japanese
+	@brief CONEXIO 920MHz　Module のトレースをリングバッファから読み出す関数
+	@param trace : トレースバッファ
+	@param num : トレースバッファの数
+	@return 読み出したトレース数 ( 古い順 )
+	@par 読み出し中に上書きされたトレースは読み飛ばします。
+**/
+int conexio_cmm920_trace_read( PCONEXIO920TRACE trace, int num )
+{
+	PCONEXIO920TRACE ent;
+	unsigned long last, seq;
+	int count = 0;
+
+	if( trace == NULL || num <= 0 ) return 0;
+
+	last = global_trace_seq;
+	if( num > CONEXIO_CMM920_TRACE_RING_NUM ) num = CONEXIO_CMM920_TRACE_RING_NUM;
+	if( (unsigned long)num > last ) num = (int)last;
+
+	for( seq = last - num + 1; seq <= last; seq++ ){
+		ent = &global_trace_ring[( seq - 1 ) & ( CONEXIO_CMM920_TRACE_RING_NUM - 1 )];
+		if( ent->seq != seq ) continue;
+		__sync_synchronize();
+		trace[count] = *ent;
+		__sync_synchronize();
+		if( ent->seq != seq ) continue;
+		count++;
+	}
+
+	return count;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Dump Trace Ring Function
+	@return number of traces
+	@~Japanese
+	@brief CONEXIO 920MHz　Module のトレースを syslog に出力する関数
+	@return 出力したトレース数
+**/
+int conexio_cmm920_trace_dump( void )
+{
+	static CONEXIO920TRACE trace[CONEXIO_CMM920_TRACE_RING_NUM];
+	int count, i;
+
+	count = conexio_cmm920_trace_read( trace, CONEXIO_CMM920_TRACE_RING_NUM );
+	for( i = 0; i < count; i++ ){
+		_conexio_cmm920_trace_syslog( &trace[i], NULL );
+	}
+
+	return count;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Start Receive Thread Function
+	@param ctx : instance handle
+	@param callback : telegram callback function ( NULL : received telegrams are queued for conexio_cmm920_data_recv )
+	@param arg : callback argument
+	@return Success : 0 , Failed : -1
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の受信スレッドを開始する関数
+	@param ctx : インスタンスハンドル
+	@param callback : 受信データのコールバック関数 ( NULL : 受信データをキューに入れ conexio_cmm920_data_recv で受け取る )
+	@param arg : コールバック関数の引数
+	@return 成功:  0 失敗 :  -1
+	@par 受信スレッドがシリアルポートの受信を行い、コマンドの応答と無線の受信データを振り分けます。
+	@par 動作中は送信前に受信バッファを破棄しません。送信と受信を別のスレッドから同時に行えます。
+	@par キューから受け取るスレッドは1つにしてください。コールバック関数は受信スレッドから呼ばれます。
+**/
+int conexio_cmm920_start_recv_thread_h( CONEXIO920HANDLE ctx, CONEXIO920RECVCALLBACK callback, void *arg )
+{
+	pthread_condattr_t attr;
+
+	if( ctx->recv_thread_active || ctx->iPort <= 0 ) return -1;
+
+	ctx->recv_callback = callback;
+	ctx->recv_callback_arg = arg;
+	ctx->recv_queue_head = 0;
+	ctx->recv_queue_tail = 0;
+	ctx->recv_queue_drop = 0;
+	memset( ctx->recv_ack_length, 0, sizeof(ctx->recv_ack_length) );
+	ctx->recv_thread_stop = 0;
+
+	pthread_condattr_init( &attr );
+	pthread_condattr_setclock( &attr, CLOCK_MONOTONIC );
+	pthread_cond_init( &ctx->recv_cond, &attr );
+	pthread_condattr_destroy( &attr );
+
+	ctx->recv_thread_active = 1;
+	if( pthread_create( &ctx->recv_thread, NULL, _conexio_cmm920_recv_thread, ctx ) != 0 ){
+		ctx->recv_thread_active = 0;
+		pthread_cond_destroy( &ctx->recv_cond );
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_start_recv_thread_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_start_recv_thread_h を実行する関数
+**/
+int conexio_cmm920_start_recv_thread( CONEXIO920RECVCALLBACK callback, void *arg )
+{
+	return conexio_cmm920_start_recv_thread_h( &global_default_context, callback, arg );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Stop Receive Thread Function
+	@param ctx : instance handle
+	@return Success : 0
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の受信スレッドを停止する関数
+	@param ctx : インスタンスハンドル
+	@return 成功:  0
+**/
+int conexio_cmm920_stop_recv_thread_h( CONEXIO920HANDLE ctx )
+{
+	if( !ctx->recv_thread_active ) return 0;
+
+	ctx->recv_thread_stop = 1;
+	pthread_join( ctx->recv_thread, NULL );
+	ctx->recv_thread_active = 0;
+	pthread_cond_destroy( &ctx->recv_cond );
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_stop_recv_thread_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_stop_recv_thread_h を実行する関数
+**/
+int conexio_cmm920_stop_recv_thread( void )
+{
+	return conexio_cmm920_stop_recv_thread_h( &global_default_context );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Dropped Telegram Count Function
+	@param ctx : instance handle
+	@return number of telegrams dropped because the queue was full
+	@~Japanese
+	@brief CONEXIO 920MHz　Module のキューが一杯で破棄した受信データ数を取得する関数
+	@param ctx : インスタンスハンドル
+	@return 破棄した受信データ数
+**/
+unsigned long conexio_cmm920_get_recv_drop_count_h( CONEXIO920HANDLE ctx )
+{
+	return ctx->recv_queue_drop;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_get_recv_drop_count_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_recv_drop_count_h を実行する関数
+**/
+unsigned long conexio_cmm920_get_recv_drop_count( void )
+{
+	return conexio_cmm920_get_recv_drop_count_h( &global_default_context );
+}
+
+/**
+	@~English
+	@brief transmit queue thread function
+	@param arg : not used
+	@return NULL
+	@~Japanese
+	@brief 送信キューのスレッド関数
+	@param arg : 未使用
+	@return NULL
+	@par 応答待ちが上限未満なら優先度の高い順、同じ優先度は古い順に送信し、タイムアウトしたものは再送します。
+	@par 送信時間の予算がなければ、予算ができるまで送信を延ばします。
+**/
+static void* _conexio_cmm920_txq_thread( void *arg )
+{
+	CONEXIO920HANDLE ctx = (CONEXIO920HANDLE)arg;
+	CONEXIO920TXQENTRY send;
+	PCONEXIO920TXQENTRY ent;
+	PCONEXIO920TXQSTAT stat;
+	CONEXIO920TXCALLBACK callback;
+	struct timespec now, deadline;
+	int done_id[CONEXIO_CMM920_TXQ_NUM];
+	int done_result[CONEXIO_CMM920_TXQ_NUM];
+	int done_num;
+	int inflight, i, iRet, retry, defer;
+
+	pthread_mutex_lock( &ctx->txq_mutex );
+
+	while( !ctx->txq_stop ){
+		clock_gettime( CLOCK_MONOTONIC, &now );
+		done_num = 0;
+		inflight = 0;
+		ent = NULL;
+
+		for( i = 0; i < CONEXIO_CMM920_TXQ_NUM; i++ ){
+			if( ctx->txq[i].state == CONEXIO_CMM920_TXQ_INFLIGHT ){
+				// タイムアウトの確認
+				if( _conexio_cmm920_diff_usec( &ctx->txq[i].send_time, &now ) < ctx->txq[i].timeout ){
+					inflight++;
+					continue;
+				}
+				_conexio_cmm920_link_result( ctx, ctx->txq[i].dest_addr, -1 );
+				_conexio_cmm920_link_policy( ctx, ctx->txq[i].dest_addr, &retry, NULL );
+				stat = _conexio_cmm920_txq_stat( ctx, ctx->txq[i].dest_addr );
+				if( ctx->txq[i].retry < retry ){
+					ctx->txq[i].retry++;
+					ctx->txq[i].state = CONEXIO_CMM920_TXQ_PENDING;
+					if( stat != NULL ) stat->retry++;
+				}else{
+					ctx->txq[i].state = CONEXIO_CMM920_TXQ_FREE;
+					if( stat != NULL ){
+						stat->timeout++;
+						stat->depth--;
+					}
+					done_id[done_num] = ctx->txq[i].id;
+					done_result[done_num++] = -7;
+				}
+			}
+			if( ctx->txq[i].state == CONEXIO_CMM920_TXQ_PENDING ){
+				if( ent == NULL || ctx->txq[i].priority > ent->priority ||
+					( ctx->txq[i].priority == ent->priority && ctx->txq[i].order < ent->order ) ) ent = &ctx->txq[i];
+			}
+		}
+
+		// 送信時間の予算の確認 ( 予算がなければ未送信のデータはすべて次の確認まで待つ )
+		if( ent != NULL && inflight < ctx->txq_window ){
+			defer = 0;
+			for( i = 0; i < CONEXIO_CMM920_TXQ_NUM; i++ ){
+				if( ctx->txq[i].state == CONEXIO_CMM920_TXQ_PENDING && !ctx->txq[i].deferred ) defer++;
+			}
+			if( _conexio_cmm920_airtime_check( ctx, ent->size, 0, defer ) > 0 ){
+				for( i = 0; i < CONEXIO_CMM920_TXQ_NUM; i++ ){
+					if( ctx->txq[i].state == CONEXIO_CMM920_TXQ_PENDING ) ctx->txq[i].deferred = 1;
+				}
+				ent = NULL;
+			}
+		}
+
+		// 送信 ( 応答待ちが上限未満の場合 )
+		if( ent != NULL && inflight < ctx->txq_window ){
+			send = *ent;
+			ent->state = CONEXIO_CMM920_TXQ_INFLIGHT;
+			_conexio_cmm920_link_policy( ctx, ent->dest_addr, &retry, &ent->timeout );
+			clock_gettime( CLOCK_MONOTONIC, &ent->send_time );
+
+			pthread_mutex_unlock( &ctx->txq_mutex );
+			iRet = _conexio_cmm920_send_telegram( ctx, send.data, send.size, CONEXIO_CMM920_HOP_MULTI, send.send_mode,
+				&send.dest_id, &send.src_id, &send.dest_addr, &send.src_addr, &send.seq_no );
+			pthread_mutex_lock( &ctx->txq_mutex );
+
+			if( iRet == -9 && ent->state == CONEXIO_CMM920_TXQ_INFLIGHT && ent->id == send.id ){
+				// 確認後に他の送信が予算を使ったため未送信に戻す
+				ent->state = CONEXIO_CMM920_TXQ_PENDING;
+				ent->deferred = 1;
+			}else if( ent->state == CONEXIO_CMM920_TXQ_INFLIGHT && ent->id == send.id ){
+				ent->seq_no = send.seq_no;
+				stat = _conexio_cmm920_txq_stat( ctx, ent->dest_addr );
+				if( stat != NULL ) stat->sent++;
+
+				// 送信エラー、または応答なしの送信モードはここで完了
+				if( iRet != 0 || !( send.send_mode & CONEXIO_CMM920_SENDDATA_MODE_RESP ) ){
+					ent->state = CONEXIO_CMM920_TXQ_FREE;
+					if( stat != NULL ) stat->depth--;
+					done_id[done_num] = ent->id;
+					done_result[done_num++] = iRet;
+				}
+			}
+			if( done_num == 0 ) continue;
+		}
+
+		if( done_num > 0 ){
+			callback = ctx->txq_callback;
+			pthread_cond_broadcast( &ctx->txq_cond );
+			pthread_mutex_unlock( &ctx->txq_mutex );
+			for( i = 0; i < done_num && callback != NULL; i++ ){
+				callback( done_id[i], done_result[i], NULL, 0, ctx->txq_callback_arg );
+			}
+			pthread_mutex_lock( &ctx->txq_mutex );
+			continue;
+		}
+
+		clock_gettime( CLOCK_MONOTONIC, &deadline );
+		_conexio_cmm920_add_msec( &deadline, CONEXIO_CMM920_TXQ_POLL_MSEC );
+		pthread_cond_timedwait( &ctx->txq_cond, &ctx->txq_mutex, &deadline );
+	}
+
+	pthread_mutex_unlock( &ctx->txq_mutex );
+
+	return NULL;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Start Transmit Queue Function
+	@param ctx : instance handle
+	@param window : maximum number of telegrams waiting for the response
+	@param timeout_msec : response timeout (msec)
+	@param retry : maximum number of retries
+	@param callback : completion callback function ( NULL : not used )
+	@param arg : callback argument
+	@return Success : 0 , Failed : -1
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の送信キューを開始する関数
+	@param ctx : インスタンスハンドル
+	@param window : 応答待ちの最大数
+	@param timeout_msec : 応答待ちタイムアウト時間 (msec)
+	@param retry : 最大再送回数
+	@param callback : 完了コールバック関数 ( NULL : 未使用 )
+	@param arg : コールバック関数の引数
+	@return 成功:  0 失敗 :  -1
+	@par マルチホップ用です。受信スレッドが動作していなければ開始します。
+	@par 応答はシーケンス番号と送信元アドレスで照合します。照合した応答はコールバック関数へ渡し、受信キューには入れません。
+	@par conexio_cmm920_set_link_adaptive が ON の場合、送信先ごとの再送回数と応答待ち時間は通信品質から決めます。
+**/
+int conexio_cmm920_txq_start_h( CONEXIO920HANDLE ctx, int window, int timeout_msec, int retry, CONEXIO920TXCALLBACK callback, void *arg )
+{
+	pthread_condattr_t attr;
+
+	if( ctx->txq_active || window <= 0 || timeout_msec <= 0 || retry < 0 ) return -1;
+
+	if( !ctx->recv_thread_active ){
+		if( conexio_cmm920_start_recv_thread_h( ctx, NULL, NULL ) ) return -1;
+	}
+
+	ctx->txq_window = window;
+	ctx->txq_timeout_msec = timeout_msec;
+	ctx->txq_retry = retry;
+	ctx->txq_callback = callback;
+	ctx->txq_callback_arg = arg;
+	ctx->txq_stop = 0;
+	memset( ctx->txq, 0, sizeof(ctx->txq) );
+
+	pthread_condattr_init( &attr );
+	pthread_condattr_setclock( &attr, CLOCK_MONOTONIC );
+	pthread_cond_init( &ctx->txq_cond, &attr );
+	pthread_condattr_destroy( &attr );
+
+	ctx->txq_active = 1;
+	if( pthread_create( &ctx->txq_thread, NULL, _conexio_cmm920_txq_thread, ctx ) != 0 ){
+		ctx->txq_active = 0;
+		pthread_cond_destroy( &ctx->txq_cond );
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_txq_start_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_txq_start_h を実行する関数
+**/
+int conexio_cmm920_txq_start( int window, int timeout_msec, int retry, CONEXIO920TXCALLBACK callback, void *arg )
+{
+	return conexio_cmm920_txq_start_h( &global_default_context, window, timeout_msec, retry, callback, arg );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Stop Transmit Queue Function
+	@param ctx : instance handle
+	@return Success : 0
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の送信キューを停止する関数
+	@param ctx : インスタンスハンドル
+	@return 成功:  0
+	@par 未送信と応答待ちのデータは破棄します。
+**/
+int conexio_cmm920_txq_stop_h( CONEXIO920HANDLE ctx )
+{
+	if( !ctx->txq_active ) return 0;
+
+	pthread_mutex_lock( &ctx->txq_mutex );
+	ctx->txq_stop = 1;
+	pthread_cond_broadcast( &ctx->txq_cond );
+	pthread_mutex_unlock( &ctx->txq_mutex );
+
+	pthread_join( ctx->txq_thread, NULL );
+	ctx->txq_active = 0;
+	pthread_cond_destroy( &ctx->txq_cond );
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_txq_stop_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_txq_stop_h を実行する関数
+**/
+int conexio_cmm920_txq_stop( void )
+{
+	return conexio_cmm920_txq_stop_h( &global_default_context );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Queue Telegram with Priority Function
+	@param ctx : instance handle
+	@param buf : send data buffer
+	@param size : send data size
+	@param send_mode : send mode
+	@param dest_id : dest PAN ID
+	@param src_id : source PAN ID
+	@param dest_addr : Dest Address
+	@param src_addr : Source Address
+	@param priority : priority ( 0 - 255, higher first )
+	@return Success : request id ( 0 or more ) , Failed : Parameter Error : -1, Queue full : -2, Not started : -3
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の送信キューに優先度付きでデータを追加する関数
+	@param ctx : インスタンスハンドル
+	@param buf : 送信データバッファ
+	@param size : 送信データサイズ
+	@param send_mode : 送信モード
+	@param dest_id : 送信先PAN　ID
+	@param src_id : 送信元 PAN ID
+	@param dest_addr : 送信先アドレス
+	@param src_addr : 送信元アドレス
+	@param priority : 優先度 ( 0～255, 大きい方が先 )
+	@return 成功:  要求ID ( 0以上 ) 失敗 :  パラメータエラー : -1, キューに空きなし : -2, 未開始 : -3
+	@par 完了 ( 応答受信, 送信エラー, タイムアウト ) はコールバック関数に要求IDで通知します。
+	@par 優先度の高いデータから送信します。再送も同じ優先度で行います。
+**/
+int conexio_cmm920_txq_send_priority_h( CONEXIO920HANDLE ctx, BYTE buf[], int size, int send_mode, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr, int priority )
+{
+	PCONEXIO920TXQSTAT stat;
+	int i, id;
+
+	if( !ctx->txq_active ) return -3;
+	if( buf == NULL || size < 0 || size > CONEXIO_CMM920_FRAME_DATA_MAX - 16 ) return -1;
+	if( priority < 0 || priority > 255 ) return -1;
+
+	pthread_mutex_lock( &ctx->txq_mutex );
+
+	for( i = 0; i < CONEXIO_CMM920_TXQ_NUM; i++ ){
+		if( ctx->txq[i].state == CONEXIO_CMM920_TXQ_FREE ) break;
+	}
+	if( i == CONEXIO_CMM920_TXQ_NUM ){
+		pthread_mutex_unlock( &ctx->txq_mutex );
+		return -2;
+	}
+
+	id = ctx->txq_next_id;
+	ctx->txq_next_id = ( ctx->txq_next_id + 1 ) & 0x7FFFFFFF;
+
+	ctx->txq[i].id = id;
+	ctx->txq[i].order = ctx->txq_order++;
+	ctx->txq[i].priority = priority;
+	ctx->txq[i].deferred = 0;
+	ctx->txq[i].send_mode = send_mode;
+	ctx->txq[i].dest_id = dest_id;
+	ctx->txq[i].src_id = src_id;
+	ctx->txq[i].dest_addr = dest_addr;
+	ctx->txq[i].src_addr = src_addr;
+	ctx->txq[i].retry = 0;
+	ctx->txq[i].size = size;
+	memcpy( ctx->txq[i].data, buf, size );
+	ctx->txq[i].state = CONEXIO_CMM920_TXQ_PENDING;
+
+	stat = _conexio_cmm920_txq_stat( ctx, dest_addr );
+	if( stat != NULL ) stat->depth++;
+
+	pthread_cond_broadcast( &ctx->txq_cond );
+	pthread_mutex_unlock( &ctx->txq_mutex );
+
+	return id;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_txq_send_priority_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_txq_send_priority_h を実行する関数
+**/
+int conexio_cmm920_txq_send_priority( BYTE buf[], int size, int send_mode, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr, int priority )
+{
+	return conexio_cmm920_txq_send_priority_h( &global_default_context, buf, size, send_mode, dest_id, src_id, dest_addr, src_addr, priority );
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_txq_send_priority_h with the normal priority
+	@~Japanese
+	@brief 通常の優先度で conexio_cmm920_txq_send_priority_h を実行する関数
+**/
+int conexio_cmm920_txq_send_h( CONEXIO920HANDLE ctx, BYTE buf[], int size, int send_mode, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr )
+{
+	return conexio_cmm920_txq_send_priority_h( ctx, buf, size, send_mode, dest_id, src_id, dest_addr, src_addr, CONEXIO_CMM920_TXQ_PRIORITY_NORMAL );
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_txq_send_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_txq_send_h を実行する関数
+**/
+int conexio_cmm920_txq_send( BYTE buf[], int size, int send_mode, unsigned short dest_id, unsigned short src_id, long dest_addr, long src_addr )
+{
+	return conexio_cmm920_txq_send_h( &global_default_context, buf, size, send_mode, dest_id, src_id, dest_addr, src_addr );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Transmit Queue Depth Function
+	@param ctx : instance handle
+	@param pending : number of telegrams waiting to be sent
+	@param inflight : number of telegrams waiting for the response
+	@return Success : 0
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の送信キューの数を取得する関数
+	@param ctx : インスタンスハンドル
+	@param pending : 未送信の数
+	@param inflight : 応答待ちの数
+	@return 成功:  0
+**/
+int conexio_cmm920_txq_get_depth_h( CONEXIO920HANDLE ctx, int *pending, int *inflight )
+{
+	int i, p = 0, f = 0;
+
+	pthread_mutex_lock( &ctx->txq_mutex );
+	for( i = 0; i < CONEXIO_CMM920_TXQ_NUM; i++ ){
+		if( ctx->txq[i].state == CONEXIO_CMM920_TXQ_PENDING ) p++;
+		else if( ctx->txq[i].state == CONEXIO_CMM920_TXQ_INFLIGHT ) f++;
+	}
+	pthread_mutex_unlock( &ctx->txq_mutex );
+
+	if( pending != NULL ) *pending = p;
+	if( inflight != NULL ) *inflight = f;
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_txq_get_depth_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_txq_get_depth_h を実行する関数
+**/
+int conexio_cmm920_txq_get_depth( int *pending, int *inflight )
+{
+	return conexio_cmm920_txq_get_depth_h( &global_default_context, pending, inflight );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Transmit Queue Statistics Function
+	@param ctx : instance handle
+	@param dest_addr : dest address
+	@param stat : statistics
+	@return Success : 0 , Failed : -1 ( no statistics for the destination )
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の送信先ごとの送信キュー統計を取得する関数
+	@param ctx : インスタンスハンドル
+	@param dest_addr : 送信先アドレス
+	@param stat : 統計
+	@return 成功:  0 失敗 :  -1 ( 送信先の統計なし )
+**/
+int conexio_cmm920_txq_get_stat_h( CONEXIO920HANDLE ctx, long dest_addr, PCONEXIO920TXQSTAT stat )
+{
+	int i;
+	int iRet = -1;
+
+	if( stat == NULL ) return -1;
+
+	pthread_mutex_lock( &ctx->txq_mutex );
+	for( i = 0; i < ctx->txq_stat_num; i++ ){
+		if( ctx->txq_stat[i].dest_addr == dest_addr ){
+			*stat = ctx->txq_stat[i];
+			iRet = 0;
+			break;
+		}
+	}
+	pthread_mutex_unlock( &ctx->txq_mutex );
+
+	return iRet;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_txq_get_stat_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_txq_get_stat_h を実行する関数
+**/
+int conexio_cmm920_txq_get_stat( long dest_addr, PCONEXIO920TXQSTAT stat )
+{
+	return conexio_cmm920_txq_get_stat_h( &global_default_context, dest_addr, stat );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Set Adaptive Retry Function
+	@param ctx : instance handle
+	@param mode : CONEXIO_CMM920_LINK_ADAPTIVE_OFF or CONEXIO_CMM920_LINK_ADAPTIVE_ON
+	@return Success : 0 , Failed : -1
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の送信キューの再送を通信品質に合わせるか設定する関数
+	@param ctx : インスタンスハンドル
+	@param mode : CONEXIO_CMM920_LINK_ADAPTIVE_OFF or CONEXIO_CMM920_LINK_ADAPTIVE_ON
+	@return 成功:  0 失敗 :  -1
+	@par ON ( 初期値 ) の場合、送信先ごとの損失率から再送回数 ( 1～8 回 ) を、往復時間から応答待ち時間 ( 100msec～txq_start のタイムアウト時間 ) を決めます。
+	@par 送信回数が少ない送信先は txq_start の再送回数とタイムアウト時間を使用します。
+	@par OFF の場合は常に txq_start の再送回数とタイムアウト時間を使用します。
+**/
+int conexio_cmm920_set_link_adaptive_h( CONEXIO920HANDLE ctx, int mode )
+{
+	if( mode != CONEXIO_CMM920_LINK_ADAPTIVE_OFF && mode != CONEXIO_CMM920_LINK_ADAPTIVE_ON ) return -1;
+
+	ctx->link_adaptive = mode;
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_set_link_adaptive_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_link_adaptive_h を実行する関数
+**/
+int conexio_cmm920_set_link_adaptive( int mode )
+{
+	return conexio_cmm920_set_link_adaptive_h( &global_default_context, mode );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Link Quality Function
+	@param ctx : instance handle
+	@param addr : node address
+	@param link : link quality
+	@return Success : 0 , Failed : -1 ( no link quality for the node )
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の通信相手ごとの通信品質を取得する関数
+	@param ctx : インスタンスハンドル
+	@param addr : 通信相手のアドレス
+	@param link : 通信品質
+	@return 成功:  0 失敗 :  -1 ( 通信相手の通信品質なし )
+	@par 受信強度はマルチホップで受信したデータ ( RecvTelegram, 送信キュー, 分割転送 ) の送信元アドレスごとに記録します。
+	@par 損失率と往復時間は送信キューの送信先ごとに記録します。
+**/
+int conexio_cmm920_get_link_h( CONEXIO920HANDLE ctx, long addr, PCONEXIO920LINK link )
+{
+	int i;
+	int iRet = -1;
+
+	if( link == NULL ) return -1;
+
+	pthread_mutex_lock( &ctx->link_mutex );
+	for( i = 0; i < ctx->link_num; i++ ){
+		if( ctx->link[i].addr == addr ){
+			*link = ctx->link[i];
+			iRet = 0;
+			break;
+		}
+	}
+	pthread_mutex_unlock( &ctx->link_mutex );
+
+	return iRet;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_get_link_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_link_h を実行する関数
+**/
+int conexio_cmm920_get_link( long addr, PCONEXIO920LINK link )
+{
+	return conexio_cmm920_get_link_h( &global_default_context, addr, link );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Link Quality List Function
+	@param ctx : instance handle
+	@param link : link quality array
+	@param num : number of array elements
+	@return number of nodes
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の全ての通信相手の通信品質を取得する関数
+	@param ctx : インスタンスハンドル
+	@param link : 通信品質の配列
+	@param num : 配列の要素数
+	@return 通信相手の数
+	@par 戻り値が num より大きい場合、 num 個まで格納します。
+**/
+int conexio_cmm920_get_link_list_h( CONEXIO920HANDLE ctx, PCONEXIO920LINK link, int num )
+{
+	int i, count;
+
+	pthread_mutex_lock( &ctx->link_mutex );
+	count = ctx->link_num;
+	for( i = 0; i < count && i < num && link != NULL; i++ ){
+		link[i] = ctx->link[i];
+	}
+	pthread_mutex_unlock( &ctx->link_mutex );
+
+	return count;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_get_link_list_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_link_list_h を実行する関数
+**/
+int conexio_cmm920_get_link_list( PCONEXIO920LINK link, int num )
+{
+	return conexio_cmm920_get_link_list_h( &global_default_context, link, num );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Reset Link Quality Function
+	@param ctx : instance handle
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の通信品質をクリアする関数
+	@param ctx : インスタンスハンドル
+**/
+void conexio_cmm920_reset_link_h( CONEXIO920HANDLE ctx )
+{
+	pthread_mutex_lock( &ctx->link_mutex );
+	ctx->link_num = 0;
+	pthread_mutex_unlock( &ctx->link_mutex );
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_reset_link_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_reset_link_h を実行する関数
+**/
+void conexio_cmm920_reset_link( void )
+{
+	conexio_cmm920_reset_link_h( &global_default_context );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Airtime of a Telegram Function
+	@param ctx : instance handle
+	@param size : send data size ( without MHR )
+	@return airtime (usec) , Failed : -1
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の電文の送信時間を計算する関数
+	@param ctx : インスタンスハンドル
+	@param size : 送信データサイズ ( MHR を除く )
+	@return 成功:  送信時間 (usec) 失敗 :  -1
+	@par 無線設定のビットレートから、プリアンブル、SFD、PHR、MHR、FCS を含む時間を計算します。
+**/
+long conexio_cmm920_airtime_usec_h( CONEXIO920HANDLE ctx, int size )
+{
+	long air;
+
+	if( size < 0 ) return -1;
+
+	pthread_mutex_lock( &ctx->airtime_mutex );
+	air = _conexio_cmm920_airtime( ctx->airtime_bitrate, size );
+	pthread_mutex_unlock( &ctx->airtime_mutex );
+
+	return air;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_airtime_usec_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_airtime_usec_h を実行する関数
+**/
+long conexio_cmm920_airtime_usec( int size )
+{
+	return conexio_cmm920_airtime_usec_h( &global_default_context, size );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Set Airtime Budget Function
+	@param ctx : instance handle
+	@param window_msec : budget window (msec)
+	@param budget_msec : airtime budget in the window (msec) ( 0 : no limit )
+	@return Success : 0 , Failed : -1
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の送信時間の予算を設定する関数
+	@param ctx : インスタンスハンドル
+	@param window_msec : 予算の期間 (msec)
+	@param budget_msec : 期間内の送信時間の予算 (msec) ( 0 : 制限なし )
+	@return 成功:  0 失敗 :  -1
+	@par 直近の期間内の送信時間が予算を超える送信は、データ送信関数では -9 を返し、送信キューでは予算ができるまで延ばします。
+	@par 期間は 64 のスロットで管理するため、送信時間は最大 1 スロット ( 期間 / 64 ) 長く数えます。
+	@par 期間を変更すると使用時間の記録は消去されます。初期値は期間 1 時間、制限なしです。
+**/
+int conexio_cmm920_set_airtime_budget_h( CONEXIO920HANDLE ctx, long window_msec, long budget_msec )
+{
+	if( window_msec <= 0 || budget_msec < 0 || budget_msec > window_msec ) return -1;
+
+	pthread_mutex_lock( &ctx->airtime_mutex );
+	if( window_msec != ctx->airtime_window_msec ){
+		ctx->airtime_window_msec = window_msec;
+		ctx->airtime_slot_usec = ( window_msec * 1000LL + CONEXIO_CMM920_AIRTIME_SLOT_NUM - 1 ) / CONEXIO_CMM920_AIRTIME_SLOT_NUM;
+		ctx->airtime_slot_no = 0;
+		memset( ctx->airtime_slot, 0, sizeof(ctx->airtime_slot) );
+		ctx->airtime_used = 0;
+	}
+	ctx->airtime_budget_msec = budget_msec;
+	pthread_mutex_unlock( &ctx->airtime_mutex );
+
+	// 延ばしている送信キューを再確認させる
+	pthread_mutex_lock( &ctx->txq_mutex );
+	if( ctx->txq_active ) pthread_cond_broadcast( &ctx->txq_cond );
+	pthread_mutex_unlock( &ctx->txq_mutex );
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_set_airtime_budget_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_airtime_budget_h を実行する関数
+**/
+int conexio_cmm920_set_airtime_budget( long window_msec, long budget_msec )
+{
+	return conexio_cmm920_set_airtime_budget_h( &global_default_context, window_msec, budget_msec );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Projected Airtime Wait Function
+	@param ctx : instance handle
+	@param size : send data size ( without MHR )
+	@param priority : transmit queue priority ( 0 - 255 )
+	@return projected wait until the telegram is sent (usec) , Failed : -1
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の送信までの予測待ち時間を取得する関数
+	@param ctx : インスタンスハンドル
+	@param size : 送信データサイズ ( MHR を除く )
+	@param priority : 送信キューの優先度 ( 0～255 )
+	@return 成功:  送信までの予測待ち時間 (usec) 失敗 :  -1
+	@par 送信キューで同じ優先度以上の未送信データの後に送信する場合の待ち時間です。応答待ちと再送は含みません。
+	@par 予算を超える分は、予算ごとに期間 1 つ分の待ち時間を加えて見積もります。
+	@par 待ち時間が長い場合は、データをまとめる、価値の低いデータを捨てるなどの判断に使用してください。
+**/
+long long conexio_cmm920_get_airtime_wait_h( CONEXIO920HANDLE ctx, int size, int priority )
+{
+	long long now, ahead, need, wait, budget;
+	long bitrate;
+
+	if( size < 0 || priority < 0 || priority > 255 ) return -1;
+
+	pthread_mutex_lock( &ctx->airtime_mutex );
+	bitrate = ctx->airtime_bitrate;
+	pthread_mutex_unlock( &ctx->airtime_mutex );
+
+	ahead = _conexio_cmm920_txq_airtime( ctx, bitrate, priority );
+
+	need = ahead + _conexio_cmm920_airtime( bitrate, size );
+
+	now = _conexio_cmm920_airtime_now();
+	pthread_mutex_lock( &ctx->airtime_mutex );
+	_conexio_cmm920_airtime_advance( ctx, now );
+	wait = _conexio_cmm920_airtime_wait( ctx, need, now );
+	budget = ctx->airtime_budget_msec * 1000LL;
+	if( budget > 0 && need > budget ){
+		wait += ( ( need - 1 ) / budget ) * ctx->airtime_window_msec * 1000LL;
+	}
+	pthread_mutex_unlock( &ctx->airtime_mutex );
+
+	return ( wait > ahead ) ? wait : ahead;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_get_airtime_wait_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_airtime_wait_h を実行する関数
+**/
+long long conexio_cmm920_get_airtime_wait( int size, int priority )
+{
+	return conexio_cmm920_get_airtime_wait_h( &global_default_context, size, priority );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Get Airtime Function
+	@param ctx : instance handle
+	@param airtime : airtime budget and statistics
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の送信時間の予算と統計を取得する関数
+	@param ctx : インスタンスハンドル
+	@param airtime : 送信時間の予算と統計
+**/
+void conexio_cmm920_get_airtime_h( CONEXIO920HANDLE ctx, PCONEXIO920AIRTIME airtime )
+{
+	long long now;
+	long bitrate;
+
+	if( airtime == NULL ) return;
+
+	pthread_mutex_lock( &ctx->airtime_mutex );
+	bitrate = ctx->airtime_bitrate;
+	pthread_mutex_unlock( &ctx->airtime_mutex );
+
+	airtime->queued_usec = _conexio_cmm920_txq_airtime( ctx, bitrate, 0 );
+
+	now = _conexio_cmm920_airtime_now();
+	pthread_mutex_lock( &ctx->airtime_mutex );
+	_conexio_cmm920_airtime_advance( ctx, now );
+	airtime->bitrate = ctx->airtime_bitrate;
+	airtime->window_msec = ctx->airtime_window_msec;
+	airtime->budget_msec = ctx->airtime_budget_msec;
+	airtime->used_usec = ctx->airtime_used;
+	airtime->sent = ctx->airtime_stat.sent;
+	airtime->total_usec = ctx->airtime_stat.total_usec;
+	airtime->rejected = ctx->airtime_stat.rejected;
+	airtime->deferred = ctx->airtime_stat.deferred;
+	pthread_mutex_unlock( &ctx->airtime_mutex );
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_get_airtime_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_airtime_h を実行する関数
+**/
+void conexio_cmm920_get_airtime( PCONEXIO920AIRTIME airtime )
+{
+	conexio_cmm920_get_airtime_h( &global_default_context, airtime );
+}
+
+/**
+	@~English
+	@brief Prepare the receive thread for fragmented transfer
+	@param ctx : instance handle
+	@return Success : 0 , Failed : -1
+	@~Japanese
+	@brief 分割転送用に受信スレッドを準備する関数
+	@param ctx : インスタンスハンドル
+	@return 成功:  0 失敗 :  -1
+	@par 受信スレッドが動作していなければ開始します。コールバック関数を使用している場合は受信キューを使えないため失敗します。
+**/
+static int _conexio_cmm920_xfer_prepare( CONEXIO920HANDLE ctx )
+{
+	if( !ctx->recv_thread_active ){
+		if( conexio_cmm920_start_recv_thread_h( ctx, NULL, NULL ) ) return -1;
+	}
+	if( ctx->recv_callback != NULL ) return -1;
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief Send a fragmented transfer telegram and wait for the send result
+	@param ctx : instance handle
+	@param data : telegram data
+	@param size : telegram data size
+	@param hop : hop mode
+	@param dest_id : dest PAN ID
+	@param src_id : source PAN ID
+	@param dest_addr : Dest Address
+	@param src_addr : Source Address
+	@return Success : 0 , Failed : _conexio_cmm920_send_telegram
+	@~Japanese
+	@brief 分割転送の電文を送信し、送信結果を待つ関数
+	@param ctx : インスタンスハンドル
+	@param data : 電文データ
+	@param size : 電文データサイズ
+	@param hop : ホップ・モード
+	@param dest_id : 送信先PAN　ID
+	@param src_id : 送信元 PAN ID
+	@param dest_addr : 送信先アドレス
+	@param src_addr : 送信元アドレス
+	@return 成功:  0 失敗 :  _conexio_cmm920_send_telegram の戻り値
+	@par モジュールは無線送信の完了後に送信結果を返すため、送信結果を待つことで送信間隔を調整します。送信結果が届かない場合も失敗にはしません。
+**/
+static int _conexio_cmm920_xfer_put( CONEXIO920HANDLE ctx, BYTE data[], int size, int hop,
+	unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr )
+{
+	struct timespec deadline;
+	int slot;
+	int iRet;
+
+	iRet = _conexio_cmm920_send_telegram( ctx, data, size, hop, CONEXIO_CMM920_SENDDATA_MODE_NOACK_NORESP,
+		dest_id, src_id, dest_addr, src_addr, NULL );
+	if( iRet ) return iRet;
+
+	clock_gettime( CLOCK_MONOTONIC, &deadline );
+	_conexio_cmm920_add_msec( &deadline, CONEXIO_CMM920_DEFAULT_TIMEOUT_MSEC );
+
+	slot = _conexio_cmm920_ack_index( CONEXIO_CMM920_MODE_RUN, CONEXIO_CMM920_SENDDATA );
+
+	pthread_mutex_lock( &ctx->recv_mutex );
+	while( ctx->recv_ack_length[slot] == 0 ){
+		if( pthread_cond_timedwait( &ctx->recv_cond, &ctx->recv_mutex, &deadline ) == ETIMEDOUT ) break;
+	}
+	ctx->recv_ack_length[slot] = 0;
+	pthread_mutex_unlock( &ctx->recv_mutex );
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief Receive a fragmented transfer telegram
+	@param ctx : instance handle
+	@param frame : receive frame ( frame pool )
+	@param payload : telegram data ( in frame )
+	@param size : telegram data size
+	@param hop : hop mode
+	@param deadline : deadline ( CLOCK_MONOTONIC )
+	@param dest_id : dest PAN ID
+	@param src_id : source PAN ID
+	@param dest_addr : Dest Address
+	@param src_addr : Source Address
+	@return Success : 0 , Failed : -7 ( timeout )
+	@~Japanese
+	@brief 分割転送の電文を受信する関数
+	@param ctx : インスタンスハンドル
+	@param frame : 受信フレーム ( フレームプール )
+	@param payload : 電文データ ( フレーム内 )
+	@param size : 電文データサイズ
+	@param hop : ホップ・モード
+	@param deadline : 期限 ( CLOCK_MONOTONIC )
+	@param dest_id : 送信先PAN　ID
+	@param src_id : 送信元 PAN ID
+	@param dest_addr : 送信先アドレス
+	@param src_addr : 送信元アドレス
+	@return 成功:  0 失敗 :  -7 ( タイムアウト )
+**/
+static int _conexio_cmm920_xfer_get( CONEXIO920HANDLE ctx, BYTE *frame, BYTE **payload, int *size, int hop, struct timespec *deadline,
+	unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr )
+{
+	CONEXIO920MHRVIEW view;
+	BYTE *data;
+	int length, d_size;
+
+	if( _conexio_cmm920_wait_frame( ctx, frame, &length, CONEXIO_CMM920_MODE_RUN, CONEXIO_CMM920_SENDDATA, deadline ) ) return -7;
+
+	data = &frame[CONEXIO_CMM920_FRAME_HEAD_SIZE];
+	d_size = data[3] * 256 + data[4] - 4;	// without crc
+	if( d_size < 0 ) d_size = 0;
+	*payload = &data[5];
+
+	if( hop == CONEXIO_CMM920_HOP_MULTI ){
+		if( conexio_cmm920_mhr_decode( *payload, d_size, &view ) < 0 ){
+			*payload += d_size;
+			d_size = 0;
+		}else{
+			if( dest_id != NULL ) *dest_id = view.dest_id;
+			if( src_id != NULL ) *src_id = view.src_id;
+			if( dest_addr != NULL ) *dest_addr = view.dest_addr;
+			if( src_addr != NULL ) *src_addr = view.src_addr;
+			_conexio_cmm920_link_recv( ctx, view.src_addr, _calc_Hex2Bcd( data[1] ), _conexio_cmm920_Hex2dBm( data[2] ) );
+			*payload = view.payload;
+			d_size = view.size;
+		}
+	}
+
+	*size = d_size;
+	return 0;
+}
+
+/**
+	@~English
+	@brief Initialize fragmented transfer receive structure
+	@param xfer : fragmented transfer receive structure
+	@param buf : reassembly buffer
+	@param capacity : reassembly buffer size
+	@return Success : 0 , Failed : -1
+	@~Japanese
+	@brief 分割転送の受信構造体を初期化する関数
+	@param xfer : 分割転送の受信構造体
+	@param buf : 再構成バッファ
+	@param capacity : 再構成バッファのサイズ
+	@return 成功:  0 失敗 :  -1
+	@par 再構成バッファは呼び出し側で確保してください。受信中にメモリは確保しません。
+**/
+int conexio_cmm920_xfer_init( PCONEXIO920XFER xfer, BYTE buf[], int capacity )
+{
+	if( xfer == NULL || buf == NULL || capacity <= 0 ) return -1;
+
+	memset( xfer, 0, sizeof(CONEXIO920XFER) );
+	xfer->buf = buf;
+	xfer->capacity = capacity;
+	xfer->id = -1;
+	xfer->done_id = -1;
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Fragmented Transfer Send Function
+	@param ctx : instance handle
+	@param buf : send data buffer
+	@param size : send data size ( 1 to CONEXIO_CMM920_XFER_SIZE_MAX )
+	@param hop : hop mode
+	@param dest_id : dest PAN ID
+	@param src_id : source PAN ID
+	@param dest_addr : Dest Address
+	@param src_addr : Source Address
+	@param window : number of fragments per acknowledge ( 1 to CONEXIO_CMM920_XFER_WINDOW_MAX )
+	@param timeout_msec : acknowledge timeout (msec)
+	@param retry : maximum number of consecutive acknowledge timeouts
+	@param stat : transfer statistics (option)
+	@return Success : 0 , Failed : -1 : Parameter Error, -7 : Timeout, From -16 to -31 Send Error
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の分割転送 送信 関数
+	@param ctx : インスタンスハンドル
+	@param buf : 送信データバッファ
+	@param size : 送信データサイズ ( 1 ～ CONEXIO_CMM920_XFER_SIZE_MAX )
+	@param hop : ホップ・モード
+	@param dest_id : 送信先PAN　ID
+	@param src_id : 送信元 PAN ID
+	@param dest_addr : 送信先アドレス
+	@param src_addr : 送信元アドレス
+	@param window : 確認応答までのフラグメント数 ( 1 ～ CONEXIO_CMM920_XFER_WINDOW_MAX )
+	@param timeout_msec : 確認応答のタイムアウト時間 (msec)
+	@param retry : 確認応答の連続タイムアウトの最大数
+	@param stat : 転送統計 (オプション)
+	@return 成功:  0 失敗 :  パラメータエラー : -1, タイムアウト : -7, 送信 エラー: -16～-31
+	@par データを CONEXIO_CMM920_XFER_FRAG_DATA バイトのフラグメントに分割して送信します。
+	@par window 個のフラグメント毎に確認応答を要求し、確認応答のビットマップで受信されていないフラグメントだけを再送します。
+	@par 転送中は受信スレッドの受信キューを使用します。確認応答以外の受信データは破棄します。
+**/
+int conexio_cmm920_xfer_send_h( CONEXIO920HANDLE ctx, BYTE buf[], int size, int hop, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr, int window, int timeout_msec, int retry, PCONEXIO920XFERSTAT stat )
+{
+	BYTE acked[CONEXIO_CMM920_XFER_FRAG_MAX / 8];
+	BYTE sent[CONEXIO_CMM920_XFER_FRAG_MAX / 8];
+	BYTE data[CONEXIO_CMM920_XFER_HEAD_SIZE + CONEXIO_CMM920_XFER_FRAG_DATA];
+	int list[CONEXIO_CMM920_XFER_WINDOW_MAX];
+	BYTE *frame, *payload;
+	CONEXIO920XFERSTAT st;
+	struct timespec start, now, deadline;
+	unsigned short r_dest_id, r_src_id;
+	long r_dest_addr, r_src_addr;
+	int count, base, num, tries, id;
+	int i, n, len, d_size;
+	int iRet = 0;
+
+	if( buf == NULL || size <= 0 || size > CONEXIO_CMM920_XFER_SIZE_MAX ||
+		window <= 0 || window > CONEXIO_CMM920_XFER_WINDOW_MAX || timeout_msec <= 0 || retry < 0 ) return -1;
+
+	if( _conexio_cmm920_xfer_prepare( ctx ) ) return -1;
+
+	frame = _conexio_cmm920_frame_get();
+	if( frame == (BYTE*)NULL ) return -17;
+
+	memset( &st, 0, sizeof(st) );
+	memset( acked, 0, sizeof(acked) );
+	memset( sent, 0, sizeof(sent) );
+
+	count = ( size + CONEXIO_CMM920_XFER_FRAG_DATA - 1 ) / CONEXIO_CMM920_XFER_FRAG_DATA;
+	id = ctx->xfer_id++;
+	st.bytes = size;
+	st.fragments = count;
+	clock_gettime( CLOCK_MONOTONIC, &start );
+
+	base = 0;
+	tries = 0;
+	while( base < count ){
+		// 確認応答されていないフラグメントを window 個まで送信
+		num = 0;
+		for( i = base; i < count && num < window; i++ ){
+			if( !( acked[i >> 3] & ( 1 << ( i & 7 ) ) ) ) list[num++] = i;
+		}
+
+		for( n = 0; n < num; n++ ){
+			i = list[n];
+			len = ( i == count - 1 ) ? size - i * CONEXIO_CMM920_XFER_FRAG_DATA : CONEXIO_CMM920_XFER_FRAG_DATA;
+
+			data[0] = ( n == num - 1 ) ? CONEXIO_CMM920_XFER_TYPE_DATA_ACKREQ : CONEXIO_CMM920_XFER_TYPE_DATA;
+			data[1] = (BYTE)id;
+			data[2] = ( i >> 8 ) & 0xFF;
+			data[3] = i & 0xFF;
+			data[4] = ( count >> 8 ) & 0xFF;
+			data[5] = count & 0xFF;
+			memcpy( &data[CONEXIO_CMM920_XFER_HEAD_SIZE], &buf[i * CONEXIO_CMM920_XFER_FRAG_DATA], len );
+
+			iRet = _conexio_cmm920_xfer_put( ctx, data, CONEXIO_CMM920_XFER_HEAD_SIZE + len, hop,
+				dest_id, src_id, dest_addr, src_addr );
+			if( iRet ) goto end;
+
+			st.sent++;
+			if( sent[i >> 3] & ( 1 << ( i & 7 ) ) ) st.retransmit++;
+			sent[i >> 3] |= ( 1 << ( i & 7 ) );
+		}
+
+		// 確認応答の受信
+		clock_gettime( CLOCK_MONOTONIC, &deadline );
+		_conexio_cmm920_add_msec( &deadline, timeout_msec );
+		do{
+			iRet = _conexio_cmm920_xfer_get( ctx, frame, &payload, &d_size, hop, &deadline,
+				&r_dest_id, &r_src_id, &r_dest_addr, &r_src_addr );
+		}while( iRet == 0 &&
+			( d_size < CONEXIO_CMM920_XFER_HEAD_SIZE + CONEXIO_CMM920_XFER_ACK_MAP ||
+			  payload[0] != CONEXIO_CMM920_XFER_TYPE_ACK || payload[1] != (BYTE)id ) );
+
+		if( iRet ){
+			st.timeout++;
+			if( ++tries > retry ){
+				iRet = -7;
+				goto end;
+			}
+			continue;
+		}
+		tries = 0;
+		st.ack++;
+
+		// base より前は受信済み、以降はビットマップ
+		n = ( payload[2] << 8 ) | payload[3];
+		for( i = base; i < n && i < count; i++ ){
+			acked[i >> 3] |= ( 1 << ( i & 7 ) );
+		}
+		for( i = 0; i < CONEXIO_CMM920_XFER_ACK_MAP * 8 && n + i < count; i++ ){
+			if( payload[CONEXIO_CMM920_XFER_HEAD_SIZE + ( i >> 3 )] & ( 1 << ( i & 7 ) ) ){
+				acked[( n + i ) >> 3] |= ( 1 << ( ( n + i ) & 7 ) );
+			}
+		}
+		while( base < count && ( acked[base >> 3] & ( 1 << ( base & 7 ) ) ) ) base++;
+	}
+
+end:
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	st.elapsed = _conexio_cmm920_diff_usec( &start, &now );
+	if( iRet == 0 && st.elapsed > 0 ) st.goodput = (long)( (long long)size * 8 * 1000000 / st.elapsed );
+
+	_conexio_cmm920_frame_put( frame );
+
+	if( stat != NULL ) *stat = st;
+
+	return iRet;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_xfer_send_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_xfer_send_h を実行する関数
+**/
+int conexio_cmm920_xfer_send( BYTE buf[], int size, int hop, unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr, int window, int timeout_msec, int retry, PCONEXIO920XFERSTAT stat )
+{
+	return conexio_cmm920_xfer_send_h( &global_default_context, buf, size, hop, dest_id, src_id, dest_addr, src_addr, window, timeout_msec, retry, stat );
+}
+
+/**
+	@~English
+	@brief Send a fragmented transfer acknowledge
+	@param ctx : instance handle
+	@param xfer : fragmented transfer receive structure
+	@param id : transfer id
+	@param count : number of fragments
+	@param complete : transfer is complete
+	@param hop : hop mode
+	@param dest_id : dest PAN ID
+	@param src_id : source PAN ID
+	@param dest_addr : Dest Address
+	@param src_addr : Source Address
+	@return Success : 0 , Failed : _conexio_cmm920_xfer_put
+	@~Japanese
+	@brief 分割転送の確認応答を送信する関数
+	@param ctx : インスタンスハンドル
+	@param xfer : 分割転送の受信構造体
+	@param id : 転送ID
+	@param count : フラグメント数
+	@param complete : 転送完了
+	@param hop : ホップ・モード
+	@param dest_id : 送信先PAN　ID
+	@param src_id : 送信元 PAN ID
+	@param dest_addr : 送信先アドレス
+	@param src_addr : 送信元アドレス
+	@return 成功:  0 失敗 :  _conexio_cmm920_xfer_put の戻り値
+**/
+static int _conexio_cmm920_xfer_ack( CONEXIO920HANDLE ctx, PCONEXIO920XFER xfer, int id, int count, int complete, int hop,
+	unsigned short *dest_id, unsigned short *src_id, long *dest_addr, long *src_addr )
+{
+	BYTE ack[CONEXIO_CMM920_XFER_HEAD_SIZE + CONEXIO_CMM920_XFER_ACK_MAP];
+	int base = 0;
+	int i;
+
+	memset( ack, 0, sizeof(ack) );
+
+	if( complete ){
+		base = count;
+	}else{
+		while( base < count && ( xfer->map[base >> 3] & ( 1 << ( base & 7 ) ) ) ) base++;
+		for( i = 0; i < CONEXIO_CMM920_XFER_ACK_MAP * 8 && base + i < count; i++ ){
+			if( xfer->map[( base + i ) >> 3] & ( 1 << ( ( base + i ) & 7 ) ) ){
+				ack[CONEXIO_CMM920_XFER_HEAD_SIZE + ( i >> 3 )] |= ( 1 << ( i & 7 ) );
+			}
+		}
+	}
+
+	ack[0] = CONEXIO_CMM920_XFER_TYPE_ACK;
+	ack[1] = (BYTE)id;
+	ack[2] = ( base >> 8 ) & 0xFF;
+	ack[3] = base & 0xFF;
+	ack[4] = ( count >> 8 ) & 0xFF;
+	ack[5] = count & 0xFF;
+
+	xfer->stat.ack++;
+
+	return _conexio_cmm920_xfer_put( ctx, ack, sizeof(ack), hop, dest_id, src_id, dest_addr, src_addr );
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Module Fragmented Transfer Receive Function
+	@param ctx : instance handle
+	@param xfer : fragmented transfer receive structure ( conexio_cmm920_xfer_init )
+	@param hop : hop mode
+	@param timeout_msec : fragment receive timeout (msec)
+	@return Success : 0 ( xfer->buf, xfer->size ) , Failed : -1 : Parameter Error, -3 : Buffer too small, -7 : Timeout, -17 : Frame pool empty
+	@~Japanese
+	@brief CONEXIO 920MHz　Module の分割転送 受信 関数
+	@param ctx : インスタンスハンドル
+	@param xfer : 分割転送の受信構造体 ( conexio_cmm920_xfer_init )
+	@param hop : ホップ・モード
+	@param timeout_msec : フラグメントの受信タイムアウト時間 (msec)
+	@return 成功:  0 ( xfer->buf, xfer->size ) 失敗 :  パラメータエラー : -1, バッファ不足 : -3, タイムアウト : -7, フレームプール不足 : -17
+	@par 順不同に届いたフラグメントを再構成バッファの位置に直接書き込み、すべて揃った時点で戻ります。
+	@par 確認応答は送信元に返します。タイムアウトで戻った場合も受信済みのフラグメントは保持し、次の呼び出しで転送を継続します。
+	@par 完了した転送のフラグメントを再度受信した場合は、完了の確認応答を再送します。
+**/
+int conexio_cmm920_xfer_recv_h( CONEXIO920HANDLE ctx, PCONEXIO920XFER xfer, int hop, int timeout_msec )
+{
+	BYTE *frame, *payload;
+	struct timespec deadline, now, start;
+	unsigned short r_dest_id, r_src_id;
+	long r_dest_addr, r_src_addr;
+	int id, index, count, len, d_size;
+	int iRet;
+
+	if( xfer == NULL || xfer->buf == NULL || timeout_msec <= 0 ) return -1;
+
+	if( _conexio_cmm920_xfer_prepare( ctx ) ) return -1;
+
+	frame = _conexio_cmm920_frame_get();
+	if( frame == (BYTE*)NULL ) return -17;
+
+	for(;;){
+		clock_gettime( CLOCK_MONOTONIC, &deadline );
+		_conexio_cmm920_add_msec( &deadline, timeout_msec );
+
+		iRet = _conexio_cmm920_xfer_get( ctx, frame, &payload, &d_size, hop, &deadline,
+			&r_dest_id, &r_src_id, &r_dest_addr, &r_src_addr );
+		if( iRet ) break;
+
+		if( d_size < CONEXIO_CMM920_XFER_HEAD_SIZE ||
+			( payload[0] != CONEXIO_CMM920_XFER_TYPE_DATA && payload[0] != CONEXIO_CMM920_XFER_TYPE_DATA_ACKREQ ) ) continue;
+
+		id = payload[1];
+		index = ( payload[2] << 8 ) | payload[3];
+		count = ( payload[4] << 8 ) | payload[5];
+		len = d_size - CONEXIO_CMM920_XFER_HEAD_SIZE;
+
+		// 完了済みの転送 ( 完了の確認応答が失われた )
+		if( id == xfer->done_id && id != xfer->id ){
+			if( payload[0] == CONEXIO_CMM920_XFER_TYPE_DATA_ACKREQ ){
+				_conexio_cmm920_xfer_ack( ctx, xfer, id, count, 1, hop, &r_src_id, &r_dest_id, &r_src_addr, &r_dest_addr );
+			}
+			continue;
+		}
+
+		// 新しい転送
+		if( id != xfer->id ){
+			if( count <= 0 || count > CONEXIO_CMM920_XFER_FRAG_MAX ) continue;
+			if( ( count - 1 ) * CONEXIO_CMM920_XFER_FRAG_DATA >= xfer->capacity ){
+				iRet = -3;
+				break;
+			}
+			xfer->id = id;
+			xfer->count = count;
+			xfer->received = 0;
+			xfer->size = 0;
+			memset( xfer->map, 0, sizeof(xfer->map) );
+			memset( &xfer->stat, 0, sizeof(xfer->stat) );
+			xfer->stat.fragments = count;
+			clock_gettime( CLOCK_MONOTONIC, &start );
+			xfer->start_sec = start.tv_sec;
+			xfer->start_nsec = start.tv_nsec;
+		}
+
+		if( count != xfer->count || index >= count || len > CONEXIO_CMM920_XFER_FRAG_DATA ||
+			index * CONEXIO_CMM920_XFER_FRAG_DATA + len > xfer->capacity ) continue;
+
+		if( xfer->map[index >> 3] & ( 1 << ( index & 7 ) ) ){
+			xfer->stat.duplicate++;
+		}else{
+			memcpy( &xfer->buf[index * CONEXIO_CMM920_XFER_FRAG_DATA], &payload[CONEXIO_CMM920_XFER_HEAD_SIZE], len );
+			xfer->map[index >> 3] |= ( 1 << ( index & 7 ) );
+			xfer->received++;
+			if( index == count - 1 ) xfer->size = index * CONEXIO_CMM920_XFER_FRAG_DATA + len;
+		}
+		xfer->stat.sent++;
+
+		if( xfer->received == count ){
+			_conexio_cmm920_xfer_ack( ctx, xfer, id, count, 1, hop, &r_src_id, &r_dest_id, &r_src_addr, &r_dest_addr );
+
+			start.tv_sec = xfer->start_sec;
+			start.tv_nsec = xfer->start_nsec;
+			clock_gettime( CLOCK_MONOTONIC, &now );
+			xfer->stat.bytes = xfer->size;
+			xfer->stat.elapsed = _conexio_cmm920_diff_usec( &start, &now );
+			if( xfer->stat.elapsed > 0 )
+				xfer->stat.goodput = (long)( (long long)xfer->size * 8 * 1000000 / xfer->stat.elapsed );
+			xfer->done_id = id;
+			xfer->id = -1;
+			iRet = 0;
+			break;
+		}
+
+		if( payload[0] == CONEXIO_CMM920_XFER_TYPE_DATA_ACKREQ ){
+			_conexio_cmm920_xfer_ack( ctx, xfer, id, count, 0, hop, &r_src_id, &r_dest_id, &r_src_addr, &r_dest_addr );
+		}
+	}
+
+	_conexio_cmm920_frame_put( frame );
+
+	return iRet;
+}
+
+/**
+	@~English
+	@brief conexio_cmm920_xfer_recv_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_xfer_recv_h を実行する関数
+**/
+int conexio_cmm920_xfer_recv( PCONEXIO920XFER xfer, int hop, int timeout_msec )
+{
+	return conexio_cmm920_xfer_recv_h( &global_default_context, xfer, hop, timeout_msec );
+}
 
 /**
 	@~English
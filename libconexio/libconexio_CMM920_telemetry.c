@@ -0,0 +1,411 @@
+/***
+
+	libconexio_CMM920_telemetry.c - conexio_CMM920_Telemetry functions library
+	Copyright (C) 2026 CONTEC.CO.,Ltd.
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, see
+   <http://www.gnu.org/licenses/>.
+
+	create 2026.10.19 (1) Added telemetry encoder and decoder.
+
+	Frame format
+	  flags(1) seq(1) ref_seq(1) [ channel bitmap ] values [ DIO bits ]
+	  flags   : CONEXIO_CMM920_TLM_FLAG_KEY, CONEXIO_CMM920_TLM_FLAG_DIO
+	  bitmap  : included channels ( delta frame only, ( ch_num + 7 ) / 8 bytes )
+	  values  : zigzag varint of ( value - reference ) , or value in key frame
+	  DIO     : ( dio_num + 7 ) / 8 bytes, LSB first
+***/
+
+#include <stdio.h>
+#include <string.h>
+#include "libconexio_CMM920.h"
+
+/**
+	@~English
+	@brief zigzag encode function
+	@param v : signed value
+	@return unsigned value
+	@~Japanese
+	@brief 符号付きの値をジグザグ符号化する関数
+	@param v : 符号付きの値
+	@return 符号なしの値
+**/
+static unsigned long _conexio_cmm920_tlm_zigzag( long v )
+{
+	return ( (unsigned long)v << 1 ) ^ (unsigned long)( v >> ( sizeof(long) * 8 - 1 ) );
+}
+
+/**
+	@~English
+	@brief zigzag decode function
+	@param u : unsigned value
+	@return signed value
+	@~Japanese
+	@brief ジグザグ符号を復号する関数
+	@param u : 符号なしの値
+	@return 符号付きの値
+**/
+static long _conexio_cmm920_tlm_unzigzag( unsigned long u )
+{
+	return (long)( u >> 1 ) ^ -(long)( u & 1 );
+}
+
+/**
+	@~English
+	@brief varint write function
+	@param buf : buffer
+	@param u : value
+	@return written size
+	@~Japanese
+	@brief 可変長整数を書き込む関数
+	@param buf : バッファ
+	@param u : 値
+	@return 書き込んだサイズ
+**/
+static int _conexio_cmm920_tlm_put_varint( BYTE buf[], unsigned long u )
+{
+	int n = 0;
+
+	while( u >= 0x80 ){
+		buf[n++] = (BYTE)( u | 0x80 );
+		u >>= 7;
+	}
+	buf[n++] = (BYTE)u;
+
+	return n;
+}
+
+/**
+	@~English
+	@brief varint read function
+	@param buf : buffer
+	@param size : buffer size
+	@param u : value
+	@return Success : read size , Failed : -1
+	@~Japanese
+	@brief 可変長整数を読み出す関数
+	@param buf : バッファ
+	@param size : バッファのサイズ
+	@param u : 値
+	@return 成功:  読み出したサイズ 失敗 :  -1
+**/
+static int _conexio_cmm920_tlm_get_varint( BYTE buf[], int size, unsigned long *u )
+{
+	int n = 0;
+	int shift = 0;
+
+	*u = 0;
+	while( n < size && shift < (int)( sizeof(long) * 8 ) ){
+		*u |= (unsigned long)( buf[n] & 0x7F ) << shift;
+		if( !( buf[n++] & 0x80 ) ) return n;
+		shift += 7;
+	}
+
+	return -1;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Telemetry Encoder Initialize
+	@param tlm : telemetry encoder
+	@param ch_num : number of value channels ( 0 to CONEXIO_CMM920_TLM_CH_MAX )
+	@param dio_num : number of DIO bits ( 0 to CONEXIO_CMM920_TLM_DIO_MAX )
+	@return Success : 0 , Failed : -1
+	@~Japanese
+	@brief テレメトリ符号化の初期化関数
+	@param tlm : テレメトリ符号化構造体
+	@param ch_num : 値のチャネル数 ( 0 ～ CONEXIO_CMM920_TLM_CH_MAX )
+	@param dio_num : DIO のビット数 ( 0 ～ CONEXIO_CMM920_TLM_DIO_MAX )
+	@return 成功:  0 失敗 :  -1
+**/
+int conexio_cmm920_tlm_init( PCONEXIO920TLM tlm, int ch_num, int dio_num )
+{
+	if( tlm == NULL ||
+		ch_num < 0 || ch_num > CONEXIO_CMM920_TLM_CH_MAX ||
+		dio_num < 0 || dio_num > CONEXIO_CMM920_TLM_DIO_MAX ) return -1;
+
+	memset( tlm, 0, sizeof(CONEXIO920TLM) );
+	tlm->ch_num = ch_num;
+	tlm->dio_num = dio_num;
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Telemetry Set Deadband
+	@param tlm : telemetry encoder
+	@param ch : channel
+	@param deadband : deadband ( 0 : send every change )
+	@return Success : 0 , Failed : -1
+	@~Japanese
+	@brief テレメトリのデッドバンドを設定する関数
+	@param tlm : テレメトリ符号化構造体
+	@param ch : チャネル
+	@param deadband : デッドバンド ( 0 : 変化があれば送信 )
+	@return 成功:  0 失敗 :  -1
+	@par 確認応答済みの値からの変化が deadband 以下のチャネルは送信しません。変化は確認応答済みの値と比較するため、ゆっくりした変化も deadband を超えた時点で送信します。
+**/
+int conexio_cmm920_tlm_set_deadband( PCONEXIO920TLM tlm, int ch, long deadband )
+{
+	if( tlm == NULL || ch < 0 || ch >= tlm->ch_num || deadband < 0 ) return -1;
+
+	tlm->deadband[ch] = deadband;
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Telemetry Reset Reference
+	@param tlm : telemetry encoder
+	@~Japanese
+	@brief テレメトリの基準値を破棄する関数
+	@param tlm : テレメトリ符号化構造体
+	@par 次の符号化はキーフレーム ( 絶対値 ) になります。復号側が基準フレームを持っていない場合 ( conexio_cmm920_tlm_decode が -2 を返した場合 ) に実行してください。
+**/
+void conexio_cmm920_tlm_reset( PCONEXIO920TLM tlm )
+{
+	if( tlm == NULL ) return;
+
+	tlm->ref_valid = 0;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Telemetry Encode
+	@param tlm : telemetry encoder
+	@param value : channel values ( ch_num elements )
+	@param dio : DIO states ( dio_num elements, 0 : off, otherwise : on ) (option)
+	@param buf : encoded frame buffer
+	@param size : encoded frame buffer size ( CONEXIO_CMM920_TLM_SIZE_MAX or more is always enough )
+	@return Success : encoded size , Failed : -1
+	@~Japanese
+	@brief テレメトリを符号化する関数
+	@param tlm : テレメトリ符号化構造体
+	@param value : チャネルの値 ( ch_num 個 )
+	@param dio : DIO の状態 ( dio_num 個, 0 : OFF, 0以外 : ON ) (オプション)
+	@param buf : 符号化フレームのバッファ
+	@param size : 符号化フレームのバッファのサイズ ( CONEXIO_CMM920_TLM_SIZE_MAX 以上なら不足しません )
+	@return 成功:  符号化したサイズ 失敗 :  -1
+	@par 確認応答済みのフレームとの差分を符号化します。確認応答済みのフレームがなければキーフレームになります。
+	@par 受信側から確認応答を受けたら conexio_cmm920_tlm_ack にフレームのシーケンス番号 ( buf[1] ) を渡してください。
+**/
+int conexio_cmm920_tlm_encode( PCONEXIO920TLM tlm, long value[], BYTE dio[], BYTE buf[], int size )
+{
+	int key, map_size, dio_size;
+	int pos, ch, i, slot;
+	long *pend;
+	BYTE *pend_dio;
+	long d;
+
+	if( tlm == NULL || buf == NULL || ( value == NULL && tlm->ch_num > 0 ) ) return -1;
+
+	key = !tlm->ref_valid;
+	map_size = key ? 0 : ( tlm->ch_num + 7 ) / 8;
+	dio_size = ( tlm->dio_num + 7 ) / 8;
+
+	// 最大サイズで確認 ( 可変長整数は最大 10 バイト )
+	if( size < 3 + map_size + tlm->ch_num * 10 + dio_size ) return -1;
+
+	// 確認応答を待つ間の復号側の値をシーケンス番号ごとに保持
+	slot = (BYTE)( tlm->seq + 1 ) & ( CONEXIO_CMM920_TLM_HISTORY - 1 );
+	pend = tlm->pend[slot];
+	pend_dio = tlm->pend_dio[slot];
+
+	pos = 3 + map_size;
+	memset( &buf[3], 0, map_size );
+
+	for( ch = 0; ch < tlm->ch_num; ch++ ){
+		if( key ){
+			pos += _conexio_cmm920_tlm_put_varint( &buf[pos], _conexio_cmm920_tlm_zigzag( value[ch] ) );
+			pend[ch] = value[ch];
+			continue;
+		}
+
+		d = value[ch] - tlm->ref[ch];
+		if( ( d < 0 ? -d : d ) > tlm->deadband[ch] ){
+			buf[3 + ( ch >> 3 )] |= ( 1 << ( ch & 7 ) );
+			pos += _conexio_cmm920_tlm_put_varint( &buf[pos], _conexio_cmm920_tlm_zigzag( d ) );
+			pend[ch] = value[ch];
+		}else{
+			pend[ch] = tlm->ref[ch];
+		}
+	}
+
+	buf[0] = key ? CONEXIO_CMM920_TLM_FLAG_KEY : 0;
+
+	if( dio_size > 0 ){
+		memset( pend_dio, 0, sizeof(tlm->pend_dio[0]) );
+		for( i = 0; dio != NULL && i < tlm->dio_num; i++ ){
+			if( dio[i] ) pend_dio[i >> 3] |= ( 1 << ( i & 7 ) );
+		}
+		if( key || memcmp( pend_dio, tlm->ref_dio, dio_size ) != 0 ){
+			buf[0] |= CONEXIO_CMM920_TLM_FLAG_DIO;
+			memcpy( &buf[pos], pend_dio, dio_size );
+			pos += dio_size;
+		}
+	}
+
+	tlm->seq++;
+	tlm->pend_seq[slot] = tlm->seq;
+	tlm->pend_valid[slot] = 1;
+	buf[1] = tlm->seq;
+	buf[2] = tlm->ref_seq;
+
+	return pos;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Telemetry Acknowledge
+	@param tlm : telemetry encoder
+	@param seq : acknowledged sequence number
+	@return Success : 0 , Failed : -1 ( not one of the last CONEXIO_CMM920_TLM_HISTORY encoded frames, or older than the reference )
+	@~Japanese
+	@brief テレメトリの確認応答を通知する関数
+	@param tlm : テレメトリ符号化構造体
+	@param seq : 確認応答のシーケンス番号
+	@return 成功:  0 失敗 :  -1 ( 直近 CONEXIO_CMM920_TLM_HISTORY 個に符号化したフレームではない、または基準より古い )
+	@par 確認応答を受けたフレームを次回以降の差分の基準にします。直近 CONEXIO_CMM920_TLM_HISTORY 個に符号化したフレームであれば、確認応答が遅れて届いても基準にできます。
+**/
+int conexio_cmm920_tlm_ack( PCONEXIO920TLM tlm, BYTE seq )
+{
+	int slot;
+
+	if( tlm == NULL ) return -1;
+
+	slot = seq & ( CONEXIO_CMM920_TLM_HISTORY - 1 );
+	if( !tlm->pend_valid[slot] || tlm->pend_seq[slot] != seq ||
+		(BYTE)( tlm->seq - seq ) >= CONEXIO_CMM920_TLM_HISTORY ) return -1;
+
+	// 基準より古いフレームの確認応答では基準を戻さない
+	if( tlm->ref_valid && (signed char)( seq - tlm->ref_seq ) <= 0 ) return -1;
+
+	memcpy( tlm->ref, tlm->pend[slot], sizeof(tlm->ref) );
+	memcpy( tlm->ref_dio, tlm->pend_dio[slot], sizeof(tlm->ref_dio) );
+	tlm->ref_seq = seq;
+	tlm->ref_valid = 1;
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Telemetry Decoder Initialize
+	@param dec : telemetry decoder
+	@param ch_num : number of value channels ( 0 to CONEXIO_CMM920_TLM_CH_MAX )
+	@param dio_num : number of DIO bits ( 0 to CONEXIO_CMM920_TLM_DIO_MAX )
+	@return Success : 0 , Failed : -1
+	@~Japanese
+	@brief テレメトリ復号の初期化関数
+	@param dec : テレメトリ復号構造体
+	@param ch_num : 値のチャネル数 ( 0 ～ CONEXIO_CMM920_TLM_CH_MAX )
+	@param dio_num : DIO のビット数 ( 0 ～ CONEXIO_CMM920_TLM_DIO_MAX )
+	@return 成功:  0 失敗 :  -1
+**/
+int conexio_cmm920_tlm_decoder_init( PCONEXIO920TLMDEC dec, int ch_num, int dio_num )
+{
+	if( dec == NULL ||
+		ch_num < 0 || ch_num > CONEXIO_CMM920_TLM_CH_MAX ||
+		dio_num < 0 || dio_num > CONEXIO_CMM920_TLM_DIO_MAX ) return -1;
+
+	memset( dec, 0, sizeof(CONEXIO920TLMDEC) );
+	dec->ch_num = ch_num;
+	dec->dio_num = dio_num;
+
+	return 0;
+}
+
+/**
+	@~English
+	@brief CONEXIO 920MHz Telemetry Decode
+	@param dec : telemetry decoder
+	@param buf : encoded frame
+	@param size : encoded frame size
+	@param value : channel values ( ch_num elements )
+	@param dio : DIO states ( dio_num elements ) (option)
+	@param seq : sequence number of the frame ( to acknowledge ) (option)
+	@return Success : 0 , Failed : -1 : Format Error, -2 : Unknown reference frame
+	@~Japanese
+	@brief テレメトリを復号する関数
+	@param dec : テレメトリ復号構造体
+	@param buf : 符号化フレーム
+	@param size : 符号化フレームのサイズ
+	@param value : チャネルの値 ( ch_num 個 )
+	@param dio : DIO の状態 ( dio_num 個 ) (オプション)
+	@param seq : フレームのシーケンス番号 ( 確認応答用 ) (オプション)
+	@return 成功:  0 失敗 :  フォーマットエラー : -1, 基準フレームなし : -2
+	@par 直近 CONEXIO_CMM920_TLM_HISTORY 個の復号結果を差分の基準として保持します。 -2 の場合は送信側で conexio_cmm920_tlm_reset を実行してキーフレームを送信してください。
+**/
+int conexio_cmm920_tlm_decode( PCONEXIO920TLMDEC dec, BYTE buf[], int size, long value[], BYTE dio[], BYTE *seq )
+{
+	long out[CONEXIO_CMM920_TLM_CH_MAX];
+	BYTE out_dio[CONEXIO_CMM920_TLM_DIO_MAX / 8];
+	unsigned long u;
+	int key, map_size, dio_size;
+	int pos, ch, i, n, slot, ref = -1;
+
+	if( dec == NULL || buf == NULL || size < 3 ) return -1;
+
+	key = ( buf[0] & CONEXIO_CMM920_TLM_FLAG_KEY ) != 0;
+	map_size = key ? 0 : ( dec->ch_num + 7 ) / 8;
+	dio_size = ( dec->dio_num + 7 ) / 8;
+
+	if( !key ){
+		for( i = 0; i < CONEXIO_CMM920_TLM_HISTORY; i++ ){
+			if( dec->valid[i] && dec->seq[i] == buf[2] ) ref = i;
+		}
+		if( ref < 0 ) return -2;
+		memcpy( out, dec->value[ref], sizeof(out) );
+		memcpy( out_dio, dec->dio[ref], sizeof(out_dio) );
+	}else{
+		memset( out, 0, sizeof(out) );
+		memset( out_dio, 0, sizeof(out_dio) );
+	}
+
+	pos = 3 + map_size;
+	if( pos > size ) return -1;
+
+	for( ch = 0; ch < dec->ch_num; ch++ ){
+		if( !key && !( buf[3 + ( ch >> 3 )] & ( 1 << ( ch & 7 ) ) ) ) continue;
+
+		n = _conexio_cmm920_tlm_get_varint( &buf[pos], size - pos, &u );
+		if( n < 0 ) return -1;
+		pos += n;
+
+		if( key ) out[ch] = _conexio_cmm920_tlm_unzigzag( u );
+		else out[ch] += _conexio_cmm920_tlm_unzigzag( u );
+	}
+
+	if( buf[0] & CONEXIO_CMM920_TLM_FLAG_DIO ){
+		if( pos + dio_size > size ) return -1;
+		memcpy( out_dio, &buf[pos], dio_size );
+	}
+
+	// 復号結果を履歴に保存
+	slot = buf[1] & ( CONEXIO_CMM920_TLM_HISTORY - 1 );
+	dec->valid[slot] = 1;
+	dec->seq[slot] = buf[1];
+	memcpy( dec->value[slot], out, sizeof(out) );
+	memcpy( dec->dio[slot], out_dio, sizeof(out_dio) );
+
+	if( value != NULL ) memcpy( value, out, sizeof(long) * dec->ch_num );
+	for( i = 0; dio != NULL && i < dec->dio_num; i++ ){
+		dio[i] = ( out_dio[i >> 3] >> ( i & 7 ) ) & 1;
+	}
+	if( seq != NULL ) *seq = buf[1];
+
+	return 0;
+}
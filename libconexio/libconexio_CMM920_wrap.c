@@ -29,38 +29,53 @@
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Set Mode function
+	@param ctx : instance handle
 	@param code : mode
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の モード設定関数
+	@param ctx : インスタンスハンドル
 	@param code : mode
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_set_mode(int code)
+int conexio_cmm920_set_mode_h(CONEXIO920HANDLE ctx, int code)
 {
-	return conexio_cmm920_mode(
+	return conexio_cmm920_mode_h( ctx,
 			CONEXIO_CMM920_SET_READING_WRITE,
 			&code
 	);
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_set_mode_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_mode_h を実行する関数
+**/
+int conexio_cmm920_set_mode(int code)
+{
+	return conexio_cmm920_set_mode_h( conexio_cmm920_default_handle(), code );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Set Address function
+	@param ctx : instance handle
 	@param panId : PAN ID
 	@param Addr : Long Address
 	@param shortAddr : Short address
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の アドレス設定関数
+	@param ctx : インスタンスハンドル
 	@param panId : PAN ID
 	@param Addr : ロングアドレス
 	@param shortAddr : ショートアドレス
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_set_address(unsigned short panId, BYTE Addr[], unsigned short shortAddr )
+int conexio_cmm920_set_address_h(CONEXIO920HANDLE ctx, unsigned short panId, BYTE Addr[], unsigned short shortAddr )
 {
-	return conexio_cmm920_address(
+	return conexio_cmm920_address_h( ctx,
 			CONEXIO_CMM920_SET_READING_WRITE,
 			&panId,
 			Addr,
@@ -68,9 +83,21 @@ int conexio_cmm920_set_address(unsigned short panId, BYTE Addr[], unsigned short
 	);
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_set_address_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_address_h を実行する関数
+**/
+int conexio_cmm920_set_address(unsigned short panId, BYTE Addr[], unsigned short shortAddr )
+{
+	return conexio_cmm920_set_address_h( conexio_cmm920_default_handle(), panId, Addr, shortAddr );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Set Wireless function
+	@param ctx : instance handle
 	@param iBitrate : bit rate
 	@param channel : channel
 	@param power : send power
@@ -83,6 +110,7 @@ int conexio_cmm920_set_address(unsigned short panId, BYTE Addr[], unsigned short
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の 無線設定関数
+	@param ctx : インスタンスハンドル
 	@param iBitrate : ビットレート
 	@param channel : チャネル
 	@param power : 送信出力
@@ -94,7 +122,7 @@ int conexio_cmm920_set_address(unsigned short panId, BYTE Addr[], unsigned short
 	@param ackWaitTim : ACK待ち時間
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_set_wireless(int iBitrate, BYTE channel, BYTE power, char sendLv, char recvLv, unsigned short sendTim, BYTE sendNum, BYTE ackRetryNum, unsigned short ackWaitTim){
+int conexio_cmm920_set_wireless_h(CONEXIO920HANDLE ctx, int iBitrate, BYTE channel, BYTE power, char sendLv, char recvLv, unsigned short sendTim, BYTE sendNum, BYTE ackRetryNum, unsigned short ackWaitTim){
 	BYTE bBitrate;
 	BYTE bcdChannel;
 	BYTE bcdSendLv;
@@ -115,7 +143,7 @@ int conexio_cmm920_set_wireless(int iBitrate, BYTE channel, BYTE power, char sen
 	bcdSendLv = _conexio_cmm920_dBm2Hex((int)sendLv);
 	bcdRecvLv = _conexio_cmm920_dBm2Hex((int)recvLv);
 
-	return conexio_cmm920_wireless(
+	return conexio_cmm920_wireless_h( ctx,
 		CONEXIO_CMM920_SET_READING_WRITE,
 		&bBitrate,
 		&bcdChannel,
@@ -131,97 +159,162 @@ int conexio_cmm920_set_wireless(int iBitrate, BYTE channel, BYTE power, char sen
 
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_set_wireless_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_wireless_h を実行する関数
+**/
+int conexio_cmm920_set_wireless(int iBitrate, BYTE channel, BYTE power, char sendLv, char recvLv, unsigned short sendTim, BYTE sendNum, BYTE ackRetryNum, unsigned short ackWaitTim)
+{
+	return conexio_cmm920_set_wireless_h( conexio_cmm920_default_handle(), iBitrate, channel, power, sendLv, recvLv, sendTim, sendNum, ackRetryNum, ackWaitTim );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module set timer function
+	@param ctx : instance handle
 	@param tim : time ( msec )
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の 時間設定関数
+	@param ctx : インスタンスハンドル
 	@param tim : 時間 (msec)
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_set_timer( unsigned short tim ){
+int conexio_cmm920_set_timer_h( CONEXIO920HANDLE ctx, unsigned short tim ){
 
-	return conexio_cmm920_timer(
+	return conexio_cmm920_timer_h( ctx,
 		CONEXIO_CMM920_SET_READING_WRITE,
 		&tim
 		);
 
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_set_timer_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_timer_h を実行する関数
+**/
+int conexio_cmm920_set_timer( unsigned short tim )
+{
+	return conexio_cmm920_set_timer_h( conexio_cmm920_default_handle(), tim );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Set Auto Acknowledge Frame function
+	@param ctx : instance handle
 	@param phr :
 	@param fc_upper :
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の オートACKフレーム 設定 関数
+	@param ctx : インスタンスハンドル
 	@param phr :
 	@param fc_upper :
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_set_auto_ack_frame( unsigned short phr, unsigned char fc_upper ){
-	return conexio_cmm920_auto_ack_frame(
+int conexio_cmm920_set_auto_ack_frame_h( CONEXIO920HANDLE ctx, unsigned short phr, unsigned char fc_upper ){
+	return conexio_cmm920_auto_ack_frame_h( ctx,
 		CONEXIO_CMM920_SET_READING_WRITE,
 		&phr,
 		&fc_upper
 	);
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_set_auto_ack_frame_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_auto_ack_frame_h を実行する関数
+**/
+int conexio_cmm920_set_auto_ack_frame( unsigned short phr, unsigned char fc_upper )
+{
+	return conexio_cmm920_set_auto_ack_frame_h( conexio_cmm920_default_handle(), phr, fc_upper );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Set Antenna mode function
+	@param ctx : instance handle
 	@param antennaMode :
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の アンテナモード 設定関数
+	@param ctx : インスタンスハンドル
 	@param antennaMode :
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_set_antenna( BYTE antennaMode ){
-	return conexio_cmm920_antenna(
+int conexio_cmm920_set_antenna_h( CONEXIO920HANDLE ctx, BYTE antennaMode ){
+	return conexio_cmm920_antenna_h( ctx,
 		CONEXIO_CMM920_SET_READING_WRITE,
 		&antennaMode
 	);
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_set_antenna_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_antenna_h を実行する関数
+**/
+int conexio_cmm920_set_antenna( BYTE antennaMode )
+{
+	return conexio_cmm920_set_antenna_h( conexio_cmm920_default_handle(), antennaMode );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Get Mode function
+	@param ctx : instance handle
 	@param code : mode
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の モード取得関数
+	@param ctx : インスタンスハンドル
 	@param code : mode
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_get_mode(int *code)
+int conexio_cmm920_get_mode_h(CONEXIO920HANDLE ctx, int *code)
 {
-	return conexio_cmm920_mode(
+	return conexio_cmm920_mode_h( ctx,
 			CONEXIO_CMM920_SET_READING_READ,
 			code
 	);
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_get_mode_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_mode_h を実行する関数
+**/
+int conexio_cmm920_get_mode(int *code)
+{
+	return conexio_cmm920_get_mode_h( conexio_cmm920_default_handle(), code );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Get Address function
+	@param ctx : instance handle
 	@param panId : PAN ID
 	@param Addr : Long Address
 	@param shortAddr : Short address
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の アドレス取得関数
+	@param ctx : インスタンスハンドル
 	@param panId : PAN ID
 	@param Addr : ロングアドレス
 	@param shortAddr : ショートアドレス
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_get_address(unsigned short *panId, BYTE Addr[], unsigned short *shortAddr )
+int conexio_cmm920_get_address_h(CONEXIO920HANDLE ctx, unsigned short *panId, BYTE Addr[], unsigned short *shortAddr )
 {
-	return conexio_cmm920_address(
+	return conexio_cmm920_address_h( ctx,
 			CONEXIO_CMM920_SET_READING_READ,
 			panId,
 			Addr,
@@ -229,9 +322,21 @@ int conexio_cmm920_get_address(unsigned short *panId, BYTE Addr[], unsigned shor
 	);
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_get_address_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_address_h を実行する関数
+**/
+int conexio_cmm920_get_address(unsigned short *panId, BYTE Addr[], unsigned short *shortAddr )
+{
+	return conexio_cmm920_get_address_h( conexio_cmm920_default_handle(), panId, Addr, shortAddr );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Get Wireless function
+	@param ctx : instance handle
 	@param iBitrate : bit rate
 	@param channel : channel
 	@param power : send power
@@ -244,6 +349,7 @@ int conexio_cmm920_get_address(unsigned short *panId, BYTE Addr[], unsigned shor
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の 無線取得関数
+	@param ctx : インスタンスハンドル
 	@param iBitrate : ビットレート
 	@param channel : チャネル
 	@param power : 送信出力
@@ -255,14 +361,14 @@ int conexio_cmm920_get_address(unsigned short *panId, BYTE Addr[], unsigned shor
 	@param ackWaitTim : ACK待ち時間
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_get_wireless(int *iBitrate, BYTE *channel, BYTE *power, char *sendLv, char *recvLv, unsigned short *sendTim, BYTE *sendNum, BYTE *ackRetryNum, unsigned short *ackWaitTim){
+int conexio_cmm920_get_wireless_h(CONEXIO920HANDLE ctx, int *iBitrate, BYTE *channel, BYTE *power, char *sendLv, char *recvLv, unsigned short *sendTim, BYTE *sendNum, BYTE *ackRetryNum, unsigned short *ackWaitTim){
 	BYTE bBitrate;
 	BYTE bcdChannel;
 	BYTE bcdSendLv;
 	BYTE bcdRecvLv;
 	int iRet;
 
-	iRet = conexio_cmm920_wireless(
+	iRet = conexio_cmm920_wireless_h( ctx,
 		CONEXIO_CMM920_SET_READING_READ,
 		&bBitrate,
 		&bcdChannel,
@@ -292,132 +398,156 @@ int conexio_cmm920_get_wireless(int *iBitrate, BYTE *channel, BYTE *power, char
 
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_get_wireless_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_wireless_h を実行する関数
+**/
+int conexio_cmm920_get_wireless(int *iBitrate, BYTE *channel, BYTE *power, char *sendLv, char *recvLv, unsigned short *sendTim, BYTE *sendNum, BYTE *ackRetryNum, unsigned short *ackWaitTim)
+{
+	return conexio_cmm920_get_wireless_h( conexio_cmm920_default_handle(), iBitrate, channel, power, sendLv, recvLv, sendTim, sendNum, ackRetryNum, ackWaitTim );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module get timer function
+	@param ctx : instance handle
 	@param tim : time ( msec )
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の 時間取得関数
+	@param ctx : インスタンスハンドル
 	@param tim : 時間 (msec)
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_get_timer( unsigned short *tim ){
+int conexio_cmm920_get_timer_h( CONEXIO920HANDLE ctx, unsigned short *tim ){
 
-	return conexio_cmm920_timer(
+	return conexio_cmm920_timer_h( ctx,
 		CONEXIO_CMM920_SET_READING_READ,
 		tim
 		);
 
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_get_timer_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_timer_h を実行する関数
+**/
+int conexio_cmm920_get_timer( unsigned short *tim )
+{
+	return conexio_cmm920_get_timer_h( conexio_cmm920_default_handle(), tim );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Get Auto Acknowledge Frame function
+	@param ctx : instance handle
 	@param phr :
 	@param fc_upper :
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の オートACKフレーム 取得 関数
+	@param ctx : インスタンスハンドル
 	@param phr :
 	@param fc_upper :
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_get_auto_ack_frame( unsigned short *phr, unsigned char *fc_upper ){
-	return conexio_cmm920_auto_ack_frame(
+int conexio_cmm920_get_auto_ack_frame_h( CONEXIO920HANDLE ctx, unsigned short *phr, unsigned char *fc_upper ){
+	return conexio_cmm920_auto_ack_frame_h( ctx,
 		CONEXIO_CMM920_SET_READING_READ,
 		phr,
 		fc_upper
 	);
 }
+
+/**
+	@~English
+	@brief conexio_cmm920_get_auto_ack_frame_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_auto_ack_frame_h を実行する関数
+**/
+int conexio_cmm920_get_auto_ack_frame( unsigned short *phr, unsigned char *fc_upper )
+{
+	return conexio_cmm920_get_auto_ack_frame_h( conexio_cmm920_default_handle(), phr, fc_upper );
+}
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Get Antenna mode function
+	@param ctx : instance handle
 	@param antennaMode :
 	@return Success : 0 , Failed : From -1 to -15 : Parameter Error, From -16 to -31 Send Error, less than -32 : Receive Error
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の アンテナモード 取得関数
+	@param ctx : インスタンスハンドル
 	@param antennaMode :
 	@return 成功:  0 失敗 :  送信 エラー:  -1～-15 -16～-31,　受信エラー : -32～
 **/
-int conexio_cmm920_get_antenna( BYTE *antennaMode ){
-	return conexio_cmm920_antenna(
+int conexio_cmm920_get_antenna_h( CONEXIO920HANDLE ctx, BYTE *antennaMode ){
+	return conexio_cmm920_antenna_h( ctx,
 		CONEXIO_CMM920_SET_READING_READ,
 		antennaMode
 	);
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_get_antenna_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_get_antenna_h を実行する関数
+**/
+int conexio_cmm920_get_antenna( BYTE *antennaMode )
+{
+	return conexio_cmm920_get_antenna_h( conexio_cmm920_default_handle(), antennaMode );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Set Hop mode function
+	@param ctx : instance handle
 	@param hop :
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の ホップモード 設定関数
+	@param ctx : インスタンスハンドル
 	@param hop :
 **/
-void conexio_cmm920_set_hop_mode( BYTE hop )
+void conexio_cmm920_set_hop_mode_h( CONEXIO920HANDLE ctx, BYTE hop )
 {
 
 	if( hop == CONEXIO_CMM920_HOP_MULTI ){
-
-		conexio_cmm920_lsi_mhr_mode(
-			CONEXIO_CMM920_SET_READING_WRITE,
-			CONEXIO_CMM920_SET_ENABLE
-		);
-
-		conexio_cmm920_lsi_crc_calc_inverse(
-				CONEXIO_CMM920_SET_READING_WRITE,
-				CONEXIO_CMM920_SET_ENABLE
-		);
-		conexio_cmm920_lsi_s_panid_filter(
-				CONEXIO_CMM920_SET_READING_WRITE,
-				CONEXIO_CMM920_SET_ENABLE
-		);
-
-		conexio_cmm920_lsi_d_panid_filter(
-				CONEXIO_CMM920_SET_READING_WRITE,
-				CONEXIO_CMM920_SET_ENABLE
-		);
-
-		conexio_cmm920_lsi_d_address_filter(
-				CONEXIO_CMM920_SET_READING_WRITE,
-				CONEXIO_CMM920_SET_ENABLE
-		);
-
-		conexio_cmm920_lsi_data_preamble_bit_len(
-				CONEXIO_CMM920_SET_READING_WRITE,
-				CONEXIO_CMM920_PRELEN_MULTIHOP
-		);
-
-		conexio_cmm920_lsi_data_sfd(
-				CONEXIO_CMM920_SET_READING_WRITE,
-				CONEXIO_CMM920_SFD_MULTIHOP	,
-				CONEXIO_CMM920_SFDNUM_0
-		);
-
-		conexio_cmm920_lsi_data_whitening(
-				CONEXIO_CMM920_SET_READING_WRITE,
-				//CONEXIO_CMM920_SET_ENABLE
-				CONEXIO_CMM920_SET_DISABLE	// 2016.01.15 (1) 
-		);
-
+		conexio_cmm920_lsi_profile_h( ctx, CONEXIO_CMM920_HOP_MULTI, NULL );
 	}else{
-		conexio_cmm920_reset();
+		conexio_cmm920_reset_h(ctx);
 	}
 
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_set_hop_mode_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_hop_mode_h を実行する関数
+**/
+void conexio_cmm920_set_hop_mode( BYTE hop )
+{
+	conexio_cmm920_set_hop_mode_h( conexio_cmm920_default_handle(), hop );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Set Wireless default setting function
+	@param ctx : instance handle
 	@par Default Parameter : 100kBps, 60channel, 1mW , Send Level -85dBm, Receive Level -95dBm, Send Time 130(usec), Send Num 6, Ack Retry Num 4, Ack Time 100(usec)
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の 無線  通常設定関数
+	@param ctx : インスタンスハンドル
 	@par パラメータ : 100kBps, 60チャネル, 1mW , 送信レベル -85dBm, 受信レベル -95dBm, 送信時間 130(usec), 送信回数 6回, ACKリトライ回数 4回, ACKリトライ時間 100 (usec)
 **/
-int conexio_cmm920_set_wireless_default(void)
+int conexio_cmm920_set_wireless_default_h(CONEXIO920HANDLE ctx)
 {
-	return conexio_cmm920_set_wireless(
+	return conexio_cmm920_set_wireless_h( ctx,
 			100000,	//100kbps
 			60,		//60ch
 			CONEXIO_CMM920_SET_WIRELESS_POWER_01MW,
@@ -430,33 +560,70 @@ int conexio_cmm920_set_wireless_default(void)
 	);
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_set_wireless_default_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_wireless_default_h を実行する関数
+**/
+int conexio_cmm920_set_wireless_default(void)
+{
+	return conexio_cmm920_set_wireless_default_h( conexio_cmm920_default_handle() );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Set Auto Acknowledge Frame default setting function
+	@param ctx : instance handle
 	@par Default Parameter :
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の 自動ACKフレーム 通常設定関数
+	@param ctx : インスタンスハンドル
 	@par パラメータ :
 **/
-int conexio_cmm920_set_auto_ack_frame_default(void)
+int conexio_cmm920_set_auto_ack_frame_default_h(CONEXIO920HANDLE ctx)
 {
-	return conexio_cmm920_set_auto_ack_frame(
+	return conexio_cmm920_set_auto_ack_frame_h( ctx,
 		0x07,
 		0x00
 	);
 
 }
 
+/**
+	@~English
+	@brief conexio_cmm920_set_auto_ack_frame_default_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_auto_ack_frame_default_h を実行する関数
+**/
+int conexio_cmm920_set_auto_ack_frame_default(void)
+{
+	return conexio_cmm920_set_auto_ack_frame_default_h( conexio_cmm920_default_handle() );
+}
+
 /**
 	@~English
 	@brief CONEXIO 920MHz Module Set Timer default setting function
+	@param ctx : instance handle
 	@par Default Parameter : 10 sec
 	@~Japanese
 	@brief CONEXIO 920MHz　Module の タイムアウト 通常設定関数
+	@param ctx : インスタンスハンドル
 	@par パラメータ :  10秒
 **/
-int conexio_cmm920_set_timer_default(void)
+int conexio_cmm920_set_timer_default_h(CONEXIO920HANDLE ctx)
 {
-	return conexio_cmm920_set_timer(10000);
+	return conexio_cmm920_set_timer_h(ctx, 10000);
+
+}
 
+/**
+	@~English
+	@brief conexio_cmm920_set_timer_default_h with the default instance
+	@~Japanese
+	@brief 既定のインスタンスで conexio_cmm920_set_timer_default_h を実行する関数
+**/
+int conexio_cmm920_set_timer_default(void)
+{
+	return conexio_cmm920_set_timer_default_h( conexio_cmm920_default_handle() );
 }